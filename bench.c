@@ -0,0 +1,2245 @@
+/*bench.c*/
+
+//
+// Benchmarks for the word ladder graph.
+//
+// Usage: bench.out [-dict file] [section ...]
+//
+// where the sections are "neighbors", "lookup", "index", "pattern",
+// "suggest", "relabel", "compress", "hyper", "implicit", "weighted",
+// "kpaths", "dag", "waypoints", "filter", "closest", "tree", "cache",
+// "budget", "parallel" and "edits"; with none given, all are run.
+//
+
+#define _CRT_SECURE_NO_WARNINGS
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+#include "avl.h"
+#include "wordkey.h"
+#include "graph.h"
+#include "hamming.h"
+#include "ladder.h"
+#include "compress.h"
+#include "bloom.h"
+#include "hyper.h"
+#include "implicit.h"
+#include "msbfs.h"
+#include "pattern.h"
+#include "pbfs.h"
+#include "relabel.h"
+#include "cost.h"
+#include "search.h"
+#include "sstree.h"
+#include "cache.h"
+#include "kpaths.h"
+#include "spdag.h"
+#include "waypoint.h"
+#include "closest.h"
+#include "suggest.h"
+#include "mymem.h"
+#include "timer.h"
+
+
+//
+// _probeShard:
+//
+// Finds the one-letter neighbors of every packable word in shard S
+// by probing the key table, the way AddEdges does, returning the
+// # of (directed) neighbor pairs found.
+//
+static long long _probeShard(Graph *G, Shard *S, int L)
+{
+  long long found = 0;
+  int       i, j;
+  char     *c;
+
+  for (i = 0; i < S->NumWords; ++i)
+  {
+    WordKey key = S->Keys[i];
+
+    if (key == WORDKEY_NONE)
+      continue;
+
+    for (j = 0; j < L; ++j)
+    {
+      for (c = S->Alphabet[j]; *c != '\0'; ++c)
+      {
+        if (*c < 'a' || *c > 'z')  // not a key, nor found by scans:
+          continue;
+
+        int v2 = Key2Vertex(G, KeySetLetter(key, j, *c));
+
+        if (v2 >= 0 && v2 != S->Words[i])
+          found++;
+      }
+    }
+  }
+
+  return found;
+}
+
+//
+// _scanShard:
+//
+// Same as _probeShard, but by scanning the shard with HammingScan.
+//
+static long long _scanShard(Shard *S, int *matches)
+{
+  long long found = 0;
+  int       i;
+
+  for (i = 0; i < S->NumWords; ++i)
+  {
+    if (S->Keys[i] == WORDKEY_NONE)
+      continue;
+
+    found += HammingScan(S->Keys, S->NumWords, S->Keys[i], matches);
+  }
+
+  return found;
+}
+
+//
+// BenchNeighborDiscovery:
+//
+// For each length bucket, times finding all one-letter neighbors
+// by probing (as AddEdges does) against scanning with each
+// available HammingScan kernel.  Times are in milliseconds.
+//
+void BenchNeighborDiscovery(Graph *G)
+{
+  char *kernels[] = { "scalar", "sse4.1", "avx2" };
+  int   numKernels = sizeof(kernels) / sizeof(kernels[0]);
+  char *best = HammingKernelName();
+  int   L, k;
+
+  printf(">>Neighbor discovery per length (ms), default kernel '%s':\n", best);
+  printf("  %4s %8s %10s %10s", "len", "words", "neighbors", "probe");
+  for (k = 0; k < numKernels; ++k)
+    printf(" %10s", kernels[k]);
+  printf("\n");
+
+  for (L = 1; L <= G->MaxLength && L <= WORDKEY_MAXLEN; ++L)
+  {
+    Shard *S = &G->Shards[L];
+
+    if (S->NumWords == 0)
+      continue;
+
+    int *matches = (int *)mymalloc(S->NumWords * sizeof(int));
+
+    timer_start();
+    long long found = _probeShard(G, S, L);
+    timer_stop();
+
+    printf("  %4d %8d %10lld %10.2f", L, S->NumWords, found, 1000.0 * timer_value());
+
+    for (k = 0; k < numKernels; ++k)
+    {
+      if (!SetHammingKernel(kernels[k]))
+      {
+        printf(" %10s", "n/a");
+        continue;
+      }
+
+      timer_start();
+      long long scanned = _scanShard(S, matches);
+      timer_stop();
+
+      if (scanned != found)
+        printf(" %9.2f!", 1000.0 * timer_value());  // mismatch:
+      else
+        printf(" %10.2f", 1000.0 * timer_value());
+    }
+
+    printf("\n");
+
+    myfree(matches);
+  }
+
+  SetHammingKernel(best);
+}
+
+//
+// _candidateKeys:
+//
+// Returns a dynamically-allocated array of the letter-change
+// candidates of every packable word, as AddEdges generates them,
+// with their # in *n.
+//
+static WordKey *_candidateKeys(Graph *G, int *n)
+{
+  WordKey *keys;
+  Vertex   v;
+  int      pass, i;
+  char    *c;
+
+  //
+  // count the candidates, then allocate and fill:
+  //
+  for (pass = 0; pass < 2; ++pass)
+  {
+    *n = 0;
+
+    for (v = 0; v < G->NumVertices; ++v)
+    {
+      WordKey key = G->Keys[v];
+
+      if (key == WORDKEY_NONE)
+        continue;
+
+      for (i = 0; i < KeyLength(key); ++i)
+      {
+        for (c = G->Shards[KeyLength(key)].Alphabet[i]; *c != '\0'; ++c)
+        {
+          if (*c >= 'a' && *c <= 'z')
+          {
+            if (pass == 1)
+              keys[*n] = KeySetLetter(key, i, *c);
+            (*n)++;
+          }
+        }
+      }
+    }
+
+    if (pass == 0)
+      keys = (WordKey *)mymalloc((*n + 1) * sizeof(WordKey));
+  }
+
+  return keys;
+}
+
+//
+// _timeLookups:
+//
+// Times looking up the keys one at a time and in batches, in
+// milliseconds, returning the # found.
+//
+static long long _timeLookups(Graph *G, WordKey *keys, int n,
+                              double *oneTime, double *batchTime)
+{
+  Vertex   *found = (Vertex *)mymalloc((n + 1) * sizeof(Vertex));
+  long long hits1 = 0, hits2 = 0;
+  int       i;
+
+  timer_start();
+  for (i = 0; i < n; ++i)
+    hits1 += (Key2Vertex(G, keys[i]) >= 0);
+  timer_stop();
+  *oneTime = 1000.0 * timer_value();
+
+  timer_start();
+  Keys2Vertices(G, keys, n, found);
+  for (i = 0; i < n; ++i)
+    hits2 += (found[i] >= 0);
+  timer_stop();
+  *batchTime = 1000.0 * timer_value();
+
+  myfree(found);
+
+  return (hits1 == hits2) ? hits1 : -1;
+}
+
+//
+// _timeNameLookups:
+//
+// Times looking up (Name2Vertex) the letter-change candidates of
+// every word that doesn't pack, as AddEdges probes them, in
+// milliseconds, returning the # found; their # via n.
+//
+static long long _timeNameLookups(Graph *G, double *time, long long *n)
+{
+  char      name[256];
+  long long found = 0;
+  Vertex    v;
+  int       i;
+  char      c;
+
+  *n = 0;
+
+  timer_start();
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    if (G->Keys[v] != WORDKEY_NONE || strlen(G->Names[v]) >= sizeof(name))
+      continue;
+
+    strcpy(name, G->Names[v]);
+
+    for (i = 0; name[i] != '\0'; ++i)
+    {
+      char letter = name[i];
+
+      for (c = 'a'; c <= 'z'; ++c)
+      {
+        if (c == letter)
+          continue;
+
+        name[i] = c;
+        found += (Name2Vertex(G, name) >= 0);
+        (*n)++;
+      }
+
+      name[i] = letter;
+    }
+  }
+  timer_stop();
+  *time = 1000.0 * timer_value();
+
+  return found;
+}
+
+//
+// BenchLookup:
+//
+// Times the candidate probes of AddEdges one at a time (Key2Vertex)
+// against batched and prefetched (Keys2Vertices), then the probes
+// of the words too long to pack (Name2Vertex), without and with a
+// Bloom filter.  Times are in milliseconds.
+//
+void BenchLookup(Graph *G)
+{
+  double    oneTime, batchTime, nameTime;
+  long long numNames;
+  int       n;
+
+  WordKey *keys = _candidateKeys(G, &n);
+
+  printf(">>Candidate lookups (ms), %d keys:\n", n);
+  printf("  %-12s %10s %10s %10s\n", "", "one", "batched", "found");
+
+  long long found = _timeLookups(G, keys, n, &oneTime, &batchTime);
+  printf("  %-12s %10.2f %10.2f %10lld\n", "key table", oneTime, batchTime, found);
+
+  found = _timeNameLookups(G, &nameTime, &numNames);
+
+  printf(">>Unpacked name lookups (ms), %lld names:\n", numNames);
+  printf("  %-12s %10s %10s\n", "filter", "time", "found");
+  printf("  %-12s %10.2f %10lld\n", "none", nameTime, found);
+
+  BuildFilter(G, 10);
+
+  found = _timeNameLookups(G, &nameTime, &numNames);
+  printf("  %-12s %10.2f %10lld\n", "10 bits", nameTime, found);
+
+  DeleteBloomFilter(G->Filter);
+  G->Filter = NULL;
+
+  myfree(keys);
+}
+
+//
+// BenchIndex:
+//
+// Times looking up every name, and a changed copy of every name
+// (mostly misses), in an AVL tree of the names against the shards'
+// Eytzinger indexes, then times prefix queries.  Times are in
+// milliseconds.
+//
+void BenchIndex(Graph *G)
+{
+  AVLNode       *tree = CreateAVLTree();
+  AVLElementType value;
+  long long      found1 = 0, found2 = 0;
+  double         buildTime, hitTime, missTime;
+  Vertex         v;
+
+  printf(">>Name index (ms):\n");
+  printf("  %-12s %10s %10s %10s %10s\n", "index", "build", "hits", "misses", "found");
+
+  //
+  // the AVL tree, of the names that fit its nodes:
+  //
+  timer_start();
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    if (strlen(G->Names[v]) < sizeof(value.Word))
+    {
+      strcpy(value.Word, G->Names[v]);
+      value.Vertex = v;
+      tree = Insert(tree, value);
+    }
+  }
+  timer_stop();
+  buildTime = 1000.0 * timer_value();
+
+  timer_start();
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    if (strlen(G->Names[v]) < sizeof(value.Word))
+    {
+      strcpy(value.Word, G->Names[v]);
+      found1 += (Contains(tree, value) != NULL);
+    }
+  }
+  timer_stop();
+  hitTime = 1000.0 * timer_value();
+
+  timer_start();
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    if (strlen(G->Names[v]) < sizeof(value.Word))
+    {
+      strcpy(value.Word, G->Names[v]);
+      value.Word[0] = (value.Word[0] == 'z') ? 'a' : value.Word[0] + 1;
+      found1 += (Contains(tree, value) != NULL);
+    }
+  }
+  timer_stop();
+  missTime = 1000.0 * timer_value();
+
+  printf("  %-12s %10.2f %10.2f %10.2f %10lld\n", "AVL", buildTime, hitTime, missTime, found1);
+
+  FreeAVLTree(tree);
+
+  //
+  // the Eytzinger indexes:
+  //
+  timer_start();
+  BuildShards(G);
+  timer_stop();
+  buildTime = 1000.0 * timer_value();
+
+  timer_start();
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    if (strlen(G->Names[v]) < sizeof(value.Word))
+      found2 += (Variant2Vertex(G, G->Names[v], -1, 0) >= 0);
+  }
+  timer_stop();
+  hitTime = 1000.0 * timer_value();
+
+  timer_start();
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    char *name = G->Names[v];
+
+    if (strlen(name) < sizeof(value.Word))
+      found2 += (Variant2Vertex(G, name, 0, (name[0] == 'z') ? 'a' : name[0] + 1) >= 0);
+  }
+  timer_stop();
+  missTime = 1000.0 * timer_value();
+
+  printf("  %-12s %10.2f %10.2f %10.2f %10lld\n", "Eytzinger", buildTime, hitTime, missTime, found2);
+  printf("  (build includes the rest of BuildShards)\n");
+
+  //
+  // prefix queries, one per 2-letter prefix:
+  //
+  char      prefix[3] = "aa";
+  long long words = 0;
+
+  timer_start();
+  for (prefix[0] = 'a'; prefix[0] <= 'z'; prefix[0]++)
+  {
+    for (prefix[1] = 'a'; prefix[1] <= 'z'; prefix[1]++)
+    {
+      Vertex *range = WordsWithPrefix(G, prefix);
+      int     i;
+
+      for (i = 0; range[i] != -1; ++i)
+        words++;
+
+      myfree(range);
+    }
+  }
+  timer_stop();
+
+  printf("  prefix queries: 676 in %.2f ms, %lld words\n", 1000.0 * timer_value(), words);
+}
+
+//
+// _countMatches:
+//
+// Returns the # of words matching each of the patterns, through
+// BeginPattern, or by scanning all the names if scan is true.
+//
+static long long _countMatches(Graph *G, char patterns[][64], int n, int scan)
+{
+  long long found = 0;
+  int       p, i;
+  Vertex    v;
+
+  for (p = 0; p < n; ++p)
+  {
+    if (scan)
+    {
+      int len = (int)strlen(patterns[p]);
+
+      for (v = 0; v < G->NumVertices; ++v)
+      {
+        char *name = G->Names[v];
+
+        if ((int)strlen(name) != len)
+          continue;
+
+        for (i = 0; i < len && (patterns[p][i] == '?' || patterns[p][i] == name[i]); ++i)
+          ;
+
+        found += (i == len);
+      }
+    }
+    else
+    {
+      PatternIter it;
+
+      BeginPattern(G, patterns[p], 0, &it);
+      while (NextMatch(&it) != -1)
+        found++;
+      EndPattern(&it);
+    }
+  }
+
+  return found;
+}
+
+//
+// BenchPattern:
+//
+// Times wildcard queries made from a sample of the words, with one
+// '?' (probes) and with two (bitmaps), against scanning all the
+// names.  Times are in milliseconds.
+//
+void BenchPattern(Graph *G)
+{
+  static char one[256][64], two[256][64];
+  int         n = 0;
+  int         step = G->NumVertices / 256 + 1;
+  Vertex      v;
+
+  for (v = 0; v < G->NumVertices && n < 256; v += step)
+  {
+    int len = (int)strlen(G->Names[v]);
+
+    if (len < 2 || len >= 64)
+      continue;
+
+    strcpy(one[n], G->Names[v]);
+    one[n][len / 2] = '?';
+    strcpy(two[n], one[n]);
+    two[n][0] = '?';
+    n++;
+  }
+
+  printf(">>Pattern queries (ms), %d of each:\n", n);
+  printf("  %-12s %10s %10s %10s\n", "wildcards", "index", "scan", "found");
+
+  timer_start();
+  BuildPatternIndex(G);
+  timer_stop();
+
+  double    buildTime = 1000.0 * timer_value();
+  double    indexTime, scanTime;
+  long long found1, found2;
+
+  timer_start();
+  found1 = _countMatches(G, one, n, 0);
+  timer_stop();
+  indexTime = 1000.0 * timer_value();
+
+  timer_start();
+  found2 = _countMatches(G, one, n, 1);
+  timer_stop();
+  scanTime = 1000.0 * timer_value();
+
+  printf("  %-12s %10.2f %10.2f %10lld%s\n", "one", indexTime, scanTime, found1,
+    (found1 == found2) ? "" : " **differs**");
+
+  timer_start();
+  found1 = _countMatches(G, two, n, 0);
+  timer_stop();
+  indexTime = 1000.0 * timer_value();
+
+  timer_start();
+  found2 = _countMatches(G, two, n, 1);
+  timer_stop();
+  scanTime = 1000.0 * timer_value();
+
+  printf("  %-12s %10.2f %10.2f %10lld%s\n", "two", indexTime, scanTime, found1,
+    (found1 == found2) ? "" : " **differs**");
+
+  printf("  (index: %lld bytes, built in %.2f ms)\n", G->Patterns->Bytes, buildTime);
+
+  DeletePatternIndex(G->Patterns);
+  G->Patterns = NULL;
+}
+
+//
+// _suggestAll:
+//
+// Asks for the 5 suggestions within 2 edits of each of the n words,
+// returning them one after another (each list ending with -1).
+//
+static Vertex *_suggestAll(Graph *G, char words[][64], int n)
+{
+  Vertex *all = (Vertex *)mymalloc(n * 6 * sizeof(Vertex));
+  int     i, j, m = 0;
+
+  for (i = 0; i < n; ++i)
+  {
+    Vertex *V = Suggest(G, words[i], 2, 5, NULL);
+
+    for (j = 0; V[j] != -1; ++j)
+      all[m++] = V[j];
+    all[m++] = -1;
+
+    myfree(V);
+  }
+
+  return all;
+}
+
+//
+// BenchSuggest:
+//
+// Times suggestions for misspellings of a sample of the words (a
+// letter changed, deleted, inserted or two swapped) with the
+// deletion index, against checking every word.  Times are in
+// microseconds per query.
+//
+void BenchSuggest(Graph *G)
+{
+  static char words[256][64];
+  int         n = 0;
+  int         step = G->NumVertices / 256 + 1;
+  Vertex      v;
+
+  for (v = 0; v < G->NumVertices && n < 256; v += step)
+  {
+    char *name = G->Names[v];
+    int   len = (int)strlen(name);
+    int   p = len / 2;
+
+    if (len < 3 || len >= 62)
+      continue;
+
+    strcpy(words[n], name);
+
+    switch (n % 4)
+    {
+      case 0:  // changed:
+        words[n][p] = (name[p] == 'z') ? 'a' : name[p] + 1;
+        break;
+      case 1:  // deleted:
+        memmove(&words[n][p], &name[p + 1], len - p);
+        break;
+      case 2:  // inserted:
+        memmove(&words[n][p + 1], &name[p], len - p + 1);
+        words[n][p] = 'e';
+        break;
+      default:  // swapped:
+        words[n][p] = name[p - 1];
+        words[n][p - 1] = name[p];
+        break;
+    }
+
+    n++;
+  }
+
+  printf(">>Suggestions (us per query), %d misspellings, 2 edits:\n", n);
+
+  Suggester *index;
+  Vertex    *found1, *found2;
+  double     buildTime, indexTime, scanTime;
+  int        i;
+
+  for (i = 1; i <= 2; ++i)
+  {
+    timer_start();
+    BuildSuggester(G, i);
+    timer_stop();
+    buildTime = 1000.0 * timer_value();
+
+    printf("  index of %d edits: %d deletions, %lld bytes, built in %.2f ms\n",
+      i, G->Suggest->NumEntries, G->Suggest->Bytes, buildTime);
+  }
+
+  timer_start();
+  found1 = _suggestAll(G, words, n);
+  timer_stop();
+  indexTime = 1000000.0 * timer_value() / n;
+
+  index = G->Suggest;  // without the index, Suggest checks every word:
+  G->Suggest = NULL;
+
+  timer_start();
+  found2 = _suggestAll(G, words, n);
+  timer_stop();
+  scanTime = 1000000.0 * timer_value() / n;
+
+  G->Suggest = index;
+
+  int same = 1, ends = 0;
+
+  for (i = 0; same && ends < n; ++i)  // n lists, each ending with -1:
+  {
+    same = (found1[i] == found2[i]);
+    ends += (found1[i] == -1);
+  }
+
+  int hits = 0, j = 0;
+
+  for (i = 0, v = 0; v < G->NumVertices && i < n; v += step)  // original found?
+  {
+    int len = (int)strlen(G->Names[v]);
+    int hit = 0;
+
+    if (len < 3 || len >= 62)
+      continue;
+
+    for (; found1[j] != -1; ++j)
+      hit |= (found1[j] == v);
+    j++;
+
+    hits += hit;
+    i++;
+  }
+
+  printf("  %-12s %10s %10s %10s\n", "", "index", "scan", "found");
+  printf("  %-12s %10.2f %10.2f %7d/%d%s\n", "top 5", indexTime, scanTime, hits, n,
+    same ? "" : " **differs**");
+
+  myfree(found1);
+  myfree(found2);
+
+  DeleteSuggester(G->Suggest);
+  G->Suggest = NULL;
+}
+
+//
+// _averageEdgeSpan:
+//
+// Returns the average |src - dest| over all edges, a measure of
+// how far apart neighbors are in the per-vertex arrays.
+//
+static double _averageEdgeSpan(Graph *G)
+{
+  double span = 0.0;
+  Vertex v;
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    NeighborIter it;
+    Vertex       w;
+
+    BeginNeighbors(G, v, &it);
+    while ((w = NextNeighbor(&it, NULL)) != -1)
+      span += abs(w - v);
+  }
+
+  return (G->NumEdges > 0) ? span / G->NumEdges : 0.0;
+}
+
+//
+// BenchRelabel:
+//
+// Times the same traversals (single-threaded BFS sweeps from 256
+// words, and a 256 x 256 multi-source distance table) on the graph
+// as built, then after each relabeling.  Times are in milliseconds.
+//
+void BenchRelabel(Graph *G)
+{
+  char  *methods[] = { "none", "bfs", "rcm", "degree" };
+  int    numMethods = sizeof(methods) / sizeof(methods[0]);
+  char  *words[256];
+  Vertex sources[256];
+  int    numWords = 256;
+  int    m, i;
+
+  if (numWords > G->NumVertices)
+    numWords = G->NumVertices;
+
+  for (i = 0; i < numWords; ++i)  // spread across the dictionary:
+    words[i] = G->Names[(int)((long long)i * G->NumVertices / numWords)];
+
+  printf(">>Relabeling (ms):\n");
+  printf("  %-8s %10s %10s %10s %10s\n", "order", "relabel", "edge span", "BFS x256", "table");
+
+  for (m = 0; m < numMethods; ++m)
+  {
+    double relabelTime = 0.0;
+
+    if (m > 0)
+    {
+      timer_start();
+
+      Vertex *order = RelabelOrder(G, ParseRelabelMethod(methods[m]));
+      RelabelGraph(G, order);
+      myfree(order);
+
+      timer_stop();
+      relabelTime = 1000.0 * timer_value();
+    }
+
+    for (i = 0; i < numWords; ++i)
+      sources[i] = Name2Vertex(G, words[i]);
+
+    timer_start();
+    for (i = 0; i < numWords; ++i)
+      myfree(ParallelBFS(G, sources[i], 1));
+    timer_stop();
+
+    double sweepTime = 1000.0 * timer_value();
+
+    timer_start();
+    myfree(MultiSourceDistances(G, sources, numWords, sources, numWords));
+    timer_stop();
+
+    printf("  %-8s %10.2f %10.1f %10.2f %10.2f\n", methods[m], relabelTime,
+      _averageEdgeSpan(G), sweepTime, 1000.0 * timer_value());
+  }
+}
+
+//
+// _decodeAll:
+//
+// Iterates over every edge of the graph, returning the sum of
+// the dests (so the work isn't optimized away).
+//
+static long long _decodeAll(Graph *G)
+{
+  long long sum = 0;
+  Vertex    v, w;
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    NeighborIter it;
+
+    BeginNeighbors(G, v, &it);
+    while ((w = NextNeighbor(&it, NULL)) != -1)
+      sum += w;
+  }
+
+  return sum;
+}
+
+//
+// _timeTraversals:
+//
+// Times 10 passes over all edges, BFS sweeps from the given
+// sources, and a multi-source table; prints them in ms.
+//
+static void _timeTraversals(Graph *G, char *layout, long long bytes,
+                            Vertex *sources, int numSources)
+{
+  double decodeTime, sweepTime, tableTime;
+  int    i;
+
+  timer_start();
+  for (i = 0; i < 10; ++i)
+    _decodeAll(G);
+  timer_stop();
+  decodeTime = 1000.0 * timer_value();
+
+  timer_start();
+  for (i = 0; i < numSources; ++i)
+    myfree(ParallelBFS(G, sources[i], 1));
+  timer_stop();
+  sweepTime = 1000.0 * timer_value();
+
+  timer_start();
+  myfree(MultiSourceDistances(G, sources, numSources, sources, numSources));
+  timer_stop();
+  tableTime = 1000.0 * timer_value();
+
+  printf("  %-12s %12lld %10.2f %10.2f %10.2f %10.2f\n", layout, bytes,
+    (G->NumEdges > 0) ? (double)bytes / G->NumEdges : 0.0,
+    decodeTime, sweepTime, tableTime);
+}
+
+//
+// BenchCompress:
+//
+// Compares memory and traversal times of the adjacency lists
+// against the compressed lists.  Times are in milliseconds.
+//
+void BenchCompress(Graph *G)
+{
+  Vertex sources[256];
+  int    numSources = 256;
+  int    i;
+
+  if (numSources > G->NumVertices)
+    numSources = G->NumVertices;
+
+  for (i = 0; i < numSources; ++i)
+    sources[i] = (int)((long long)i * G->NumVertices / numSources);
+
+  printf(">>Compressed adjacency (ms):\n");
+  printf("  %-12s %12s %10s %10s %10s %10s\n", "layout", "bytes", "per edge",
+    "decode x10", "BFS x256", "table");
+
+  _timeTraversals(G, "lists", (long long)G->NumEdges * sizeof(Edge), sources, numSources);
+
+  timer_start();
+  CompressGraph(G, 0 /*keep lists*/);
+  timer_stop();
+
+  double compressTime = 1000.0 * timer_value();
+
+  _timeTraversals(G, "compressed", CompressedBytes(G->Compressed), sources, numSources);
+
+  printf("  (compressing took %.2f ms)\n", compressTime);
+
+  //
+  // back to the lists for the other sections:
+  //
+  DeleteCompressedAdj(G->Compressed);
+  G->Compressed = NULL;
+}
+
+//
+// _timeSearches:
+//
+// Times a BFS and a shortest ladder from each of the sources, in
+// milliseconds, returning the # of vertices visited by the BFSs.
+//
+static long long _timeSearches(Graph *G, Vertex *sources, int numSources,
+                               double *bfsTime, double *pathTime)
+{
+  long long visited = 0;
+  int       i, j;
+
+  timer_start();
+  for (i = 0; i < numSources; ++i)
+  {
+    Vertex *order = BFS(G, sources[i]);
+
+    for (j = 0; order[j] != -1; ++j)
+      visited++;
+
+    myfree(order);
+  }
+  timer_stop();
+  *bfsTime = 1000.0 * timer_value();
+
+  timer_start();
+  for (i = 0; i + 1 < numSources; ++i)
+    myfree(BFSd(G, sources[i], 16));
+  timer_stop();
+  *pathTime = 1000.0 * timer_value();
+
+  return visited;
+}
+
+//
+// BenchHypergraph:
+//
+// Compares memory and search times of the adjacency lists against
+// the word-pattern hypergraph.  Times are in milliseconds.
+//
+void BenchHypergraph(Graph *G)
+{
+  Vertex    sources[64];
+  int       numSources = 64;
+  double    bfsTime, pathTime, buildTime;
+  long long visited1, visited2;
+  int       i;
+
+  if (numSources > G->NumVertices)
+    numSources = G->NumVertices;
+
+  for (i = 0; i < numSources; ++i)
+    sources[i] = (int)((long long)i * G->NumVertices / numSources);
+
+  printf(">>Hypergraph (ms):\n");
+  printf("  %-12s %12s %10s %10s\n", "layout", "bytes", "BFS x64", "BFSd x63");
+
+  visited1 = _timeSearches(G, sources, numSources, &bfsTime, &pathTime);
+  printf("  %-12s %12lld %10.2f %10.2f\n", "lists",
+    (long long)G->NumEdges * sizeof(Edge), bfsTime, pathTime);
+
+  timer_start();
+  BuildHypergraph(G);
+  timer_stop();
+  buildTime = 1000.0 * timer_value();
+
+  visited2 = _timeSearches(G, sources, numSources, &bfsTime, &pathTime);
+  printf("  %-12s %12lld %10.2f %10.2f\n", "hypergraph",
+    HypergraphBytes(G->Hyper), bfsTime, pathTime);
+
+  printf("  (building took %.2f ms; %d patterns for %lld implied edges; %s)\n",
+    buildTime, G->Hyper->NumPatterns, HypergraphImpliedEdges(G->Hyper),
+    (visited1 == visited2) ? "same visits" : "**visits differ**");
+
+  //
+  // back to the lists for the other sections:
+  //
+  DeleteHypergraph(G->Hyper);
+  G->Hyper = NULL;
+}
+
+//
+// BenchImplicit:
+//
+// Compares startup and per-query times of the materialized graph
+// against implicit mode, given how long AddEdges took, and reports
+// after how many queries materializing the edges pays off.  Times
+// are in milliseconds.
+//
+void BenchImplicit(Graph *G, double edgesTime)
+{
+  Vertex    sources[64];
+  int       numSources = 64;
+  double    bfsTime1, pathTime1, bfsTime2, pathTime2;
+  long long visited1, visited2;
+  int       i;
+
+  if (numSources > G->NumVertices)
+    numSources = G->NumVertices;
+
+  for (i = 0; i < numSources; ++i)
+    sources[i] = (int)((long long)i * G->NumVertices / numSources);
+
+  printf(">>Implicit neighbors (ms):\n");
+  printf("  %-12s %10s %10s %10s\n", "layout", "startup", "BFS x64", "BFSd x63");
+
+  visited1 = _timeSearches(G, sources, numSources, &bfsTime1, &pathTime1);
+  printf("  %-12s %10.2f %10.2f %10.2f\n", "lists", edgesTime, bfsTime1, pathTime1);
+
+  UseImplicitEdges(G);
+
+  visited2 = _timeSearches(G, sources, numSources, &bfsTime2, &pathTime2);
+  printf("  %-12s %10.2f %10.2f %10.2f\n", "implicit", 0.0, bfsTime2, pathTime2);
+
+  double perQuery = (bfsTime2 - bfsTime1) / numSources;
+
+  if (perQuery > 0.0)
+    printf("  (edges pay off after ~%.0f BFSs; %s)\n", edgesTime / perQuery,
+      (visited1 == visited2) ? "same visits" : "**visits differ**");
+  else
+    printf("  (implicit is never slower; %s)\n",
+      (visited1 == visited2) ? "same visits" : "**visits differ**");
+
+  //
+  // back to the lists for the other sections:
+  //
+  G->Implicit = 0;  /*false*/
+}
+
+//
+// _timeTrees:
+//
+// Searches from each of the n sources to every vertex in W, returning
+// the sum of the distances found (a checksum); the time is stored
+// via ms.
+//
+static long long _timeTrees(Graph *G, SearchWorkspace *W, Vertex *sources, int n,
+                            double *ms)
+{
+  long long sum = 0;
+  int       i;
+  Vertex    v;
+
+  *ms = 0.0;
+
+  for (i = 0; i < n; ++i)
+  {
+    timer_start();
+    SearchFrom(G, W, sources[i], -1);
+    timer_stop();
+
+    *ms += 1000.0 * timer_value();
+
+    for (v = 0; v < G->NumVertices; ++v)
+    {
+      if (WorkspaceDistance(W, v) > 0)
+        sum += WorkspaceDistance(W, v);
+    }
+  }
+
+  return sum;
+}
+
+//
+// _startWord:
+//
+// Returns the word the search benchmarks start from: "cat", or if
+// the dictionary has none, the word with the most neighbors; -1 if
+// no word has any.
+//
+static Vertex _startWord(Graph *G)
+{
+  Vertex v = Name2Vertex(G, "cat");
+  Vertex best = -1;
+  int    bestDegree = 0;
+
+  if (v >= 0)
+    return v;
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    NeighborIter it;
+    int          degree = 0;
+
+    BeginNeighbors(G, v, &it);
+    while (NextNeighbor(&it, NULL) != -1)
+      degree++;
+
+    if (degree > bestDegree)
+    {
+      best = v;
+      bestDegree = degree;
+    }
+  }
+
+  return best;
+}
+
+//
+// _startComponent:
+//
+// Returns the words of the component of the start word (see
+// _startWord), as BFS does, and sets *count to their #; NULL (and
+// prints that the section is skipped) if there is no start word.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+static Vertex *_startComponent(Graph *G, int *count)
+{
+  Vertex  start = _startWord(G);
+  Vertex *connected;
+
+  *count = 0;
+
+  if (start < 0)
+  {
+    printf("  (no word has a neighbor, skipped)\n");
+    return NULL;
+  }
+
+  connected = BFS(G, start);
+
+  while (connected[*count] != -1)
+    (*count)++;
+
+  return connected;
+}
+
+//
+// _sampleComponent:
+//
+// Fills words[] with up to max words spread over the component of
+// the start word, returning how many; 0 if there is none.
+//
+static int _sampleComponent(Graph *G, Vertex *words, int max)
+{
+  int     n = 0;
+  int     i, count;
+  Vertex *connected = _startComponent(G, &count);
+
+  if (connected == NULL)
+    return 0;
+
+  for (i = 0; i < count && n < max; i += count / max + 1)
+    words[n++] = connected[i];
+
+  myfree(connected);
+
+  return n;
+}
+
+//
+// BenchWeighted:
+//
+// Times full searches from a sample of the words connected to the
+// start word (see _startWord) under each cost model, on the bucket
+// queue and on a binary heap, against BFS.  Times are in
+// milliseconds.
+//
+void BenchWeighted(Graph *G)
+{
+  static int models[] = { COST_UNIT, COST_POSITION, COST_RARITY };
+  Vertex     sources[64];
+  int        n = _sampleComponent(G, sources, 64);
+  double     bfsTime, bucketTime, heapTime;
+  int        i;
+
+  if (n == 0)
+    return;
+
+  timer_start();
+  for (i = 0; i < n; ++i)
+    myfree(BFS(G, sources[i]));
+  timer_stop();
+  bfsTime = 1000.0 * timer_value();
+
+  printf(">>Weighted searches (ms), from %d words:\n", n);
+  printf("  %-12s %10s %10s %10s\n", "cost", "buckets", "heap", "BFS");
+
+  SearchWorkspace *W = CreateWorkspace(G);
+
+  for (i = 0; i < 3; ++i)
+  {
+    long long sum1, sum2;
+
+    UseCostModel(G, models[i]);
+
+    W->ForceHeap = 0;  /*false*/
+    sum1 = _timeTrees(G, W, sources, n, &bucketTime);
+
+    W->ForceHeap = 1;  /*true*/
+    sum2 = _timeTrees(G, W, sources, n, &heapTime);
+
+    printf("  %-12s %10.2f %10.2f %10.2f%s\n", CostModelName(G), bucketTime, heapTime,
+      bfsTime, (sum1 == sum2) ? "" : " **differs**");
+  }
+
+  DeleteWorkspace(W);
+
+  UseCostModel(G, COST_UNIT);
+}
+
+//
+// BenchKPaths:
+//
+// Times KShortestPaths for k = 1, 10 and 100 between pairs of words
+// sampled from the component of the start word (see _startWord).
+// Times are in milliseconds per query.
+//
+void BenchKPaths(Graph *G)
+{
+  static int ks[] = { 1, 10, 100 };
+  Vertex     words[32];
+  int        n;
+  int        i, j;
+
+  n = _sampleComponent(G, words, 32);
+
+  if (n < 2)
+    return;
+
+  printf(">>K shortest ladders (ms per query), %d queries:\n", n / 2);
+  printf("  %-12s %10s %10s\n", "k", "time", "ladders");
+
+  for (j = 0; j < 3; ++j)
+  {
+    long long found = 0;
+
+    timer_start();
+    for (i = 0; i + 1 < n; i += 2)
+    {
+      Vertex **paths = KShortestPaths(G, words[i], words[i + 1], ks[j], NULL, NULL, NULL);
+      int      m;
+
+      for (m = 0; paths[m] != NULL; ++m)
+        found++;
+
+      DeletePaths(paths);
+    }
+    timer_stop();
+
+    printf("  %-12d %10.2f %10lld\n", ks[j], 1000.0 * timer_value() / (n / 2), found);
+  }
+}
+
+//
+// BenchDAG:
+//
+// Times BuildShortestPathDAG between pairs of words sampled from
+// the component of the start word (see _startWord), against
+// Dijkstra for one ladder, and enumerating every shortest ladder
+// from the DAG against asking KShortestPaths for them.  Times are in milliseconds per query.
+//
+void BenchDAG(Graph *G)
+{
+  Vertex    words[64];
+  int       n;
+  int       i;
+  long long dagVertices = 0, dagEdges = 0, numPaths = 0, enumerated = 0, yenPaths = 0;
+
+  n = _sampleComponent(G, words, 64);
+
+  if (n < 2)
+    return;
+
+  timer_start();
+  for (i = 0; i + 1 < n; i += 2)
+    myfree(Dijkstra(G, words[i], words[i + 1]));
+  timer_stop();
+
+  double dijkstraTime = 1000.0 * timer_value() / (n / 2);
+
+  timer_start();
+  for (i = 0; i + 1 < n; i += 2)
+  {
+    ShortestPathDAG *D = BuildShortestPathDAG(G, words[i], words[i + 1], NULL);
+
+    dagVertices += D->NumVertices;
+    dagEdges += D->NumEdges;
+    numPaths += D->NumPaths;
+
+    DeleteShortestPathDAG(D);
+  }
+  timer_stop();
+
+  double dagTime = 1000.0 * timer_value() / (n / 2);
+
+  timer_start();
+  for (i = 0; i + 1 < n; i += 2)
+  {
+    ShortestPathDAG *D = BuildShortestPathDAG(G, words[i], words[i + 1], NULL);
+    DAGPathIter      it;
+
+    BeginShortestPaths(D, &it);
+    while (NextShortestPath(&it) != NULL)
+      enumerated++;
+    EndShortestPaths(&it);
+
+    DeleteShortestPathDAG(D);
+  }
+  timer_stop();
+
+  double enumerateTime = 1000.0 * timer_value() / (n / 2);
+
+  timer_start();
+  for (i = 0; i + 1 < n; i += 2)
+  {
+    unsigned long long k = CountShortestPaths(G, words[i], words[i + 1], NULL, NULL);
+    Vertex           **paths = KShortestPaths(G, words[i], words[i + 1], (int)k, NULL, NULL, NULL);
+    int                m;
+
+    for (m = 0; paths[m] != NULL; ++m)
+      yenPaths++;
+
+    DeletePaths(paths);
+  }
+  timer_stop();
+
+  double yenTime = 1000.0 * timer_value() / (n / 2);
+
+  printf(">>Shortest-ladder DAGs (ms per query), %d queries:\n", n / 2);
+  printf("  avg DAG: %.1f vertices, %.1f edges, %.1f ladders\n",
+    (double)dagVertices / (n / 2), (double)dagEdges / (n / 2), (double)numPaths / (n / 2));
+  printf("  %-24s %10s %10s\n", "", "time", "ladders");
+  printf("  %-24s %10.2f %10d\n", "Dijkstra (one)", dijkstraTime, n / 2);
+  printf("  %-24s %10.2f %10lld\n", "DAG + count", dagTime, numPaths);
+  printf("  %-24s %10.2f %10lld%s\n", "DAG + enumerate", enumerateTime, enumerated,
+    (enumerated == numPaths) ? "" : " **differs**");
+  printf("  %-24s %10.2f %10lld%s\n", "KShortestPaths (all)", yenTime, yenPaths,
+    (yenPaths == numPaths) ? "" : " **differs**");
+}
+
+//
+// BenchWaypoints:
+//
+// Times ladders through 6 waypoints sampled from the component of
+// the start word (see _startWord), with the first visited twice (so
+// that its tree is reused): as separate Dijkstra calls, one per leg, against WaypointLadder in
+// order and in any order.  Times are in milliseconds per query.
+//
+void BenchWaypoints(Graph *G)
+{
+  Vertex    words[64];
+  Vertex    waypoints[8];
+  int       n, numQueries = 0;
+  int       i, j;
+  long long dijkstraLength = 0, orderedCost = 0, anyCost = 0;
+  double    dijkstraTime = 0.0, orderedTime = 0.0, anyTime = 0.0;
+
+  n = _sampleComponent(G, words, 64);
+
+  if (n < 6)
+    return;
+
+  for (i = 0; i + 5 <= n; i += 5)
+  {
+    int cost;
+
+    for (j = 0; j < 5; ++j)
+      waypoints[j] = words[i + j];
+    waypoints[5] = waypoints[0];  // (back, then on)
+    waypoints[6] = words[(i + 5) % n];
+
+    timer_start();
+    for (j = 0; j < 6; ++j)
+    {
+      Vertex *path = Dijkstra(G, waypoints[j], waypoints[j + 1]);
+      int     m;
+
+      for (m = 0; path[m] != -1; ++m)
+        ;
+      dijkstraLength += (m > 0) ? m - 1 : 0;
+      myfree(path);
+    }
+    timer_stop();
+    dijkstraTime += timer_value();
+
+    timer_start();
+    myfree(WaypointLadder(G, waypoints, 7, 0 /*in order*/, NULL, &cost));
+    timer_stop();
+    orderedTime += timer_value();
+    orderedCost += cost;
+
+    timer_start();
+    myfree(WaypointLadder(G, waypoints, 7, 1 /*any order*/, NULL, &cost));
+    timer_stop();
+    anyTime += timer_value();
+    anyCost += cost;
+
+    numQueries++;
+  }
+
+  printf(">>Waypoint ladders (ms per query), %d queries of 7 words:\n", numQueries);
+  printf("  %-24s %10s %10s\n", "", "time", "length");
+  printf("  %-24s %10.2f %10lld\n", "Dijkstra per leg", 1000.0 * dijkstraTime / numQueries, dijkstraLength);
+  printf("  %-24s %10.2f %10lld%s\n", "WaypointLadder", 1000.0 * orderedTime / numQueries, orderedCost,
+    (orderedCost == dijkstraLength) ? "" : " **differs**");
+  printf("  %-24s %10.2f %10lld\n", "WaypointLadder, any order", 1000.0 * anyTime / numQueries, anyCost);
+}
+
+//
+// BenchFilter:
+//
+// Times whole-tree searches from words sampled from the component
+// of the start word (see _startWord) with no search options, with
+// options that exclude nothing, with every 100th word excluded, and
+// with 'q' banned and 'z' banned as a second letter.  Times are in milliseconds
+// for all the searches, with the # of vertices they settled.
+//
+void BenchFilter(Graph *G)
+{
+  SearchWorkspace *W = CreateWorkspace(G);
+  SearchOptions    none, excluded, letters;
+  Vertex           sources[32];
+  int              n;
+  int              i;
+  double           ms;
+
+  n = _sampleComponent(G, sources, 32);
+
+  if (n < 1)
+  {
+    DeleteWorkspace(W);
+    return;
+  }
+
+  InitSearchOptions(&none);
+  InitSearchOptions(&excluded);
+  InitSearchOptions(&letters);
+
+  for (i = 0; i < G->NumVertices; i += 100)
+    ExcludeVertex(G, &excluded, i);
+
+  ExcludeLetters(&letters, -1, "q");
+  ExcludeLetters(&letters, 1, "z");
+
+  struct { char *Name; SearchOptions *Options; } cases[] =
+  {
+    { "no options", NULL },
+    { "options, none set", &none },
+    { "1% of words excluded", &excluded },
+    { "letters banned", &letters }
+  };
+
+  printf(">>Search filters (ms for %d whole-tree searches):\n", n);
+  printf("  %-24s %10s %10s\n", "", "time", "settled");
+
+  for (i = 0; i < 4; ++i)
+  {
+    long long settled = 0;
+    int       j;
+
+    W->Options = cases[i].Options;
+
+    _timeTrees(G, W, sources, n, &ms);
+
+    for (j = 0; j < n; ++j)  // (untimed)
+    {
+      SearchFrom(G, W, sources[j], -1);
+      settled += W->Settled;
+    }
+
+    printf("  %-24s %10.2f %10lld\n", cases[i].Name, ms, settled);
+  }
+
+  ClearSearchOptions(&excluded);
+  ClearSearchOptions(&letters);
+  DeleteWorkspace(W);
+}
+
+//
+// _timeClosest:
+//
+// Finds the closest reachable word for each of the n (source,
+// target) pairs by the given metric, returning the sum of the
+// distances found (a checksum); the time is stored via ms.
+//
+static long long _timeClosest(Graph *G, Vertex *sources, Vertex *targets, int n,
+                              int metric, double *ms)
+{
+  long long sum = 0;
+  int       i, distance;
+
+  timer_start();
+  for (i = 0; i < n; ++i)
+  {
+    ClosestReachable(G, sources[i], Vertex2Name(G, targets[i]), metric, NULL, &distance);
+    sum += distance;
+  }
+  timer_stop();
+
+  *ms = 1000.0 * timer_value() / n;
+
+  return sum;
+}
+
+//
+// BenchClosest:
+//
+// Times ClosestReachable from words of the component of the start
+// word (see _startWord) to words of the same length outside it, with the component index
+// and without (a BFS and scan of the component), against Dijkstra
+// between words of the component.  Times are in milliseconds per
+// query.
+//
+void BenchClosest(Graph *G)
+{
+  static char *names[] = { "none", "hamming", "edit" };
+  Vertex       sources[32], targets[32];
+  int          n = _sampleComponent(G, sources, 32);
+  int          i, metric;
+  double       ms, indexed, scanned;
+
+  if (n < 2)
+    return;
+
+  timer_start();
+  for (i = 0; i + 1 < n; ++i)
+    myfree(Dijkstra(G, sources[i], sources[i + 1]));
+  timer_stop();
+
+  ms = 1000.0 * timer_value() / (n - 1);
+
+  BuildComponentIndex(G);
+
+  for (i = 0; i < n; ++i)  // a word of its length, in another component:
+  {
+    Vertex v = (sources[i] * 7919 + 1) % G->NumVertices;
+
+    while (G->Components->Component[v] == G->Components->Component[sources[i]] ||
+           strlen(Vertex2Name(G, v)) != strlen(Vertex2Name(G, sources[i])))
+      v = (v + 1) % G->NumVertices;
+
+    targets[i] = v;
+  }
+
+  printf(">>Closest reachable word (ms per query), %d queries:\n", n);
+  printf("  component index: %d components, %lld bytes, built in %.2f ms\n",
+    G->Components->NumComponents, G->Components->Bytes, G->Components->BuildTime);
+  printf("  %-12s %10s %10s\n", "metric", "indexed", "scan");
+
+  for (metric = CLOSEST_HAMMING; metric <= CLOSEST_EDIT; ++metric)
+  {
+    ComponentIndex *C = G->Components;
+    long long       sum1, sum2;
+
+    sum1 = _timeClosest(G, sources, targets, n, metric, &indexed);
+
+    G->Components = NULL;  // (scan)
+    sum2 = _timeClosest(G, sources, targets, n, metric, &scanned);
+    G->Components = C;
+
+    printf("  %-12s %10.3f %10.3f%s\n", names[metric], indexed, scanned,
+      (sum1 == sum2) ? "" : " **differs**");
+  }
+
+  printf("  %-12s %10.3f\n", "(Dijkstra)", ms);
+
+  DeleteComponentIndex(G->Components);
+  G->Components = NULL;
+}
+
+//
+// BenchTree:
+//
+// Times answering queries from one source to each of n targets in
+// the component of the start word (see _startWord): by Dijkstra per
+// query, and by one SingleSourceTree then TreePath per query, and
+// times LadderHistogram.  Times are in milliseconds, for all the queries.
+//
+void BenchTree(Graph *G)
+{
+  static int counts[] = { 1, 10, 100, 1000 };
+  long long  length1, length2;
+  int        i, j, n;
+  double     ms;
+
+  Vertex *connected = _startComponent(G, &n);
+
+  if (connected == NULL)
+    return;
+
+  Vertex src = connected[0];
+
+  printf(">>Single-source trees (ms for all queries), from \"%s\":\n", Vertex2Name(G, src));
+  printf("  %-12s %10s %10s\n", "queries", "Dijkstra", "tree");
+
+  for (j = 0; j < 4; ++j)
+  {
+    double dijkstraTime, treeTime;
+
+    length1 = length2 = 0;
+
+    timer_start();
+    for (i = 0; i < counts[j]; ++i)
+    {
+      Vertex *path = Dijkstra(G, src, connected[(i * 7919) % n]);
+      int     m;
+
+      for (m = 0; path[m] != -1; ++m)
+        length1++;
+      myfree(path);
+    }
+    timer_stop();
+    dijkstraTime = 1000.0 * timer_value();
+
+    timer_start();
+    SingleSourceTree *T = BuildSingleSourceTree(G, NULL, src);
+
+    for (i = 0; i < counts[j]; ++i)
+    {
+      Vertex *path = TreePath(T, connected[(i * 7919) % n]);
+      int     m;
+
+      for (m = 0; path[m] != -1; ++m)
+        length2++;
+      myfree(path);
+    }
+
+    DeleteSingleSourceTree(T);
+    timer_stop();
+    treeTime = 1000.0 * timer_value();
+
+    printf("  %-12d %10.2f %10.2f%s\n", counts[j], dijkstraTime, treeTime,
+      (length1 == length2) ? "" : " **differs**");
+  }
+
+  myfree(connected);
+
+  SingleSourceTree *T = BuildSingleSourceTree(G, NULL, src);
+
+  timer_start();
+  myfree(LadderHistogram(T));
+  timer_stop();
+  ms = 1000.0 * timer_value();
+
+  printf("  histogram:   %.2f ms (%d reachable)\n", ms, T->NumReached - 1);
+
+  DeleteSingleSourceTree(T);
+}
+
+//
+// _skewedQueries:
+//
+// Fills src[] and dest[] with n queries between words of the
+// component of the start word (see _startWord), skewed as real
+// traffic is: the sources are drawn from 512 words, the popular ones
+// far more often (rank r*r/512 for r uniform), and a quarter of the
+// pairs repeat an earlier one.  Returns false (0) if there is no
+// start word.
+//
+static int _skewedQueries(Graph *G, Vertex *src, Vertex *dest, int n)
+{
+  unsigned int seed = 12345;
+  int          i, count;
+
+  Vertex *connected = _startComponent(G, &count);
+
+  if (connected == NULL)
+    return 0;  /*false*/
+
+  for (i = 0; i < n; ++i)
+  {
+    int r;
+
+    seed = seed * 1103515245 + 12345;
+
+    if (i > 0 && (seed >> 16) % 4 == 0)  // repeat an earlier pair:
+    {
+      int j = (seed >> 8) % i;
+
+      src[i] = src[j];
+      dest[i] = dest[j];
+      continue;
+    }
+
+    seed = seed * 1103515245 + 12345;
+    r = (seed >> 8) % 512;
+
+    seed = seed * 1103515245 + 12345;
+
+    src[i] = connected[((r * r / 512) * 7919) % count];
+    dest[i] = connected[(seed >> 8) % count];
+  }
+
+  myfree(connected);
+
+  return 1;  /*true*/
+}
+
+typedef struct CacheWorker
+{
+  pthread_t    Thread;
+  Graph       *G;
+  LadderCache *C;
+  Vertex      *Src;
+  Vertex      *Dest;
+  int          First;      // queries First, First + Step, ...
+  int          Step;
+  int          N;
+  long long    Sum;        // of the ladder lengths found
+} CacheWorker;
+
+static void *_cacheWorker(void *arg)
+{
+  CacheWorker *w = (CacheWorker *)arg;
+  int          i, m;
+
+  for (i = w->First; i < w->N; i += w->Step)
+  {
+    Vertex *path = CachedShortestPath(w->G, w->C, w->Src[i], w->Dest[i]);
+
+    for (m = 0; path[m] != -1; ++m)
+      w->Sum++;
+    myfree(path);
+  }
+
+  return NULL;
+}
+
+//
+// _timeCache:
+//
+// Answers the n queries from a new cache of the given budget, on
+// the given # of threads, printing the time and the cache's stats;
+// returns the sum of the ladder lengths found (a checksum).
+//
+static long long _timeCache(Graph *G, Vertex *src, Vertex *dest, int n,
+                            long long budget, int numThreads)
+{
+  LadderCache *C = CreateLadderCache(budget);
+  CacheWorker  workers[16];
+  long long    sum = 0;
+  int          t;
+
+  timer_start();
+
+  for (t = 0; t < numThreads; ++t)
+  {
+    workers[t].G = G;
+    workers[t].C = C;
+    workers[t].Src = src;
+    workers[t].Dest = dest;
+    workers[t].First = t;
+    workers[t].Step = numThreads;
+    workers[t].N = n;
+    workers[t].Sum = 0;
+
+    if (pthread_create(&workers[t].Thread, NULL, _cacheWorker, &workers[t]) != 0)
+    {
+      printf("\n**Error in BenchCache: pthread_create failed\n\n");
+      exit(-1);
+    }
+  }
+
+  for (t = 0; t < numThreads; ++t)
+  {
+    pthread_join(workers[t].Thread, NULL);
+    sum += workers[t].Sum;
+  }
+
+  timer_stop();
+
+  printf("  %6.2f MB, %d thread(s): %8.2f ms, %6.1f%% hits, %lld evictions\n",
+    budget / (1024.0 * 1024.0), numThreads, 1000.0 * timer_value(),
+    100.0 * (C->PathHits + C->TreeHits) / n, C->Evictions);
+
+  DeleteLadderCache(C);
+
+  return sum;
+}
+
+//
+// BenchCache:
+//
+// Times a skewed stream of queries (see _skewedQueries) answered by
+// Dijkstra, and by CachedShortestPath with budgets from small to
+// ample, on 1 thread and on 4 sharing the cache.
+//
+void BenchCache(Graph *G)
+{
+  static long long budgets[] = { 256 * 1024LL, 4 * 1024 * 1024LL, 64 * 1024 * 1024LL };
+  int              n = 4000;
+  Vertex          *src = (Vertex *)mymalloc(n * sizeof(Vertex));
+  Vertex          *dest = (Vertex *)mymalloc(n * sizeof(Vertex));
+  long long        sum = 0, sum2;
+  int              i, j, m;
+
+  if (src == NULL || dest == NULL)
+  {
+    printf("\n**Error in BenchCache: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  if (!_skewedQueries(G, src, dest, n))
+  {
+    myfree(src);
+    myfree(dest);
+    return;
+  }
+
+  printf(">>Ladder cache, %d skewed queries:\n", n);
+
+  timer_start();
+  for (i = 0; i < n; ++i)
+  {
+    Vertex *path = Dijkstra(G, src[i], dest[i]);
+
+    for (m = 0; path[m] != -1; ++m)
+      sum++;
+    myfree(path);
+  }
+  timer_stop();
+
+  printf("  no cache:            %8.2f ms\n", 1000.0 * timer_value());
+
+  for (j = 0; j < 3; ++j)
+  {
+    sum2 = _timeCache(G, src, dest, n, budgets[j], 1);
+    if (sum2 != sum)
+      printf("  **differs**\n");
+  }
+
+  sum2 = _timeCache(G, src, dest, n, budgets[2], 4);
+  if (sum2 != sum)
+    printf("  **differs**\n");
+
+  myfree(src);
+  myfree(dest);
+}
+
+//
+// BenchBudget:
+//
+// Times whole-tree searches from words sampled from the component
+// of the start word (see _startWord) with no options, with a budget
+// too large to run out (the cost of checking it), and with budgets
+// of settled words and of time that do run out.  Times are in milliseconds for all the
+// searches, with the # of vertices they settled and how many gave
+// up.
+//
+void BenchBudget(Graph *G)
+{
+  SearchWorkspace *W = CreateWorkspace(G);
+  SearchOptions    ample, steps, timed;
+  Vertex           sources[32];
+  int              n;
+  int              i;
+
+  n = _sampleComponent(G, sources, 32);
+
+  if (n < 1)
+  {
+    DeleteWorkspace(W);
+    return;
+  }
+
+  InitSearchOptions(&ample);
+  InitSearchOptions(&steps);
+  InitSearchOptions(&timed);
+
+  ample.TimeLimit = 1000000.0;
+  ample.MaxSteps = G->NumVertices + 1;
+  steps.MaxSteps = 1000;
+  timed.TimeLimit = 0.1;
+
+  struct { char *Name; SearchOptions *Options; } cases[] =
+  {
+    { "no budget", NULL },
+    { "ample budget", &ample },
+    { "1000 words", &steps },
+    { "0.1 ms", &timed }
+  };
+
+  printf(">>Search budgets (ms for %d whole-tree searches):\n", n);
+  printf("  %-24s %10s %10s %10s\n", "", "time", "settled", "gave up");
+
+  for (i = 0; i < 4; ++i)
+  {
+    long long settled = 0;
+    int       timedOut = 0;
+    double    ms = 0.0;
+    int       j;
+
+    W->Options = cases[i].Options;
+
+    for (j = 0; j < n; ++j)
+    {
+      timer_start();
+      SearchFrom(G, W, sources[j], -1);
+      timer_stop();
+
+      ms += 1000.0 * timer_value();
+      settled += W->Settled;
+      timedOut += W->TimedOut;
+    }
+
+    printf("  %-24s %10.2f %10lld %10d\n", cases[i].Name, ms, settled, timedOut);
+  }
+
+  DeleteWorkspace(W);
+}
+
+//
+// _wallMs:
+//
+// Returns the monotonic wall-clock time, in ms (timer_value is CPU
+// time, summed over threads).
+//
+static double _wallMs(void)
+{
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+
+  return 1000.0 * t.tv_sec + t.tv_nsec / 1000000.0;
+}
+
+//
+// BenchParallel:
+//
+// Times whole BFSs from 64 words sampled from the component of the
+// start word (see _startWord), with 1, 2, 4 and 8 threads and one
+// per processor: from a pool of workers kept across the searches
+// (PoolBFS), and starting them for every search (ParallelBFS).  Times are wall-clock ms for
+// all the searches, with the speedup of the pool over 1 thread.
+//
+void BenchParallel(Graph *G)
+{
+  int       threads[] = { 1, 2, 4, 8, DefaultNumThreads() };
+  Vertex    sources[64];
+  int       n;
+  int       i, j;
+  double    base = 0.0;
+  long long check = -1;
+
+  n = _sampleComponent(G, sources, 64);
+
+  if (n < 1)
+    return;
+
+  for (i = 0; i < n; ++i)  // (warm up, untimed)
+    myfree(BFS(G, sources[i]));
+
+  printf(">>Parallel BFS (wall-clock ms for %d whole searches; processors: %d):\n", n,
+    DefaultNumThreads());
+  printf("  %-10s %10s %10s %10s\n", "threads", "pool", "speedup", "per call");
+
+  for (j = 0; j < 5; ++j)
+  {
+    PBFS     *S;
+    long long sum = 0;
+    double    start, pooled;
+
+    start = _wallMs();
+
+    S = CreateParallelBFS(G, threads[j]);
+    for (i = 0; i < n; ++i)
+    {
+      Vertex *visited = PoolBFS(S, sources[i]);
+      int     k;
+
+      for (k = 0; visited[k] != -1; ++k)  // (order-sensitive checksum)
+        sum = 31 * sum + visited[k];
+
+      myfree(visited);
+    }
+    DeleteParallelBFS(S);
+
+    pooled = _wallMs() - start;
+
+    if (j == 0)
+    {
+      base = pooled;
+      check = sum;
+    }
+
+    start = _wallMs();
+    for (i = 0; i < n; ++i)
+      myfree(ParallelBFS(G, sources[i], threads[j]));
+
+    printf("  %-10d %10.2f %9.2fx %10.2f%s\n", threads[j], pooled, base / pooled,
+      _wallMs() - start, (sum == check) ? "" : "  **differs**");
+  }
+}
+
+//
+// _insertionPairs:
+//
+// Counts the (word, longer word) pairs that differ by inserting a
+// char, the naive way: by probing for every insertion of every char
+// of the longer words' alphabet into every word.
+//
+static long long _insertionPairs(Graph *G)
+{
+  long long found = 0;
+  char      temp[256];
+  Vertex    v;
+  int       p;
+  char     *c;
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    char *name = G->Names[v];
+    int   len = (int)strlen(name);
+
+    if (len + 1 > G->MaxLength || len + 1 >= 256)
+      continue;
+
+    for (p = 0; p <= len; ++p)
+    {
+      memcpy(temp, name, p);
+      strcpy(&temp[p + 1], &name[p]);
+
+      for (c = G->Shards[len + 1].Alphabet[p]; *c != '\0'; ++c)
+      {
+        if (p > 0 && name[p - 1] == *c)  // same as inserting at p-1:
+          continue;
+
+        temp[p] = *c;
+        found += (Name2Vertex(G, temp) >= 0);
+      }
+    }
+  }
+
+  return found;
+}
+
+//
+// BenchEditEdges:
+//
+// Times AddEditEdges, which looks up each word's deletions, against
+// counting the same pairs by probing every insertion.  Times are in
+// milliseconds.
+//
+// NOTE: adds the edit edges to G.
+//
+void BenchEditEdges(Graph *G)
+{
+  double    deleteTime, insertTime;
+  long long pairs;
+
+  printf(">>Edit edges (ms):\n");
+
+  timer_start();
+  AddEditEdges(G);
+  timer_stop();
+  deleteTime = 1000.0 * timer_value();
+
+  timer_start();
+  pairs = _insertionPairs(G);
+  timer_stop();
+  insertTime = 1000.0 * timer_value();
+
+  printf("  %-12s %10s %10s\n", "", "time", "pairs");
+  printf("  %-12s %10.2f %10d\n", "deletions", deleteTime, G->NumEditEdges / 2);
+  printf("  %-12s %10.2f %10lld%s\n", "insertions", insertTime, pairs,
+    (pairs == G->NumEditEdges / 2) ? "" : " **differs**");
+}
+
+//
+// _wanted:
+//
+// Returns true (non-zero) if the named section should run.
+//
+static int _wanted(char *section, char **sections, int numSections)
+{
+  int i;
+
+  if (numSections == 0)  // none given => all:
+    return 1;
+
+  for (i = 0; i < numSections; ++i)
+  {
+    if (strcmp(sections[i], section) == 0)
+      return 1;
+  }
+
+  return 0;
+}
+
+//
+// main:
+//
+int main(int argc, char *argv[])
+{
+  char  *filename = "merriam-webster.txt";
+  char  *sections[16];
+  int    numSections = 0;
+  int    i;
+
+  for (i = 1; i < argc; ++i)
+  {
+    if (strcmp(argv[i], "-dict") == 0 && i + 1 < argc)
+      filename = argv[++i];
+    else if (argv[i][0] != '-' && numSections < 16)
+      sections[numSections++] = argv[i];
+    else
+    {
+      printf("usage: %s [-dict file] [section ...]\n", argv[0]);
+      return -1;
+    }
+  }
+
+  printf("** Word Ladder Benchmarks **\n\n");
+
+  Graph *G = Read_and_AddWords(filename);
+
+  if (_wanted("neighbors", sections, numSections))
+  {
+    printf("\n");
+    BenchNeighborDiscovery(G);
+  }
+
+  if (_wanted("lookup", sections, numSections))
+  {
+    printf("\n");
+    BenchLookup(G);
+  }
+
+  if (_wanted("index", sections, numSections))
+  {
+    printf("\n");
+    BenchIndex(G);
+  }
+
+  if (_wanted("pattern", sections, numSections))
+  {
+    printf("\n");
+    BenchPattern(G);
+  }
+
+  if (_wanted("suggest", sections, numSections))
+  {
+    printf("\n");
+    BenchSuggest(G);
+  }
+
+  //
+  // the remaining sections need the edges:
+  //
+  timer_start();
+  AddEdges(G);
+  timer_stop();
+
+  double edgesTime = 1000.0 * timer_value();
+
+  if (_wanted("relabel", sections, numSections))
+  {
+    printf("\n");
+    BenchRelabel(G);
+  }
+
+  if (_wanted("compress", sections, numSections))
+  {
+    printf("\n");
+    BenchCompress(G);
+  }
+
+  if (_wanted("hyper", sections, numSections))
+  {
+    printf("\n");
+    BenchHypergraph(G);
+  }
+
+  if (_wanted("implicit", sections, numSections))
+  {
+    printf("\n");
+    BenchImplicit(G, edgesTime);
+  }
+
+  if (_wanted("weighted", sections, numSections))
+  {
+    printf("\n");
+    BenchWeighted(G);
+  }
+
+  if (_wanted("kpaths", sections, numSections))
+  {
+    printf("\n");
+    BenchKPaths(G);
+  }
+
+  if (_wanted("dag", sections, numSections))
+  {
+    printf("\n");
+    BenchDAG(G);
+  }
+
+  if (_wanted("waypoints", sections, numSections))
+  {
+    printf("\n");
+    BenchWaypoints(G);
+  }
+
+  if (_wanted("filter", sections, numSections))
+  {
+    printf("\n");
+    BenchFilter(G);
+  }
+
+  if (_wanted("closest", sections, numSections))
+  {
+    printf("\n");
+    BenchClosest(G);
+  }
+
+  if (_wanted("tree", sections, numSections))
+  {
+    printf("\n");
+    BenchTree(G);
+  }
+
+  if (_wanted("cache", sections, numSections))
+  {
+    printf("\n");
+    BenchCache(G);
+  }
+
+  if (_wanted("budget", sections, numSections))
+  {
+    printf("\n");
+    BenchBudget(G);
+  }
+
+  if (_wanted("parallel", sections, numSections))
+  {
+    printf("\n");
+    BenchParallel(G);
+  }
+
+  if (_wanted("edits", sections, numSections))  // (last, adds edges)
+  {
+    printf("\n");
+    BenchEditEdges(G);
+  }
+
+  //
+  // done:
+  //
+  DeleteGraph(G);
+
+  printf("\n** Done **\n");
+  mymem_stats();
+
+  printf("\n");
+
+  return 0;
+}
@@ -0,0 +1,288 @@
+/*bloom.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+#define _POSIX_C_SOURCE 200809L  // for clock_gettime
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "bloom.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Blocked Bloom filter:
+//
+// Most candidate words probed while adding edges are not words, and
+// for names that don't pack each miss costs a full descent of the
+// name index.  The filter answers "certainly not a word" for most of
+// them first.  It is blocked: an item's bits all fall in one
+// 64-byte block, chosen by the high half of its hash, so a lookup
+// touches a single cache line.  It only holds the names that don't
+// pack, and is only checked before their index (see Name2Vertex):
+// a packed key is found by one probe of the key table, which a
+// filter check in front of it only slows down.
+//
+
+//
+// BloomHashKey:
+//
+// Returns a 64-bit hash of the key (the splitmix64 finalizer, so
+// unrelated to HashKey's choice of key table slot).
+//
+unsigned long long BloomHashKey(WordKey key)
+{
+  unsigned long long h = key;
+
+  h ^= h >> 30;
+  h *= 0xBF58476D1CE4E5B9ULL;
+  h ^= h >> 27;
+  h *= 0x94D049BB133111EBULL;
+  h ^= h >> 31;
+
+  return h;
+}
+
+//
+// BloomHashName:
+//
+// Returns a 64-bit hash of the name (FNV-1a, then mixed), for names
+// that don't pack.
+//
+unsigned long long BloomHashName(char *name)
+{
+  unsigned long long h = 14695981039346656037ULL;
+
+  for (; *name != '\0'; ++name)
+  {
+    h ^= (unsigned char)*name;
+    h *= 1099511628211ULL;
+  }
+
+  return BloomHashKey(h);
+}
+
+//
+// BloomBlock:
+//
+// Returns the block holding the bits of the item with hash h, for
+// callers that prefetch it before BloomBlockContains.
+//
+unsigned long long *BloomBlock(BloomFilter *F, unsigned long long h)
+{
+  return &F->Blocks[(((h >> 32) * (unsigned long long)F->NumBlocks) >> 32) * BLOOM_BLOCKWORDS];
+}
+
+//
+// BloomBlockContains:
+//
+// Returns false (0) if the item with hash h, whose block is given,
+// was certainly not added, true (non-zero) if it may have been.
+//
+int BloomBlockContains(BloomFilter *F, unsigned long long *block, unsigned long long h)
+{
+  unsigned int h1 = (unsigned int)h;
+  unsigned int h2 = (unsigned int)(h >> 16) | 1;
+  int          i;
+
+  for (i = 0; i < F->NumHashes; ++i)
+  {
+    unsigned int bit = (h1 + i * h2) & (64 * BLOOM_BLOCKWORDS - 1);
+
+    if ((block[bit >> 6] & (1ULL << (bit & 63))) == 0)
+      return 0;
+  }
+
+  return 1;
+}
+
+//
+// BloomAdd:
+//
+void BloomAdd(BloomFilter *F, unsigned long long h)
+{
+  unsigned long long *block = BloomBlock(F, h);
+  unsigned int        h1 = (unsigned int)h;
+  unsigned int        h2 = (unsigned int)(h >> 16) | 1;
+  int                 i;
+
+  for (i = 0; i < F->NumHashes; ++i)
+  {
+    unsigned int bit = (h1 + i * h2) & (64 * BLOOM_BLOCKWORDS - 1);
+
+    block[bit >> 6] |= 1ULL << (bit & 63);
+  }
+}
+
+//
+// BloomMayContain:
+//
+// Returns false (0) if the item with hash h was certainly not
+// added, true (non-zero) if it may have been.
+//
+int BloomMayContain(BloomFilter *F, unsigned long long h)
+{
+  return BloomBlockContains(F, BloomBlock(F, h), h);
+}
+
+//
+// _measureFalsePositives:
+//
+// Probes the filter with the one-letter changes of a sample of the
+// names that don't pack that are not words, returning the fraction
+// that the filter lets through.
+//
+static double _measureFalsePositives(Graph *G, BloomFilter *F)
+{
+  long long tried = 0, passed = 0;
+  int       step = (int)(F->NumItems / 4096) + 1;
+  int       seen = 0;
+  char      name[256];
+  Vertex    v;
+  int       i;
+  char      c;
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    if (G->Keys[v] != WORDKEY_NONE || strlen(G->Names[v]) >= sizeof(name))
+      continue;
+    if (seen++ % step != 0)
+      continue;
+
+    strcpy(name, G->Names[v]);
+
+    for (i = 0; name[i] != '\0'; ++i)
+    {
+      char letter = name[i];
+
+      for (c = 'a'; c <= 'z'; ++c)
+      {
+        if (Variant2Vertex(G, G->Names[v], i, c) >= 0)  // a word, so not a negative:
+          continue;
+
+        name[i] = c;
+        tried++;
+        passed += BloomMayContain(F, BloomHashName(name));
+      }
+
+      name[i] = letter;
+    }
+  }
+
+  return (tried > 0) ? (double)passed / tried : 0.0;
+}
+
+//
+// _now:
+//
+// Returns the monotonic wall-clock time, in ms.
+//
+static double _now(void)
+{
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+
+  return 1000.0 * t.tv_sec + t.tv_nsec / 1000000.0;
+}
+
+//
+// BuildFilter:
+//
+// Builds G->Filter over the names in G that don't pack into a key,
+// with about bitsPerWord bits per name, after which Name2Vertex
+// checks it before looking such a name up in the index.  Also
+// measures the filter's false positive rate and build time, which
+// PrintGraph reports.
+//
+void BuildFilter(Graph *G, int bitsPerWord)
+{
+  double    start = _now();
+  long long numNames = 0;
+  Vertex    v;
+
+  if (G->Filter != NULL)
+  {
+    DeleteBloomFilter(G->Filter);
+    G->Filter = NULL;
+  }
+
+  if (bitsPerWord < 1)
+    bitsPerWord = 1;
+
+  BloomFilter *F = (BloomFilter *)mymalloc(sizeof(BloomFilter));
+  if (F == NULL)
+  {
+    printf("\n**Error in BuildFilter: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    if (G->Keys[v] == WORDKEY_NONE)
+      numNames++;
+  }
+
+  long long bits = numNames * bitsPerWord;
+
+  F->NumBlocks = (int)(bits / (64 * BLOOM_BLOCKWORDS)) + 1;
+  F->NumHashes = (bitsPerWord * 69 + 50) / 100;  // ~ln 2 x bits per item
+  if (F->NumHashes < 1)
+    F->NumHashes = 1;
+  if (F->NumHashes > 16)
+    F->NumHashes = 16;
+  F->NumItems = numNames;
+
+  //
+  // one extra block so the blocks can start on a cache line:
+  //
+  size_t blockBytes = BLOOM_BLOCKWORDS * sizeof(unsigned long long);
+
+  F->Memory = mymalloc((F->NumBlocks + 1) * blockBytes);
+  if (F->Memory == NULL)
+  {
+    printf("\n**Error in BuildFilter: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  F->Blocks = (unsigned long long *)(((size_t)F->Memory + blockBytes - 1) & ~(blockBytes - 1));
+  memset(F->Blocks, 0, F->NumBlocks * blockBytes);
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    if (G->Keys[v] == WORDKEY_NONE)
+      BloomAdd(F, BloomHashName(G->Names[v]));
+  }
+
+  F->BuildTime = _now() - start;
+
+  // (Variant2Vertex never checks the filter, so is exact)
+  F->FalsePositiveRate = _measureFalsePositives(G, F);
+
+  G->Filter = F;
+}
+
+//
+// DeleteBloomFilter:
+//
+void DeleteBloomFilter(BloomFilter *F)
+{
+  myfree(F->Memory);
+  myfree(F);
+}
+
+//
+// BloomBytes:
+//
+// Returns the # of bytes used by the filter's blocks.
+//
+long long BloomBytes(BloomFilter *F)
+{
+  return (long long)F->NumBlocks * BLOOM_BLOCKWORDS * sizeof(unsigned long long);
+}
@@ -0,0 +1,31 @@
+/*bloom.h*/
+
+//
+// Blocked Bloom filter over the names that don't pack into a key:
+//
+// NOTE: include "graph.h" before this file.
+//
+#define BLOOM_BLOCKWORDS  8  // 64-bit words per block (one cache line)
+
+typedef struct BloomFilter
+{
+  unsigned long long *Blocks;       // NumBlocks x BLOOM_BLOCKWORDS, aligned
+  void               *Memory;       // as allocated
+  int                 NumBlocks;
+  int                 NumHashes;    // bits set per item
+  long long           NumItems;
+  double              FalsePositiveRate;  // measured, see BuildFilter
+  double              BuildTime;          // in ms
+} BloomFilter;
+
+void   BuildFilter(Graph *G, int bitsPerWord);
+void   DeleteBloomFilter(BloomFilter *F);
+long long BloomBytes(BloomFilter *F);
+
+unsigned long long BloomHashKey(WordKey key);
+unsigned long long BloomHashName(char *name);
+void   BloomAdd(BloomFilter *F, unsigned long long h);
+int    BloomMayContain(BloomFilter *F, unsigned long long h);
+
+unsigned long long *BloomBlock(BloomFilter *F, unsigned long long h);
+int    BloomBlockContains(BloomFilter *F, unsigned long long *block, unsigned long long h);
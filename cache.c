@@ -0,0 +1,458 @@
+/*cache.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "search.h"
+#include "sstree.h"
+#include "cache.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Ladder cache:
+//
+// Queries are skewed: a few start words and pairs come up again and
+// again.  So CachedShortestPath answers from two levels of cached
+// results before searching:
+//
+//   1. the path for (src, dest), if asked before;
+//   2. else the shortest-path tree from src (see sstree.c), if any,
+//      from which the path is read off in O(length);
+//   3. else the tree from src is searched and cached, and the path
+//      read off it.
+//
+// A tree costs one whole search, about what a Dijkstra from src to
+// a far dest costs, and then answers every later query from src.
+//
+// Both kinds of entries are kept in one hash table, by (src, dest)
+// with dest -1 for trees, and in one LRU list; when the bytes they
+// hold exceed the budget, the least recently used are evicted.
+//
+// The cache may be shared by threads: one mutex guards it, and is
+// held for lookups, inserts and reading a path off a tree (all
+// cheap), but not while searching, so searches from different
+// threads run in parallel, each in a workspace of its own taken
+// from the cache's spares (so no search pays to create one).  Paths
+// are returned as copies, so an entry can be evicted at any time.
+//
+// NOTE: the entries describe the graph when they were found; the
+// cache must be emptied (deleted) if the graph changes.
+//
+
+//
+// CreateLadderCache:
+//
+// Returns an empty cache that holds at most budget bytes.
+//
+// NOTE: it is the responsibility of the CALLER to free the cache
+// (DeleteLadderCache) when they are done.
+//
+LadderCache *CreateLadderCache(long long budget)
+{
+  LadderCache *C = (LadderCache *)mymalloc(sizeof(LadderCache));
+  if (C == NULL)
+  {
+    printf("\n**Error in CreateLadderCache: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  C->Budget = budget;
+  C->Bytes = 0;
+  C->TableBits = 10;
+  C->Buckets = (CacheEntry **)mymalloc((1 << C->TableBits) * sizeof(CacheEntry *));
+  if (C->Buckets == NULL)
+  {
+    printf("\n**Error in CreateLadderCache: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  memset(C->Buckets, 0, (1 << C->TableBits) * sizeof(CacheEntry *));
+
+  C->NumPaths = 0;
+  C->NumTrees = 0;
+  C->Head = NULL;
+  C->Tail = NULL;
+  C->PathHits = 0;
+  C->TreeHits = 0;
+  C->Misses = 0;
+  C->Evictions = 0;
+  C->NumSpare = 0;
+
+  pthread_mutex_init(&C->Lock, NULL);
+
+  return C;
+}
+
+//
+// _freeEntry:
+//
+static void _freeEntry(CacheEntry *e)
+{
+  if (e->Path != NULL)
+    myfree(e->Path);
+  if (e->Tree != NULL)
+    DeleteSingleSourceTree(e->Tree);
+
+  myfree(e);
+}
+
+//
+// DeleteLadderCache:
+//
+void DeleteLadderCache(LadderCache *C)
+{
+  CacheEntry *e = C->Head;
+
+  while (e != NULL)
+  {
+    CacheEntry *next = e->Next;
+
+    _freeEntry(e);
+    e = next;
+  }
+
+  while (C->NumSpare > 0)
+    DeleteWorkspace(C->Spare[--C->NumSpare]);
+
+  pthread_mutex_destroy(&C->Lock);
+
+  myfree(C->Buckets);
+  myfree(C);
+}
+
+//
+// _bucket:
+//
+static unsigned int _bucket(LadderCache *C, Vertex src, Vertex dest)
+{
+  unsigned long long key = ((unsigned long long)(unsigned int)src << 32) | (unsigned int)dest;
+
+  return (unsigned int)((key * 0x9E3779B97F4A7C15ULL) >> (64 - C->TableBits));
+}
+
+//
+// _unlink:
+//
+// Removes e from the LRU list.
+//
+static void _unlink(LadderCache *C, CacheEntry *e)
+{
+  if (e->Prev != NULL)
+    e->Prev->Next = e->Next;
+  else
+    C->Head = e->Next;
+
+  if (e->Next != NULL)
+    e->Next->Prev = e->Prev;
+  else
+    C->Tail = e->Prev;
+}
+
+//
+// _pushFront:
+//
+// Makes e the most recently used.
+//
+static void _pushFront(LadderCache *C, CacheEntry *e)
+{
+  e->Prev = NULL;
+  e->Next = C->Head;
+
+  if (C->Head != NULL)
+    C->Head->Prev = e;
+  else
+    C->Tail = e;
+
+  C->Head = e;
+}
+
+//
+// _lookup:
+//
+// Returns the entry for (src, dest), made the most recently used,
+// or NULL if there is none.
+//
+static CacheEntry *_lookup(LadderCache *C, Vertex src, Vertex dest)
+{
+  CacheEntry *e = C->Buckets[_bucket(C, src, dest)];
+
+  while (e != NULL && (e->Src != src || e->Dest != dest))
+    e = e->Chain;
+
+  if (e != NULL && e != C->Head)
+  {
+    _unlink(C, e);
+    _pushFront(C, e);
+  }
+
+  return e;
+}
+
+//
+// _remove:
+//
+// Takes e out of the cache and frees it.
+//
+static void _remove(LadderCache *C, CacheEntry *e)
+{
+  CacheEntry **link = &C->Buckets[_bucket(C, e->Src, e->Dest)];
+
+  while (*link != e)
+    link = &(*link)->Chain;
+  *link = e->Chain;
+
+  _unlink(C, e);
+
+  if (e->Dest == -1)
+    C->NumTrees--;
+  else
+    C->NumPaths--;
+
+  C->Bytes -= e->Bytes;
+  _freeEntry(e);
+}
+
+//
+// _grow:
+//
+// Doubles the hash table, once there are 2 entries per bucket.
+//
+static void _grow(LadderCache *C)
+{
+  int          old = 1 << C->TableBits;
+  CacheEntry **buckets = C->Buckets;
+  int          b;
+
+  C->TableBits++;
+  C->Buckets = (CacheEntry **)mymalloc((1 << C->TableBits) * sizeof(CacheEntry *));
+  if (C->Buckets == NULL)
+  {
+    printf("\n**Error in CachedShortestPath: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  memset(C->Buckets, 0, (1 << C->TableBits) * sizeof(CacheEntry *));
+
+  for (b = 0; b < old; ++b)
+  {
+    CacheEntry *e = buckets[b];
+
+    while (e != NULL)
+    {
+      CacheEntry  *next = e->Chain;
+      unsigned int h = _bucket(C, e->Src, e->Dest);
+
+      e->Chain = C->Buckets[h];
+      C->Buckets[h] = e;
+      e = next;
+    }
+  }
+
+  myfree(buckets);
+}
+
+//
+// _insert:
+//
+// Adds an entry for the path or tree (one is NULL) from src to dest
+// (-1 for a tree), as the most recently used, then evicts the least
+// recently used until the cache is within its budget.  Returns the
+// entry, or NULL if it alone exceeds the budget (and was freed).
+//
+static CacheEntry *_insert(LadderCache *C, Vertex src, Vertex dest, Vertex *path,
+                           SingleSourceTree *tree, long long bytes)
+{
+  CacheEntry *e = (CacheEntry *)mymalloc(sizeof(CacheEntry));
+  if (e == NULL)
+  {
+    printf("\n**Error in CachedShortestPath: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  e->Src = src;
+  e->Dest = dest;
+  e->Path = path;
+  e->Tree = tree;
+  e->Bytes = bytes + sizeof(CacheEntry);
+
+  if (e->Bytes > C->Budget)
+  {
+    _freeEntry(e);
+    return NULL;
+  }
+
+  if (C->NumPaths + C->NumTrees >= 2 * (1 << C->TableBits))
+    _grow(C);
+
+  unsigned int h = _bucket(C, src, dest);
+
+  e->Chain = C->Buckets[h];
+  C->Buckets[h] = e;
+  _pushFront(C, e);
+
+  if (dest == -1)
+    C->NumTrees++;
+  else
+    C->NumPaths++;
+
+  C->Bytes += e->Bytes;
+
+  while (C->Bytes > C->Budget)
+  {
+    _remove(C, C->Tail);
+    C->Evictions++;
+  }
+
+  return e;
+}
+
+//
+// _copyPath:
+//
+static Vertex *_copyPath(Vertex *path)
+{
+  int n = 0;
+
+  while (path[n] != -1)
+    n++;
+
+  Vertex *copy = (Vertex *)mymalloc((n + 1) * sizeof(Vertex));
+  if (copy == NULL)
+  {
+    printf("\n**Error in CachedShortestPath: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  memcpy(copy, path, (n + 1) * sizeof(Vertex));
+
+  return copy;
+}
+
+//
+// _pathBytes:
+//
+static long long _pathBytes(Vertex *path)
+{
+  int n = 0;
+
+  while (path[n] != -1)
+    n++;
+
+  return (n + 1) * sizeof(Vertex);
+}
+
+//
+// CachedShortestPath:
+//
+// Returns a least-cost path from src to dest, as Dijkstra() does,
+// from the cache C if it can (see above), else by searching the tree
+// from src and caching it.  Safe to call from several threads with
+// the same cache.
+//
+// NOTE: returns NULL if src or dest are not valid vertex ids.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *CachedShortestPath(Graph *G, LadderCache *C, Vertex src, Vertex dest)
+{
+  CacheEntry *e;
+  Vertex     *path;
+
+  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+  if (dest < 0 || dest >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  pthread_mutex_lock(&C->Lock);
+
+  //
+  // (1) the path, or (2) the tree from src:
+  //
+  if ((e = _lookup(C, src, dest)) != NULL)
+  {
+    C->PathHits++;
+    path = _copyPath(e->Path);
+
+    pthread_mutex_unlock(&C->Lock);
+    return path;
+  }
+
+  if ((e = _lookup(C, src, -1)) != NULL)
+  {
+    C->TreeHits++;
+    path = TreePath(e->Tree, dest);
+
+    _insert(C, src, dest, _copyPath(path), NULL, _pathBytes(path));
+
+    pthread_mutex_unlock(&C->Lock);
+    return path;
+  }
+
+  C->Misses++;
+
+  SearchWorkspace *W = (C->NumSpare > 0) ? C->Spare[--C->NumSpare] : NULL;
+
+  pthread_mutex_unlock(&C->Lock);
+
+  //
+  // (3) search the tree, without holding the lock:
+  //
+  if (W == NULL || W->NumVertices < G->NumVertices)
+  {
+    if (W != NULL)
+      DeleteWorkspace(W);
+    W = CreateWorkspace(G);
+  }
+
+  SingleSourceTree *T = BuildSingleSourceTree(G, W, src);
+
+  path = TreePath(T, dest);
+
+  pthread_mutex_lock(&C->Lock);
+
+  if (C->NumSpare < CACHE_MAXSPARE)
+    C->Spare[C->NumSpare++] = W;
+  else
+    DeleteWorkspace(W);
+
+  if (_lookup(C, src, -1) != NULL)  // another thread cached it meanwhile:
+    DeleteSingleSourceTree(T);
+  else
+    _insert(C, src, -1, NULL, T, T->Bytes);
+
+  if (_lookup(C, src, dest) == NULL)
+    _insert(C, src, dest, _copyPath(path), NULL, _pathBytes(path));
+
+  pthread_mutex_unlock(&C->Lock);
+
+  return path;
+}
+
+//
+// PrintCacheStats:
+//
+void PrintCacheStats(LadderCache *C)
+{
+  long long queries;
+
+  pthread_mutex_lock(&C->Lock);
+
+  queries = C->PathHits + C->TreeHits + C->Misses;
+
+  printf(">>Cache: %lld queries, %lld path hits, %lld tree hits, %lld misses (%.1f%% hits)\n",
+    queries, C->PathHits, C->TreeHits, C->Misses,
+    (queries > 0) ? 100.0 * (C->PathHits + C->TreeHits) / queries : 0.0);
+  printf("  %d paths, %d trees, %lld of %lld bytes, %lld evictions\n",
+    C->NumPaths, C->NumTrees, C->Bytes, C->Budget, C->Evictions);
+
+  pthread_mutex_unlock(&C->Lock);
+}
@@ -0,0 +1,48 @@
+/*cache.h*/
+
+//
+// Cache of ladders and shortest-path trees:
+//
+// NOTE: include "graph.h", "search.h" and "sstree.h" before this
+// file.
+//
+#include <pthread.h>
+
+#define CACHE_MAXSPARE  16  // workspaces kept for searches on misses
+
+typedef struct CacheEntry
+{
+  Vertex             Src;
+  Vertex             Dest;       // -1 => a tree, else a path
+  Vertex            *Path;       // path: src, ..., dest, -1
+  SingleSourceTree  *Tree;       // tree: from Src
+  long long          Bytes;
+  struct CacheEntry *Prev;       // LRU list, most recent first
+  struct CacheEntry *Next;
+  struct CacheEntry *Chain;      // next in the same hash bucket
+} CacheEntry;
+
+typedef struct LadderCache
+{
+  pthread_mutex_t  Lock;         // guards everything below
+  long long        Budget;       // in bytes
+  long long        Bytes;        // in use
+  CacheEntry     **Buckets;      // hash table of the entries, by (Src, Dest)
+  int              TableBits;    //   (2^TableBits buckets)
+  int              NumPaths;
+  int              NumTrees;
+  CacheEntry      *Head;         // most recently used
+  CacheEntry      *Tail;         // least recently used
+  long long        PathHits;     // (src, dest) found
+  long long        TreeHits;     //   else src's tree found
+  long long        Misses;       //   else neither
+  long long        Evictions;
+  SearchWorkspace *Spare[CACHE_MAXSPARE];  // workspaces not in use
+  int              NumSpare;
+} LadderCache;
+
+LadderCache *CreateLadderCache(long long budget);
+void         DeleteLadderCache(LadderCache *C);
+
+Vertex      *CachedShortestPath(Graph *G, LadderCache *C, Vertex src, Vertex dest);
+void         PrintCacheStats(LadderCache *C);
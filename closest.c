@@ -0,0 +1,428 @@
+/*closest.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "suggest.h"
+#include "search.h"
+#include "closest.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Closest reachable word:
+//
+// If dest can't be reached from src, the next best answer is the
+// ladder from src to the word of src's component closest to dest
+// --- by Hamming distance (for words of dest's length) or by edit
+// distance.  The component index (BuildComponentIndex) labels each
+// word with its connected component, and keeps the words sorted by
+// component, then by length, with their packed keys: a bucket per
+// (component, length).  So a query only reads src's component, and
+// of that:
+//
+//   - Hamming: the one bucket of dest's length, compared key to key
+//     (KeyDistance, a few instructions per word);
+//   - edit: the buckets in order of how far their length is from
+//     dest's --- which is a lower bound on the edit distance, so
+//     once it reaches the best distance found, the rest are skipped,
+//     and each word is checked by an EditDistance bounded by it.
+//
+// Ties go to the word that comes first alphabetically.  Without
+// the index, the component is found by a BFS from src, and all of
+// it is scanned.
+//
+// NOTE: the index describes the edges at the time it is built;
+// build it once the edges are in (RelabelGraph rebuilds it).
+//
+
+static Graph *g_G;  // for _byComponent
+
+//
+// _byComponent:
+//
+// qsort comparison: by component, then length, then vertex #.
+//
+static int _byComponent(const void *a, const void *b)
+{
+  Vertex v = *((Vertex *)a);
+  Vertex w = *((Vertex *)b);
+  int   *C = g_G->Components->Component;
+
+  if (C[v] != C[w])
+    return (C[v] < C[w]) ? -1 : 1;
+
+  int lv = (int)strlen(g_G->Names[v]);
+  int lw = (int)strlen(g_G->Names[w]);
+
+  if (lv != lw)
+    return (lv < lw) ? -1 : 1;
+
+  return (v < w) ? -1 : (v > w);
+}
+
+//
+// BuildComponentIndex:
+//
+// Builds G->Components, the words of G bucketed by connected
+// component and length (see above).
+//
+// NOTE: build once all vertices and edges have been added.
+//
+void BuildComponentIndex(Graph *G)
+{
+  clock_t start = clock();
+  int     N = G->NumVertices;
+  int     i, c;
+  Vertex  v;
+
+  if (G->Components != NULL)
+  {
+    DeleteComponentIndex(G->Components);
+    G->Components = NULL;
+  }
+
+  ComponentIndex *C = (ComponentIndex *)mymalloc(sizeof(ComponentIndex));
+  if (C == NULL)
+  {
+    printf("\n**Error in BuildComponentIndex: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  C->Component = (int *)mymalloc((N + 1) * sizeof(int));
+  C->Words = (Vertex *)mymalloc((N + 1) * sizeof(Vertex));
+  C->Keys = (WordKey *)mymalloc((N + 1) * sizeof(WordKey));
+  if (C->Component == NULL || C->Words == NULL || C->Keys == NULL)
+  {
+    printf("\n**Error in BuildComponentIndex: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  //
+  // (1) label the components, by a BFS from each word not yet
+  // labeled (Words[] serves as the queue):
+  //
+  for (v = 0; v < N; ++v)
+    C->Component[v] = -1;
+
+  C->NumComponents = 0;
+
+  for (v = 0; v < N; ++v)
+  {
+    int head = 0, tail = 0;
+
+    if (C->Component[v] >= 0)
+      continue;
+
+    c = C->NumComponents++;
+
+    C->Component[v] = c;
+    C->Words[tail++] = v;
+
+    while (head < tail)
+    {
+      NeighborIter it;
+      Vertex       u = C->Words[head++], w;
+
+      BeginNeighbors(G, u, &it);
+      while ((w = NextNeighbor(&it, NULL)) != -1)
+      {
+        if (C->Component[w] < 0)
+        {
+          C->Component[w] = c;
+          C->Words[tail++] = w;
+        }
+      }
+    }
+  }
+
+  //
+  // (2) sort the words by component and length, and mark where
+  // each (component, length) bucket starts:
+  //
+  for (v = 0; v < N; ++v)
+    C->Words[v] = v;
+
+  G->Components = C;  // (for _byComponent)
+  g_G = G;
+  qsort(C->Words, N, sizeof(Vertex), _byComponent);
+
+  C->NumBuckets = 0;
+  for (i = 0; i < N; ++i)
+  {
+    if (i == 0 || C->Component[C->Words[i]] != C->Component[C->Words[i - 1]] ||
+        strlen(G->Names[C->Words[i]]) != strlen(G->Names[C->Words[i - 1]]))
+      C->NumBuckets++;
+  }
+
+  C->Buckets = (ComponentBucket *)mymalloc((C->NumBuckets + 1) * sizeof(ComponentBucket));
+  C->FirstBucket = (int *)mymalloc((C->NumComponents + 1) * sizeof(int));
+  if (C->Buckets == NULL || C->FirstBucket == NULL)
+  {
+    printf("\n**Error in BuildComponentIndex: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  int b = 0;
+
+  for (i = 0; i < N; ++i)
+  {
+    v = C->Words[i];
+    C->Keys[i] = G->Keys[v];
+
+    if (i == 0 || C->Component[v] != C->Component[C->Words[i - 1]])
+      C->FirstBucket[C->Component[v]] = b;
+
+    if (i == 0 || C->Component[v] != C->Component[C->Words[i - 1]] ||
+        strlen(G->Names[v]) != strlen(G->Names[C->Words[i - 1]]))
+    {
+      C->Buckets[b].Length = (int)strlen(G->Names[v]);
+      C->Buckets[b].Start = i;
+      b++;
+    }
+  }
+
+  C->FirstBucket[C->NumComponents] = b;
+  C->Buckets[b].Length = 0;  // (end)
+  C->Buckets[b].Start = N;
+
+  C->Bytes = (long long)(N + 1) * (sizeof(int) + sizeof(Vertex) + sizeof(WordKey)) +
+             (long long)(C->NumBuckets + 1) * sizeof(ComponentBucket) +
+             (long long)(C->NumComponents + 1) * sizeof(int);
+  C->BuildTime = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+}
+
+//
+// DeleteComponentIndex:
+//
+void DeleteComponentIndex(ComponentIndex *C)
+{
+  myfree(C->Component);
+  myfree(C->FirstBucket);
+  myfree(C->Buckets);
+  myfree(C->Words);
+  myfree(C->Keys);
+  myfree(C);
+}
+
+//
+// _hamming:
+//
+// Returns the # of letters at which a and b (of the same length)
+// differ.
+//
+static int _hamming(char *a, char *b)
+{
+  int d = 0;
+
+  for (; *a != '\0'; ++a, ++b)
+  {
+    if (*a != *b)
+      d++;
+  }
+
+  return d;
+}
+
+//
+// _consider:
+//
+// Makes v the best so far if it is closer to the word than *best is,
+// or as close and first alphabetically.
+//
+static void _consider(Graph *G, Vertex v, int d, Vertex *best, int *bestDistance)
+{
+  if (*best < 0 || d < *bestDistance ||
+      (d == *bestDistance && strcmp(G->Names[v], G->Names[*best]) < 0))
+  {
+    *best = v;
+    *bestDistance = d;
+  }
+}
+
+//
+// _scanComponent:
+//
+// ClosestReachable without the index: scans src's component, found
+// by a BFS, or if O is not NULL, the words reachable through those
+// it allows, found by a search with them (see SearchFrom).
+//
+static Vertex _scanComponent(Graph *G, Vertex src, char *word, int metric, SearchOptions *O,
+                             int *distance)
+{
+  Vertex *V;
+  Vertex  best = -1;
+  int     bestDistance = -1;
+  int     len = (int)strlen(word);
+  int     i, n;
+
+  if (O == NULL)
+    V = BFS(G, src);
+  else
+  {
+    SearchWorkspace *W = CreateWorkspace(G);
+
+    W->Options = O;
+    SearchFrom(G, W, src, -1);  // (if it runs out of budget, what it settled)
+
+    V = (Vertex *)mymalloc((W->Settled + 1) * sizeof(Vertex));
+    if (V == NULL)
+    {
+      printf("\n**Error in ClosestReachable: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    for (n = 0; n < W->Settled; ++n)
+      V[n] = W->Order[n];
+    V[n] = -1;
+
+    DeleteWorkspace(W);
+  }
+
+  for (i = 0; V[i] != -1; ++i)
+  {
+    char *name = G->Names[V[i]];
+
+    if (metric == CLOSEST_HAMMING)
+    {
+      if ((int)strlen(name) == len)
+        _consider(G, V[i], _hamming(name, word), &best, &bestDistance);
+    }
+    else
+    {
+      int max = (best < 0) ? len + (int)strlen(name) : bestDistance;
+      int d = EditDistance(name, word, max);
+
+      if (d <= max)
+        _consider(G, V[i], d, &best, &bestDistance);
+    }
+  }
+
+  myfree(V);
+
+  *distance = bestDistance;
+  return best;
+}
+
+//
+// ClosestReachable:
+//
+// Returns the word reachable from src (src included) that is
+// closest to the given word by the given metric (CLOSEST_HAMMING or
+// CLOSEST_EDIT), storing the distance via distance; see above.
+// Returns -1 if src is not a valid vertex id, or for the Hamming
+// metric, if no reachable word has the word's length.  If O is not
+// NULL, only the words reachable through those it allows count (and
+// the index is not used, as it ignores O); -1 if it excludes src.
+//
+// NOTE: the ladder to it is then Dijkstra(G, src, <returned word>),
+// or with O, ConstrainedShortestPath(G, src, <returned word>, O).
+//
+Vertex ClosestReachable(Graph *G, Vertex src, char *word, int metric, SearchOptions *O,
+                        int *distance)
+{
+  ComponentIndex *C = G->Components;
+  Vertex          best = -1;
+  int             bestDistance = -1;
+  int             len = (int)strlen(word);
+  int             first, last, b, i;
+
+  *distance = -1;
+
+  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
+    return -1;
+
+  if (C == NULL || O != NULL)
+    return _scanComponent(G, src, word, metric, O, distance);
+
+  first = C->FirstBucket[C->Component[src]];
+  last = C->FirstBucket[C->Component[src] + 1];
+
+  if (metric == CLOSEST_HAMMING)
+  {
+    WordKey key = PackWord(word);
+
+    for (b = first; b < last && C->Buckets[b].Length != len; ++b)
+      ;
+
+    if (b == last)  // no words of that length:
+      return -1;
+
+    for (i = C->Buckets[b].Start; i < C->Buckets[b + 1].Start; ++i)
+    {
+      int d;
+
+      if (key != WORDKEY_NONE && C->Keys[i] != WORDKEY_NONE)
+        d = KeyDistance(C->Keys[i], key);
+      else
+        d = _hamming(G->Names[C->Words[i]], word);
+
+      if (best < 0 || d <= bestDistance)
+        _consider(G, C->Words[i], d, &best, &bestDistance);
+    }
+  }
+  else
+  {
+    //
+    // the buckets by how far their length is from the word's,
+    // until that alone is more than the best distance:
+    //
+    int minLength = C->Buckets[first].Length;
+    int maxLength = C->Buckets[last - 1].Length;
+    int delta, side;
+
+    for (delta = 0; (best < 0 || delta <= bestDistance) &&
+                    (len - delta >= minLength || len + delta <= maxLength); ++delta)
+    {
+      for (side = 0; side < 2; ++side)
+      {
+        int length = (side == 0) ? len - delta : len + delta;
+
+        if (side == 1 && delta == 0)
+          continue;
+
+        for (b = first; b < last && C->Buckets[b].Length != length; ++b)
+          ;
+
+        if (b == last)  // no words of that length:
+          continue;
+
+        for (i = C->Buckets[b].Start; i < C->Buckets[b + 1].Start; ++i)
+        {
+          int max = (best < 0) ? len + length : bestDistance;
+          int d = EditDistance(G->Names[C->Words[i]], word, max);
+
+          if (d <= max)
+            _consider(G, C->Words[i], d, &best, &bestDistance);
+        }
+      }
+    }
+  }
+
+  *distance = bestDistance;
+  return best;
+}
+
+//
+// ParseClosestMetric:
+//
+// Returns the CLOSEST_ metric named ("hamming" or "edit"), or 0 if
+// none is.
+//
+int ParseClosestMetric(char *name)
+{
+  if (strcmp(name, "hamming") == 0)
+    return CLOSEST_HAMMING;
+  else if (strcmp(name, "edit") == 0)
+    return CLOSEST_EDIT;
+  else
+    return 0;
+}
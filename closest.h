@@ -0,0 +1,35 @@
+/*closest.h*/
+
+//
+// Closest reachable word, for queries with no ladder:
+//
+// NOTE: include "graph.h" and "search.h" before this file.
+//
+#define CLOSEST_HAMMING  1  // metrics: # of letters that differ,
+#define CLOSEST_EDIT     2  //   # of letter edits (see EditDistance)
+
+typedef struct ComponentBucket  // the words of one length in one component:
+{
+  int      Length;
+  int      Start;       // Words[Start..next bucket's Start-1]
+} ComponentBucket;
+
+typedef struct ComponentIndex
+{
+  int              NumComponents;
+  int             *Component;     // Component[v]: v's component #
+  int             *FirstBucket;   // component c: Buckets[FirstBucket[c]..FirstBucket[c+1]-1],
+  ComponentBucket *Buckets;       //   by ascending length
+  int              NumBuckets;
+  Vertex          *Words;         // by component, then length
+  WordKey         *Keys;          // Keys[i] is the packed key of Words[i]
+  long long        Bytes;
+  double           BuildTime;     // in ms
+} ComponentIndex;
+
+void    BuildComponentIndex(Graph *G);
+void    DeleteComponentIndex(ComponentIndex *C);
+
+Vertex  ClosestReachable(Graph *G, Vertex src, char *word, int metric, SearchOptions *O,
+                         int *distance);
+int     ParseClosestMetric(char *name);
@@ -0,0 +1,406 @@
+/*compress.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <limits.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "compress.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Compressed adjacency:
+//
+// Each vertex's neighbors are stored, sorted, as a byte stream:
+//
+//   varint(degree), zigzag-varint(first dest - v),
+//   varint(dest - previous dest), ...
+//
+// where a varint is 7 bits per byte, low bits first, high bit set
+// on all bytes but the last.  Neighboring words are mostly close
+// together (especially after relabeling), so most gaps take 1
+// byte.  If any edge weight is not 1, a varint(weight) follows
+// each dest.
+//
+// Instead of an offset per vertex, there is one per block of
+// COMPRESS_BLOCK vertices.  A block starts with a bitmask of its
+// vertices that have any neighbors, and only their lists follow:
+// most words have no ladder neighbors at all, and a degree byte
+// each for them would cost more than all the gaps of the others.
+// To find a list, the lists before it in its block are skipped by
+// counting varint end bytes.
+//
+
+//
+// _putVarint:
+//
+static unsigned char *_putVarint(unsigned char *p, unsigned int value)
+{
+  while (value >= 0x80)
+  {
+    *p++ = (unsigned char)(value | 0x80);
+    value >>= 7;
+  }
+
+  *p++ = (unsigned char)value;
+
+  return p;
+}
+
+//
+// _getVarint:
+//
+static unsigned char *_getVarint(unsigned char *p, unsigned int *value)
+{
+  unsigned int result = *p & 0x7F;
+  int          shift = 7;
+
+  while (*p++ & 0x80)
+  {
+    result |= (unsigned int)(*p & 0x7F) << shift;
+    shift += 7;
+  }
+
+  *value = result;
+
+  return p;
+}
+
+static unsigned int _zigzag(int value)
+{
+  return (value >= 0) ? 2u * (unsigned int)value : 2u * (unsigned int)(-(value + 1)) + 1;
+}
+
+static int _unzigzag(unsigned int value)
+{
+  return (value & 1) ? -(int)(value >> 1) - 1 : (int)(value >> 1);
+}
+
+//
+// _varintLength:
+//
+// Returns the # of bytes _putVarint writes for the value.
+//
+static size_t _varintLength(unsigned int value)
+{
+  size_t n = 1;
+
+  while (value >= 0x80)
+  {
+    value >>= 7;
+    n++;
+  }
+
+  return n;
+}
+
+//
+// _listLength:
+//
+// Returns the # of bytes v's encoded list takes (with a weight
+// after each dest if weighted), 0 if it has no neighbors.
+//
+static size_t _listLength(Graph *G, Vertex v, int weighted)
+{
+  Edge  *cur;
+  Vertex prev = v;
+  size_t n = 0;
+  int    degree = 0;
+
+  for (cur = G->Vertices[v]; cur != NULL; cur = cur->next)
+  {
+    if (degree == 0)
+      n += _varintLength(_zigzag(cur->dest - v));
+    else
+      n += _varintLength((unsigned int)(cur->dest - prev));
+
+    if (weighted)
+      n += _varintLength((unsigned int)cur->weight);
+
+    prev = cur->dest;
+    degree++;
+  }
+
+  return (degree > 0) ? n + _varintLength((unsigned int)degree) : 0;
+}
+
+//
+// CompressGraph:
+//
+// Encodes G's adjacency lists into a CompressedAdj, which from now
+// on is what the neighbor iterator (and so every traversal) reads.
+// If freeLists is true, the Edge lists are then freed, leaving the
+// compressed lists as the only copy; no edges can be added after
+// that.  Compressing again replaces the previous encoding, unless
+// the lists it was made from were freed: then there is nothing to
+// encode, and it is kept.
+//
+// NOTE: relabel (if desired) before compressing.
+//
+void CompressGraph(Graph *G, int freeLists)
+{
+  int    N = G->NumVertices;
+  size_t size = 0;
+  int    weighted = 0;  /*false*/
+  Vertex v;
+
+  if (G->Compressed != NULL)
+  {
+    if (G->Compressed->ListsFreed)  // nothing to encode:
+      return;
+
+    DeleteCompressedAdj(G->Compressed);
+    G->Compressed = NULL;
+  }
+
+  //
+  // size the encoding exactly; the block offsets (and mymalloc)
+  // are 32-bit, so it must stay below 4 GB:
+  //
+  for (v = 0; v < N && !weighted; ++v)
+  {
+    Edge *cur;
+
+    for (cur = G->Vertices[v]; cur != NULL; cur = cur->next)
+    {
+      if (cur->weight != 1)
+        weighted = 1;  /*true*/
+    }
+  }
+
+  for (v = 0; v < N; ++v)
+  {
+    if (v % COMPRESS_BLOCK == 0)
+      size += COMPRESS_MASKBYTES;
+
+    size += _listLength(G, v, weighted);
+
+    if (size >= UINT_MAX)
+    {
+      printf("\n**Error in CompressGraph: the lists need 4 GB or more\n\n");
+      exit(-1);
+    }
+  }
+
+  CompressedAdj *C = (CompressedAdj *)mymalloc(sizeof(CompressedAdj));
+  unsigned char *bytes = (unsigned char *)mymalloc((unsigned int)(size + 1));
+  if (C == NULL || bytes == NULL)
+  {
+    printf("\n**Error in CompressGraph: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  C->BlockOffsets = (unsigned int *)mymalloc((N / COMPRESS_BLOCK + 1) * sizeof(unsigned int));
+  if (C->BlockOffsets == NULL)
+  {
+    printf("\n**Error in CompressGraph: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  //
+  // encode, block after block, list after list:
+  //
+  unsigned char *p = bytes;
+  unsigned char *mask = bytes;
+
+  for (v = 0; v < N; ++v)
+  {
+    int k = v % COMPRESS_BLOCK;
+
+    if (k == 0)
+    {
+      C->BlockOffsets[v / COMPRESS_BLOCK] = (unsigned int)(p - bytes);
+
+      mask = p;
+      memset(mask, 0, COMPRESS_MASKBYTES);
+      p += COMPRESS_MASKBYTES;
+    }
+
+    Edge *cur = G->Vertices[v];
+    int   degree = 0;
+
+    while (cur != NULL)
+    {
+      degree++;
+      cur = cur->next;
+    }
+
+    if (degree == 0)  // (its bit stays clear)
+      continue;
+
+    mask[k >> 3] |= (unsigned char)(1 << (k & 7));
+    p = _putVarint(p, (unsigned int)degree);
+
+    Vertex prev = v;
+    int    first = 1;  /*true*/
+
+    for (cur = G->Vertices[v]; cur != NULL; cur = cur->next)
+    {
+      if (first)
+        p = _putVarint(p, _zigzag(cur->dest - v));
+      else
+        p = _putVarint(p, (unsigned int)(cur->dest - prev));
+
+      if (weighted)
+        p = _putVarint(p, (unsigned int)cur->weight);
+
+      prev = cur->dest;
+      first = 0;  /*false*/
+    }
+  }
+
+  assert((size_t)(p - bytes) == size);
+
+  C->Bytes = bytes;
+  C->NumBytes = (long long)size;
+  C->NumVertices = N;
+  C->Weighted = weighted;
+  C->ListsFreed = freeLists;
+
+  G->Compressed = C;
+
+  //
+  // free the edge lists, if asked:
+  //
+  if (freeLists)
+  {
+    for (v = 0; v < N; ++v)
+    {
+      Edge *cur = G->Vertices[v];
+
+      while (cur != NULL)
+      {
+        Edge *temp = cur;
+        cur = cur->next;
+
+        myfree(temp);
+      }
+
+      G->Vertices[v] = NULL;
+    }
+  }
+}
+
+//
+// DeleteCompressedAdj:
+//
+void DeleteCompressedAdj(CompressedAdj *C)
+{
+  myfree(C->Bytes);
+  myfree(C->BlockOffsets);
+  myfree(C);
+}
+
+//
+// CompressedBytes:
+//
+// Returns the total # of bytes used by the compressed lists,
+// including the block offsets.
+//
+long long CompressedBytes(CompressedAdj *C)
+{
+  return C->NumBytes + (C->NumVertices / COMPRESS_BLOCK + 1) * (long long)sizeof(unsigned int);
+}
+
+//
+// CompressedFirst:
+//
+// Positions the iterator at the start of v's list.
+//
+void CompressedFirst(CompressedAdj *C, Vertex v, NeighborIter *it)
+{
+  unsigned char *p = C->Bytes + C->BlockOffsets[v / COMPRESS_BLOCK];
+  unsigned char *mask = p;
+  unsigned int   degree;
+  int            k = v % COMPRESS_BLOCK;
+  int            skip = 0;
+  int            i;
+
+  it->Last = v;
+  it->First = 1;  /*true*/
+  it->Weighted = C->Weighted;
+
+  if ((mask[k >> 3] & (1 << (k & 7))) == 0)  // no neighbors:
+  {
+    it->Pos = p;
+    it->Remaining = 0;
+    return;
+  }
+
+  for (i = 0; i < k; ++i)  // the lists before v's in its block:
+  {
+    if (mask[i >> 3] & (1 << (i & 7)))
+      skip++;
+  }
+
+  p += COMPRESS_MASKBYTES;
+
+  //
+  // skip them: each is a degree, then degree (or 2 x degree if
+  // weighted) varints:
+  //
+  while (skip > 0)
+  {
+    p = _getVarint(p, &degree);
+
+    unsigned int varints = C->Weighted ? 2 * degree : degree;
+
+    while (varints > 0)
+    {
+      if ((*p++ & 0x80) == 0)  // end of a varint:
+        varints--;
+    }
+
+    skip--;
+  }
+
+  p = _getVarint(p, &degree);
+
+  it->Pos = p;
+  it->Remaining = (int)degree;
+}
+
+//
+// CompressedNext:
+//
+// Decodes and returns the next neighbor, or -1 if there are no
+// more; the edge weight is stored via weight (if not NULL).
+//
+Vertex CompressedNext(NeighborIter *it, int *weight)
+{
+  unsigned int value;
+
+  if (it->Remaining == 0)
+    return -1;
+
+  it->Remaining--;
+
+  it->Pos = _getVarint(it->Pos, &value);
+
+  if (it->First)
+  {
+    it->Last += _unzigzag(value);
+    it->First = 0;  /*false*/
+  }
+  else
+    it->Last += (int)value;
+
+  if (it->Weighted)
+  {
+    it->Pos = _getVarint(it->Pos, &value);
+
+    if (weight != NULL)
+      *weight = (int)value;
+  }
+  else if (weight != NULL)
+    *weight = 1;
+
+  return it->Last;
+}
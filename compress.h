@@ -0,0 +1,26 @@
+/*compress.h*/
+
+//
+// Compressed (delta + varint) adjacency lists:
+//
+// NOTE: include "graph.h" before this file.
+//
+#define COMPRESS_BLOCK      16  // vertices per block offset
+#define COMPRESS_MASKBYTES  ((COMPRESS_BLOCK + 7) / 8)  // per block: which have lists
+
+typedef struct CompressedAdj
+{
+  unsigned char *Bytes;         // encoded lists, vertex after vertex
+  unsigned int  *BlockOffsets;  // offset of vertex COMPRESS_BLOCK*b's list
+  long long      NumBytes;
+  int            NumVertices;
+  int            Weighted;      // true => a weight follows each dest
+  int            ListsFreed;    // true => the Edge lists are gone, this is the only copy
+} CompressedAdj;
+
+void CompressGraph(Graph *G, int freeLists);
+void DeleteCompressedAdj(CompressedAdj *C);
+long long CompressedBytes(CompressedAdj *C);
+
+void   CompressedFirst(CompressedAdj *C, Vertex v, NeighborIter *it);
+Vertex CompressedNext(NeighborIter *it, int *weight);
@@ -0,0 +1,259 @@
+/*cost.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "cost.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Cost models:
+//
+// By default every step of a ladder costs 1.  A cost model instead
+// gives each step (v, w) a small integer cost >= 1, from the names
+// of v and w: G->Cost(G, v, w, G->CostCtx).  Edges stored in lists
+// carry their cost as their weight, so it is computed once, while
+// hypergraph and implicit neighbors get theirs from NextNeighbor.
+// G->MaxWeight bounds the costs, which lets Dijkstra use a bucket
+// queue (see search.c).  The built-in models are
+//
+//   COST_UNIT:      every step costs 1;
+//   COST_POSITION:  changing (inserting, deleting) the first letter
+//                   costs COST_MAXPOSITION, the second one less, and
+//                   so on down to 1, so ladders keep the front of
+//                   the word;
+//   COST_RARITY:    a step costs 1 + log2(f / n), rounded down and at
+//                   most COST_MAXRARITY, where n is how often the
+//                   letter it puts in (or, deleting, takes out)
+//                   occurs in the dictionary, and f how often the
+//                   commonest letter does.
+//
+// Other models plug in with SetCostFunction.
+//
+
+//
+// _changedPosition:
+//
+// Returns the first position at which the names of v and w differ:
+// the letter changed, or inserted or deleted.
+//
+static int _changedPosition(char *a, char *b)
+{
+  int p = 0;
+
+  while (a[p] == b[p] && a[p] != '\0')
+    p++;
+
+  return p;
+}
+
+static int _positionCost(Graph *G, Vertex v, Vertex w, void *context)
+{
+  int p = _changedPosition(G->Names[v], G->Names[w]);
+
+  (void)context;  // (no state)
+
+  return (p < COST_MAXPOSITION - 1) ? COST_MAXPOSITION - p : 1;
+}
+
+static int _rarityCost(Graph *G, Vertex v, Vertex w, void *context)
+{
+  CostModel *M = (CostModel *)context;
+  char      *a = G->Names[v];
+  char      *b = G->Names[w];
+  int        p = _changedPosition(a, b);
+
+  if (strlen(b) < strlen(a))  // deleted from a:
+    return M->Letter[(unsigned char)a[p]];
+
+  return M->Letter[(unsigned char)b[p]];
+}
+
+//
+// SetCostFunction:
+//
+// Makes cost(G, v, w, context) the cost of each step (v, w) from now
+// on, with costs at most maxCost, and re-weights the edges already
+// in the adjacency lists; a NULL cost makes every step cost 1.  The
+// context is the caller's, except for the built-in models' (see
+// UseCostModel), which are freed here when replaced.
+//
+// NOTE: the lists of a compressed graph are read-only, so set the
+// costs before compressing it (CompressGraph).
+//
+void SetCostFunction(Graph *G, CostFunction cost, void *context, int maxCost)
+{
+  Vertex v;
+
+  if (G->Compressed != NULL)
+  {
+    printf("\n**Error in SetCostFunction: graph is compressed\n\n");
+
+    if (cost == _positionCost || cost == _rarityCost)  // (from UseCostModel)
+      myfree(context);
+    return;
+  }
+
+  DeleteCostModel(G);
+
+  G->Cost = cost;
+  G->CostCtx = context;
+  G->MaxWeight = (cost == NULL || maxCost < 1) ? 1 : maxCost;
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    Edge *cur;
+
+    for (cur = G->Vertices[v]; cur != NULL; cur = cur->next)
+      cur->weight = EdgeCost(G, v, cur->dest);
+  }
+}
+
+//
+// UseCostModel:
+//
+// Makes the given COST_ model (see above) the cost of each step,
+// as SetCostFunction does.
+//
+void UseCostModel(Graph *G, int model)
+{
+  if (model == COST_UNIT)
+  {
+    SetCostFunction(G, NULL, NULL, 1);
+    return;
+  }
+
+  CostModel *M = (CostModel *)mymalloc(sizeof(CostModel));
+  if (M == NULL)
+  {
+    printf("\n**Error in UseCostModel: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  M->Model = model;
+
+  if (model == COST_POSITION)
+  {
+    SetCostFunction(G, _positionCost, M, COST_MAXPOSITION);
+    return;
+  }
+
+  //
+  // rarity: count each char over the dictionary, then quantize:
+  //
+  long long count[256];
+  long long most = 1;
+  Vertex    v;
+  int       c;
+
+  memset(count, 0, sizeof(count));
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    unsigned char *p;
+
+    for (p = (unsigned char *)G->Names[v]; *p != '\0'; ++p)
+      count[*p]++;
+  }
+
+  for (c = 0; c < 256; ++c)
+  {
+    if (count[c] > most)
+      most = count[c];
+  }
+
+  for (c = 0; c < 256; ++c)
+  {
+    int cost = 1;
+
+    while (cost < COST_MAXRARITY && count[c] << cost <= most)  // 1 + floor(log2):
+      cost++;
+
+    M->Letter[c] = cost;
+  }
+
+  SetCostFunction(G, _rarityCost, M, COST_MAXRARITY);
+}
+
+//
+// DeleteCostModel:
+//
+// Frees the context of G's cost model if it is a built-in one, and
+// makes every step cost 1 again (without re-weighting the edges).
+//
+void DeleteCostModel(Graph *G)
+{
+  if (G->Cost == _positionCost || G->Cost == _rarityCost)
+    myfree(G->CostCtx);
+
+  G->Cost = NULL;
+  G->CostCtx = NULL;
+}
+
+//
+// ParseCostModel:
+//
+// Returns the COST_ model named "unit", "position" or "rarity", or
+// 0 if the name is unknown.
+//
+int ParseCostModel(char *name)
+{
+  if (strcmp(name, "unit") == 0)
+    return COST_UNIT;
+  if (strcmp(name, "position") == 0)
+    return COST_POSITION;
+  if (strcmp(name, "rarity") == 0)
+    return COST_RARITY;
+
+  return 0;
+}
+
+//
+// CostModelName:
+//
+// Returns the name of G's cost model, "custom" if it was set with
+// SetCostFunction.
+//
+char *CostModelName(Graph *G)
+{
+  if (G->Cost == NULL)
+    return "unit";
+  if (G->Cost == _positionCost)
+    return "position";
+  if (G->Cost == _rarityCost)
+    return "rarity";
+
+  return "custom";
+}
+
+//
+// EdgeCost:
+//
+// Returns the cost of the step from v to w under G's cost model,
+// clamped to 1..G->MaxWeight: the searches' bucket queue relies on
+// the bound, whatever a custom model returns.
+//
+int EdgeCost(Graph *G, Vertex v, Vertex w)
+{
+  int cost;
+
+  if (G->Cost == NULL)
+    return 1;
+
+  cost = G->Cost(G, v, w, G->CostCtx);
+
+  if (cost < 1)
+    return 1;
+  if (cost > G->MaxWeight)
+    return G->MaxWeight;
+
+  return cost;
+}
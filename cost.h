@@ -0,0 +1,26 @@
+/*cost.h*/
+
+//
+// Step cost models, for weighted ladders:
+//
+// NOTE: include "graph.h" before this file.
+//
+#define COST_UNIT      1  // every step costs 1
+#define COST_POSITION  2  // changes near the front of a word cost more
+#define COST_RARITY    3  // steps to rare letters cost more
+
+#define COST_MAXPOSITION  4  // cost of changing the first letter
+#define COST_MAXRARITY    8  // cost of a step to the rarest letters
+
+typedef struct CostModel  // context of the built-in models:
+{
+  int  Model;          // COST_ model
+  int  Letter[256];    // rarity: cost of a step to each char
+} CostModel;
+
+void   SetCostFunction(Graph *G, CostFunction cost, void *context, int maxCost);
+void   UseCostModel(Graph *G, int model);
+void   DeleteCostModel(Graph *G);
+int    ParseCostModel(char *name);
+char  *CostModelName(Graph *G);
+int    EdgeCost(Graph *G, Vertex v, Vertex w);
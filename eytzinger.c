@@ -0,0 +1,138 @@
+/*eytzinger.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "eytzinger.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Eytzinger layout:
+//
+// A sorted array of n names is stored as an implicit binary search
+// tree in BFS order, 1-based: the root is names[1], and the children
+// of names[k] are names[2k] and names[2k+1].  The first levels of
+// the tree, which every search touches, are thus packed together at
+// the front, and the next node to visit is computed rather than
+// branched to: k = 2k + (names[k] < word).  Once k runs off the
+// bottom, stripping the trailing 1 bits of k (the right turns taken
+// since the last left turn) and one more bit gives the answer.
+// Unlike the AVL tree it replaces, the index is built once, in
+// O(n), from sorted input, and has no per-node pointers.
+//
+
+//
+// CompareVariant:
+//
+// strcmp of word, with position pos changed to c, against other;
+// pos < 0 compares word itself.
+//
+int CompareVariant(char *word, int pos, char c, char *other)
+{
+  int i;
+
+  for (i = 0; ; ++i)
+  {
+    unsigned char c1 = (unsigned char)((i == pos) ? c : word[i]);
+    unsigned char c2 = (unsigned char)other[i];
+
+    if (c1 != c2)
+      return c1 - c2;
+    if (c1 == '\0')
+      return 0;
+  }
+}
+
+//
+// _layout:
+//
+// Fills the subtree rooted at k from sorted[*next...], in order.
+//
+static void _layout(char **sortedNames, Vertex *sortedWords, int n,
+                    char **names, Vertex *words, int k, int *next)
+{
+  if (k > n)
+    return;
+
+  _layout(sortedNames, sortedWords, n, names, words, 2 * k, next);
+
+  names[k] = sortedNames[*next];
+  words[k] = sortedWords[*next];
+  (*next)++;
+
+  _layout(sortedNames, sortedWords, n, names, words, 2 * k + 1, next);
+}
+
+//
+// EytzingerLayout:
+//
+// Given n names in ascending order, with their vertex #s, fills
+// names[1..n] and words[1..n] with the same in Eytzinger order.
+// Runs in O(n); the recursion is only as deep as the tree.
+//
+void EytzingerLayout(char **sortedNames, Vertex *sortedWords, int n,
+                     char **names, Vertex *words)
+{
+  int next = 0;
+
+  _layout(sortedNames, sortedWords, n, names, words, 1, &next);
+}
+
+//
+// EytzingerLowerBound:
+//
+// Returns the index k of the first of names[1..n] that is >= word
+// (with position pos changed to c, see CompareVariant), or 0 if all
+// are smaller.  The descent is branch-free: each step computes the
+// next index from the comparison.
+//
+int EytzingerLowerBound(char **names, int n, char *word, int pos, char c)
+{
+  unsigned int k = 1;
+
+  while (k <= (unsigned int)n)
+  {
+    __builtin_prefetch(names + 16 * k);  // 4 levels down:
+
+    k = 2 * k + (CompareVariant(word, pos, c, names[k]) > 0);
+  }
+
+  k >>= __builtin_ffs(~k);
+
+  return (int)k;
+}
+
+//
+// EytzingerNext:
+//
+// Returns the index of the name that follows names[k] in sorted
+// order, or 0 if names[k] is the last.
+//
+int EytzingerNext(int k, int n)
+{
+  if (2 * k + 1 <= n)  // leftmost of the right subtree:
+  {
+    k = 2 * k + 1;
+
+    while (2 * k <= n)
+      k = 2 * k;
+
+    return k;
+  }
+
+  //
+  // else up past the right turns, then one more:
+  //
+  while (k & 1)
+    k >>= 1;
+
+  return k >> 1;
+}
@@ -0,0 +1,12 @@
+/*eytzinger.h*/
+
+//
+// Static ordered index of names in Eytzinger (BFS) layout:
+//
+// NOTE: include "graph.h" before this file.
+//
+void EytzingerLayout(char **sortedNames, Vertex *sortedWords, int n,
+                     char **names, Vertex *words);
+int  EytzingerLowerBound(char **names, int n, char *word, int pos, char c);
+int  EytzingerNext(int k, int n);
+int  CompareVariant(char *word, int pos, char c, char *other);
@@ -1,1167 +1,1879 @@
-/*graph.c*/
-
-#define _CRT_SECURE_NO_WARNINGS
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <math.h>
-#include <assert.h>
-#include <limits.h>
-
-#include "avl.h"
-#include "stack.h"
-#include "set.h"
-#include "graph.h"
-#include "mymem.h"
-
-
-
-// #####################################################
-//
-// Graph:
-//
-
-//
-// CreateGraph:
-//
-// Creates a directed graph with an initial capacity for N vertices;
-// at this point graph is limited to at most N vertices.  The implementation
-// is based on adjacency lists.
-//
-Graph *CreateGraph(int N)
-{
-  Graph *G;
-  int    i;
-
-  if (N < 1)
-  {
-    printf("\n**Error in CreateGraph: invalid parameter N (%d)\n\n", N);
-    return NULL;
-  }
-
-  //
-  // allocate graph header:
-  //
-  G = (Graph *)mymalloc(sizeof(Graph));
-  if (G == NULL)
-  {
-    printf("\n**Error in CreateGraph: malloc failed to allocate\n\n");
-    exit(-1);
-  }
-
-
-  //allocate array of adjacency lists, one per vertex:
-
-  G->Vertices = (Edge **)mymalloc(N * sizeof(Edge *));
-  if (G->Vertices == NULL)
-  {
-    printf("\n**Error in CreateGraph: malloc failed to allocate\n\n");
-    exit(-1);
-  }
-
-  for (i = 0; i < N; ++i)  // initialize to empty lists:
-    G->Vertices[i] = NULL;
-
-  //
-  // allocate array for storing vertex names:
-  //
-  G->Names = (char **)mymalloc(N * sizeof(char *));
-  if (G->Names == NULL)
-  {
-    printf("\n**Error in CreateGraph: malloc failed to allocate\n\n");
-    exit(-1);
-  }
-
-  for (i = 0; i < N; ++i)  // initialize to empty names:
-    G->Names[i] = NULL;
-
-  //
-  // graph is empty to start --- initialize remaining fields:
-  //
-  G->NumVertices = 0;
-  G->NumEdges = 0;
-  G->Capacity = N;
-  G->NamesTree = NULL;
-
-
-  //done!
-
-  return G;
-}
-
-//
-// DeleteGraph:
-//
-// Frees the memory associated with this graph.
-//
-void DeleteGraph(Graph *G)
-{
-  int  i;
-
-  //
-  // Every vertex has a name, and a list of edges.  Free
-  // that memory:
-  //
-  for (i = 0; i < G->NumVertices; ++i)
-  {
-    // free vertex name:
-    myfree(G->Names[i]);
-
-    // free each edge:
-    Edge *cur, *temp;
-    cur = G->Vertices[i];
-    while (cur != NULL)
-    {
-      temp = cur;
-      cur = cur->next;
-
-      myfree(temp);
-    }
-  }
-  FreeAVLTree(G->NamesTree);
-
-  // free the arrays we just traversed:
-  myfree(G->Vertices);
-  myfree(G->Names);
-
-  // free head node:
-  myfree(G);
-
-   //post-order like FatalError hinted at
-}
-
-
-
-//
-// AddVertex:
-//
-// Adds a vertex with the given name to G, returning a unique integer id
-// identifying this vertex.  Returns -1 if adding the vertex failed, i.e.
-// if the graph is full and additional vertices cannot be created; this
-// occurs when the graph's capacity is reached.
-//
-int AddVertex(Graph *G, char *name)
-{
-  int v = G->NumVertices;  // next free location:
-
-  AVLElementType value;
-  strcpy( value.Word, name);
-  value.Vertex = v;
-
-  G->NamesTree = Insert(G->NamesTree, value);
-
-  if (G->NumVertices == G->Capacity)  // graph is full:
-  {
-    // we need to dynamically grow, so let's double in size:
-    int N = 2 * G->Capacity;
-
-    //
-    // first we'll grow the array of names:
-    //
-    char **newNames = (char **)mymalloc(N * sizeof(char *));
-    if (newNames == NULL)
-    {
-      printf("\n**Error in AddVertex: malloc failed to allocate\n\n");
-      exit(-1);
-    }
-
-    // copy existing names over:
-    int  i;
-
-    for (i = 0; i < G->NumVertices; ++i)
-    {
-      newNames[i] = G->Names[i];
-    }
-
-    myfree(G->Names);
-
-    //
-    // now we need to grow the edge lists:
-    //
-    Edge **newVertices = (Edge **)mymalloc(N * sizeof(Edge *));
-    if (newVertices == NULL)
-    {
-      printf("\n**Error in AddVertex: malloc failed to allocate\n\n");
-      exit(-1);
-    }
-
-    // copy existing edge lists:
-    for (i = 0; i < G->NumVertices; ++i)
-    {
-      newVertices[i] = G->Vertices[i];
-    }
-
-    myfree(G->Vertices);
-
-    //
-    // done, update graph header:
-    //
-    G->Names = newNames;
-    G->Vertices = newVertices;
-    G->Capacity = N;
-  }
-
-  // initialize edge list to empty:
-  G->Vertices[v] = NULL;
-
-  // make a copy of the name:
-  G->Names[v] = (char *)mymalloc(((int)(strlen(name) + 1)) * sizeof(char));
-  if (G->Names[v] == NULL)
-  {
-    printf("\n**Error in AddVertex: malloc failed to allocate\n\n");
-    exit(-1);
-  }
-
-  strcpy(G->Names[v], name);
-
-  // one more vertex now:
-  G->NumVertices++;
-
-  // done!  Return vertex's number:
-  return v;
-}
-
-//
-// Name2Vertex:
-//
-// Looks up a vertex by name, returning its vertex #
-// if found -- this value will be >= 0.  Returns -1 if
-// not found.
-//
-int Name2Vertex(Graph *G, char *Name)
-{
-  // int  i;
-  //
-  // //
-  // // linear search through the Names array:
-  // //
-  // for (i = 0; i < G->NumVertices; ++i)
-  // {
-  //   if (strcmp(G->Names[i], Name) == 0)
-  //     return i;
-  // }
-
-  AVLNode *cur = G->NamesTree;
-
-  while (cur != NULL)
-  {
-    if (strcmp(Name, cur->value.Word) == 0)  // match!
-      return cur->value.Vertex;
-    else if (strcmp(Name, cur->value.Word) < 0)  // smaller, go left:
-      cur = cur->left;
-    else  // larger, go right:
-      cur = cur->right;
-  }
-
-
-  // if get here, not found:
-  return -1;
-}
-
-//
-// Vertex2Name:
-//
-// Looks up a vertex by number, returning a pointer to
-// its name; returns NULL if v is invalid.
-//
-// NOTE: do not change the string via the returned
-// pointer; treat the pointer and the underlying string
-// read-only.
-//
-char *Vertex2Name(Graph *G, Vertex v)
-{
-  if (v < 0 || v >= G->NumVertices)
-    return NULL;
-
-  return G->Names[v];
-}
-
-//
-// AddEdge:
-//
-// Adds a directed edge (src, dest, weight) to G.  If successful, true
-// (non-zero) is returned; if the edge could not be added (i.e. due to
-// invalid vertex ids), then false (0) is returned.
-//
-// NOTE: loops and multi-edges are allowed.  To allow easier handling of
-// multi-edges, edges are stored "in order by destination".  So when
-// inserting a new edge E = (s,d,w), insert this edge in the list such
-// that E's position in the list is ordered by "d".  Example: if the list
-// contains (0,1,100)->(0,2,75), and the new edge is (0,2,150), then the
-// resulting list is (0,1,100)->(0,2,150)->(0,2,75).  The new edge is
-// inserted *before* existing edges with same or larger destination.
-//
-int AddEdge(Graph *G, Vertex src, Vertex dest, int weight)
-{
-  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
-    return 0;
-  if (dest < 0 || dest >= G->NumVertices)  // invalid vertex #:
-    return 0;
-
-  //
-  // allocate memory for new edge:
-  //
-  Edge *edge = (Edge *)mymalloc(sizeof(Edge));
-  if (edge == NULL)
-  {
-    printf("\n**Error in AddEdge: malloc failed to allocate\n\n");
-    exit(-1);
-  }
-
-  //
-  // store data:
-  //
-  edge->src = src;
-  edge->dest = dest;
-  edge->weight = weight;
-
-  //
-  // link into edge list --- we want to insert in order so that we
-  // can detect multi-edges more easily (i.e. they will be consecutive
-  // in the adjacency list):
-  //
-  Edge *prev = NULL;
-  Edge *cur = G->Vertices[src];
-
-  while (cur != NULL)
-  {
-    if (dest <= cur->dest)  // insert here!
-      break;
-
-    // else keep going:
-    prev = cur;
-    cur = cur->next;
-  }
-
-  if (prev == NULL)  // update head pointer:
-  {
-    edge->next = G->Vertices[src];
-    G->Vertices[src] = edge;
-  }
-  else  // insert between prev and cur:
-  {
-    edge->next = prev->next;
-    prev->next = edge;
-  }
-
-  //
-  // done:
-  //
-  G->NumEdges++;
-
-  return 1;  // success!
-}
-
-//
-// Neighbors:
-//
-// Returns the neighbors of a given vertex --- i.e. the vertices
-// adjacent to v.  The neighbors are returned in a dynamically-
-// allocated array, in ascending order; the vertices are followed
-// by -1 to denote the end of the data.  A vertex appears at most
-// once in the returned array, even in the presence of multi-edges.
-//
-// NOTE: returns NULL if v is not a valid vertex id.
-//
-// NOTE: it is the responsibility of the CALLER to free the returned
-// array when they are done.
-//
-Vertex *Neighbors(Graph *G, Vertex v)
-{
-  Vertex *neighbors;
-  int     N;
-  int     i;
-
-  if (v < 0 || v >= G->NumVertices)  // invalid vertex #:
-    return NULL;
-
-  //
-  // allocate array of worst-case size: # of vertices + 1
-  //
-  N = G->NumVertices + 1;
-
-  neighbors = (Vertex *)mymalloc(N * sizeof(Vertex));
-  if (neighbors == NULL)
-  {
-    printf("\n**Error in Neighbors: malloc failed to allocate\n\n");
-    exit(-1);
-  }
-
-  //
-  // Now loop through the list of edges and copy the dest
-  // vertex of each edge:
-  //
-  Edge *cur = G->Vertices[v];
-
-  i = 0;
-  while (cur != NULL)  // for each edge out of v:
-  {
-    //
-    // the dest is our neighbor --- however, we have to be
-    // careful of multi-edges, i.e. edges with the same dest.
-    // Since edges are stored in order, edges with same dest
-    // appear next to each other in the list --- so look to
-    // see if array already contains dest before we copy over:
-    //
-    if (i == 0)  // first neighbor, we always copy:
-    {
-      neighbors[i] = cur->dest;
-      ++i;
-    }
-    else if (neighbors[i - 1] != cur->dest)  // make sure not a multi-edge:
-    {
-      neighbors[i] = cur->dest;
-      ++i;
-    }
-    else // multi-edge, so ignore:
-      ;
-
-    cur = cur->next;
-  }
-
-  //
-  // follow last element with -1 and return:
-  //
-  neighbors[i] = -1;
-
-  return neighbors;
-}
-
-///
-// Prints the graph for debugging purposes.  Pass true
-// (non-zero) for the "complete" parameter to dump complete
-// info --- e.g. BFS and DFS from each vertex --- otherwise
-// pass false (0) for just graph stats.
-//
-void PrintGraph(Graph *G, char *title, int complete)
-{
-  printf(">>Graph: %s\n", title);
-  printf("  # of vertices: %d\n", G->NumVertices);
-  printf("  # of edges:    %d\n", G->NumEdges);
-
-  // is a complete print desired?  if not, return now:
-  if (!complete)
-    return;
-
-  //
-  // Otherwise dump complete graph info:
-  //
-  printf("  Adjacency Lists:\n");
-
-  int  v;
-  for (v = 0; v < G->NumVertices; ++v)
-  {
-    printf("   %d (%s): ", v, G->Names[v]);
-
-    Edge *edge = G->Vertices[v];
-    while (edge != NULL)
-    {
-      printf("(%d,%d,%d)", edge->src, edge->dest, edge->weight);
-
-      edge = edge->next;
-      if (edge != NULL)
-        printf(", ");
-    }
-
-    printf("\n");
-  }
-
-  //
-  // neighbors:
-  //
-  printf("  Neighbors:\n");
-
-  for (v = 0; v < G->NumVertices; ++v)
-  {
-    printf("   %d (%s): ", v, G->Names[v]);
-
-    Vertex *neighbors = Neighbors(G, v);
-
-    if (neighbors == NULL)
-      printf("**ERROR: Neighbors returned NULL.\n\n");
-    else
-    {
-      int  j;
-
-      for (j = 0; neighbors[j] != -1; ++j)
-      {
-        printf("%d, ", neighbors[j]);
-      }
-
-      printf("-1\n");
-
-      myfree(neighbors);
-    }
-  }
-
-  //
-  // BFS:
-  //
-  printf("  BFS:\n");
-
-  for (v = 0; v < G->NumVertices; ++v)
-  {
-    printf("   %d (%s): ", v, G->Names[v]);
-
-    Vertex *visited = BFS(G, v);
-
-    if (visited == NULL)
-      printf("**ERROR: BFS returned NULL.\n\n");
-    else
-    {
-      int  j;
-
-      for (j = 0; visited[j] != -1; ++j)
-      {
-        printf("%d, ", visited[j]);
-      }
-
-      printf("-1\n");
-
-      myfree(visited);
-    }
-  }
-
-  //
-  // DFS:
-  //
-  printf("  DFS:\n");
-
-  for (v = 0; v < G->NumVertices; ++v)
-  {
-    printf("   %d (%s): ", v, G->Names[v]);
-
-    Vertex *visited = DFS(G, v);
-
-    if (visited == NULL)
-      printf("**ERROR: DFS returned NULL.\n\n");
-    else
-    {
-      int  j;
-
-      for (j = 0; visited[j] != -1; ++j)
-      {
-        printf("%d, ", visited[j]);
-      }
-
-      printf("-1\n");
-
-      myfree(visited);
-    }
-  }
-
-}
-
-//
-// BFS:
-//
-// Performs a breadth-first search starting from vertex v,
-// returning a dynamically-allocated array of the vertices
-// visited, in the order they are visited.  Note that v will
-// appear first in the returned array, and the last vertex
-// is followed by -1 to denote the end.  When the neighbors
-// of a vertex are visited, they are done so in ascending
-// order; no vertex is visited more than once, even in the
-// presence of cycles and multi-edges.
-//
-// NOTE: returns NULL if v is not a valid vertex id.
-//
-// NOTE: it is the responsibility of the CALLER to free the
-// returned array when they are done.
-//
-Vertex *BFS(Graph *G, Vertex v)
-{
-  Vertex *visited;
-  int     N;
-  int     i;
-
-  if (v < 0 || v >= G->NumVertices)  // invalid vertex #:
-    return NULL;
-
-  //
-  // allocate array of worst-case size: # of vertices + 1
-  //
-  N = G->NumVertices + 1;
-
-  visited = (Vertex *)mymalloc(N * sizeof(Vertex));
-  if (visited == NULL)
-  {
-    printf("\n**Error in BFS: malloc failed to allocate\n\n");
-    exit(-1);
-  }
-
-  //
-  // Perform BFS, starting at given vertex v:
-  //
-  Queue *frontierQ = CreateQueue(N);
-  Set   *discoveredSet = CreateSet(N);
-
-  if (!Enqueue(frontierQ, v)) { printf("Error!\n"); exit(-1); }
-  if (!AddToSet(discoveredSet, v)) { printf("Error!\n"); exit(-1); }
-
-  i = 0;  // index into visited of where next vertex goes:
-
-  while (!isEmptyQueue(frontierQ))
-  {
-    Vertex currentV = Dequeue(frontierQ);
-
-    // visit:  add to visited list:
-    visited[i] = currentV;
-    ++i;
-
-    Vertex *neighbors = Neighbors(G, currentV);
-
-    int j = 0;  // index into array of neighbors:
-    while (neighbors[j] != -1)
-    {
-      Vertex adjV = neighbors[j];
-
-      if (!isElementInSet(discoveredSet, adjV))
-      {
-        if (!Enqueue(frontierQ, adjV)) { printf("Error!\n"); exit(-1); }
-        if (!AddToSet(discoveredSet, adjV)) { printf("Error!\n"); exit(-1); }
-      }
-
-      ++j;
-    }
-
-    myfree(neighbors);
-  }//while
-
-   //
-   // done:
-   //
-  visited[i] = -1;  // mark end of vertices with -1:
-
-  DeleteQueue(frontierQ);
-  DeleteSet(discoveredSet);
-
-  return visited;
-}
-
-
-//
-// BFSd:
-//
-// Performs a breadth-first search starting from vertex v,
-// returning a dynamically-allocated array of the vertices
-// visited, in the order they are visited.  Unlike BFS(),
-// this function stops after walking "d" steps away from v.
-// A "step" is an edge, which implies that d=2 => visiting
-// all nodes 2 edges away from v.
-//
-// The returned array contains "markers" to denote vertices
-// that are 0 steps away, 1 step away, 2 steps away, etc.
-// Each marker is -1, so given a distance d, the caller should
-// loop through the returned vertex until d+1 markers are
-// processed.  Then stop.  Example: d=2 => 3 markers,
-// after step 0, step 1, and step 2.
-//
-// NOTE: returns NULL if v is not a valid vertex id, or
-// if distance < 1.
-//
-// NOTE: it is the responsibility of the CALLER to free the
-// returned array when they are done.
-//
-Vertex *BFSd(Graph *G, Vertex v, int distance)
-{
-  Vertex *visited;
-  int     N;
-  int     i;
-
-  if (v < 0 || v >= G->NumVertices)  // invalid vertex #:
-    return NULL;
-
-  if (distance < 1)
-    return NULL;
-
-  //
-  // allocate array of worst-case size: # of vertices + distance + 1
-  //
-  N = G->NumVertices + distance + 1;
-
-  visited = (Vertex *)mymalloc(N * sizeof(Vertex));
-  if (visited == NULL)
-  {
-    printf("\n**Error in BFS: malloc failed to allocate\n\n");
-    exit(-1);
-  }
-
-  //
-  // Perform BFS, starting at given vertex v:
-  //
-  Queue *frontierQ = CreateQueue(N);
-  Set   *discoveredSet = CreateSet(N);
-
-  if (!Enqueue(frontierQ, v)) { printf("Error!\n"); exit(-1); }
-  if (!AddToSet(discoveredSet, v)) { printf("Error!\n"); exit(-1); }
-
-  i = 0;  // index into visited of where next vertex goes:
-
-  Enqueue(frontierQ, -1);
-
-  while (!isEmptyQueue(frontierQ))
-  {
-
-    if (frontierQ->Elements[frontierQ->Front] == -1)
-    {
-      visited[i] = -1;
-      ++i;
-
-      distance--;
-      if (distance < 0)
-        break;
-
-      Dequeue(frontierQ);
-      Enqueue(frontierQ, -1);
-
-      continue;  // skip loop body and repeat:
-    }
-
-    Vertex currentV = Dequeue(frontierQ);
-
-    // visit:  add to visited list:
-    visited[i] = currentV;
-    ++i;
-
-    Vertex *neighbors = Neighbors(G, currentV);
-
-    int j = 0;  // index into array of neighbors:
-    while (neighbors[j] != -1)
-    {
-      Vertex adjV = neighbors[j];
-
-      if (!isElementInSet(discoveredSet, adjV))
-      {
-        if (!Enqueue(frontierQ, adjV)) { printf("Error!\n"); exit(-1); }
-        if (!AddToSet(discoveredSet, adjV)) { printf("Error!\n"); exit(-1); }
-      }
-
-      ++j;
-    }
-
-    myfree(neighbors);
-
-  }//while
-
-   //
-   // done:
-   //
-  visited[i] = -1;  // mark end of vertices with -1:
-
-  DeleteQueue(frontierQ);
-  DeleteSet(discoveredSet);
-
-  return visited;
-}
-
-//
-// DFS:
-//
-// Performs a depth-first search starting from vertex v,
-// returning a dynamically-allocated array of the vertices
-// visited, in the order they are visited.  Note that v will
-// appear first in the returned array, and the last vertex
-// is followed by -1 to denote the end; a vertex appears
-// at most once in the visited array.  When the neighbors
-// of a vertex are visited, they are done so in ascending
-// order.
-//
-// NOTE: returns NULL if v is not a valid vertex id.
-//
-// NOTE: it is the responsibility of the CALLER to free the
-// returned array when they are done.
-//
-Vertex *DFS(Graph *G, Vertex v)
-{
-  if (v < 0 || v >= G->NumVertices)  // invalid vertex #:
-    return NULL;
-
-  //
-  // Perform DFS, starting at given vertex v:
-  //
-  int N = G->NumVertices + 1;
-
-  Stack *frontierStack = CreateStack(N);
-  Set   *visitedSet = CreateSet(N);
-  Queue *visitedQ = CreateQueue(N);
-
-  if (!Push(frontierStack, v)) { printf("Error!\n"); exit(-1); }
-
-  while (!isEmptyStack(frontierStack))
-  {
-    Vertex currentV = Pop(frontierStack);
-
-    //
-    // visit:  add to visited list *if* not already there, since
-    // DFS may end up visiting vertices multiple times:
-    //
-    if (!isElementInQueue(visitedQ, currentV))
-    {
-      if (!Enqueue(visitedQ, currentV)) { printf("Error!\n"); exit(-1); }
-    }
-
-    //
-    // now push neighbors in reverse order so that we visit in
-    // ascending order:
-    //
-    if (!isElementInSet(visitedSet, currentV))
-    {
-      if (!AddToSet(visitedSet, currentV)) { printf("Error!\n"); exit(-1); }
-
-      Vertex *neighbors = Neighbors(G, currentV);
-
-      //
-      // Note: push them backwards onto stack so vertices are
-      // on the stack in ascending order:
-      //
-      int j = 0;  // index into array of neighbors:
-
-      while (neighbors[j] != -1)  // find the end
-        j++;
-
-      j--;  // advance to last vertex in the visited array:
-
-      while (j >= 0)  // now push backwards:
-      {
-        Vertex adjV = neighbors[j];
-
-        if (!Push(frontierStack, adjV)) { printf("Error!\n"); exit(-1); }
-
-        --j;
-      }
-
-      myfree(neighbors);
-    }
-  }//while
-
-  //
-  // done: our set of visited vertices is in visitedQ, so let's
-  // copy out of there into a dynamically-allocated array:
-  //
-
-  //
-  // allocate array of worst-case size: # of vertices + 1
-  //
-  Vertex *visited;
-
-  visited = (Vertex *)mymalloc(N * sizeof(Vertex));
-  if (visited == NULL)
-  {
-    printf("\n**Error in DFS: malloc failed to allocate\n\n");
-    exit(-1);
-  }
-
-  // dequeue vertices into the visited array:
-  int i = 0;  // index into visited array:
-
-  while (!isEmptyQueue(visitedQ))
-  {
-    visited[i] = Dequeue(visitedQ);
-    ++i;
-  }
-
-  visited[i] = -1;  // mark end of vertices with -1:
-
-  //
-  // Done:
-  //
-  DeleteStack(frontierStack);
-  DeleteSet(visitedSet);
-  DeleteQueue(visitedQ);
-
-  return visited;
-}
-
-
-//------------------------------------Dijkstra ALGORITHM---------------------------------------------------//
-//
-// getEdgeWeight:
-//
-// Returns the weight along edge src -> dest.  If there are
-// multiple edges, returns the minimum weight; if there is no
-// such edge, an error message is printed and the program is
-// exited.
-//
-// NOTE: the error message and program exit occur since you
-// should never call function unless the edge exists.
-//
-int getEdgeWeight(Graph *G, Vertex src, Vertex dest)
-{
-  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
-  {
-    printf("\n**Error in getEdgeWeight: src vertex (%d) invalid.\n\n", src);
-    exit(-1);
-  }
-  if (dest < 0 || dest >= G->NumVertices)  // invalid vertex #:
-  {
-    printf("\n**Error in getEdgeWeight: dest vertex (%d) invalid.\n\n", dest);
-    exit(-1);
-  }
-
-  //
-  // search src's edge list, note that multi-edges appear together:
-  //
-  Edge *cur = G->Vertices[src];
-  int   weight;
-  int   haveEdge = 0;  /*false*/
-
-  while (cur != NULL)
-  {
-    if (dest == cur->dest)  // candidate edge:
-    {
-      if (!haveEdge) // first edge:
-      {
-        haveEdge = 1;  /*true*/
-        weight = cur->weight;
-      }
-      else if (cur->weight < weight)  // multi-edge:
-      {
-        weight = cur->weight;  // smaller, so update:
-      }
-    }
-    else if (dest < cur->dest)  // out of order, end search:
-      break;
-
-    // next edge:
-    cur = cur->next;
-  }
-
-  //
-  // did we find an edge?  make sure...
-  //
-  if (!haveEdge)
-  {
-    printf("\n**Error in getEdgeWeight: no edge found from %d to %d.\n\n", src, dest);
-    exit(-1);
-  }
-
-  //
-  // success:
-  //
-  return weight;
-}
-
-
-//
-// Performs Dijkstra's shortest path algorithm to find the shortest path
-// from src to dest.  Returns a dynamically-allocated array of vertices
-// denoting this path; the array will start with src, contain 0 or more
-// vertices that lead to dest, followed by dest, and ending with -1.
-// If there is no pat from src to dest, the array will contain only -1.
-//
-// NOTE: returns NULL if src or dest are not valid vertex ids.
-//
-// NOTE: it is the responsibility of the CALLER to free the
-// returned array when they are done.
-//
-int PopMin(Queue *unvisitedQ, int distance[])
-{
-  int    N = unvisitedQ->NumElements;
-  Stack *S = CreateStack(N);
-
-  assert(!isEmptyQueue(unvisitedQ));
-
-  //
-  // search for smallest vertex distance in the queue,
-  // saving other elements in a stack so we can put back
-  // later:
-  //
-  int minV = Dequeue(unvisitedQ);  // assume first vertex is the min:
-
-  while (!isEmptyQueue(unvisitedQ))  // look for smaller vertex:
-  {
-    int v = Dequeue(unvisitedQ);
-
-    if (distance[v] < distance[minV])
-    {
-      Push(S, minV);  // save so we can put back in queue:
-      minV = v;  // our new min:
-    }
-    else  // not smaller, so save to enqueue later:
-    {
-      Push(S, v);
-    }
-  }
-
-  //
-  // empty the stack back into the queue:
-  //
-  while (!isEmptyStack(S))
-  {
-    Enqueue(unvisitedQ, Pop(S));
-  }
-
-  // NOTE: at this point queue is now one smaller, with
-  // min element removed.  Let's confirm:
-  assert(unvisitedQ->NumElements == (N - 1));
-
-  //
-  // done:
-  //
-  DeleteStack(S);
-
-  return minV;
-}
-
-
-Vertex *Dijkstra(Graph *G, Vertex src, Vertex dest)
-{
-  int  INF = INT_MAX;
-
-  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
-    return NULL;
-  if (dest < 0 || dest >= G->NumVertices)  // invalid vertex #:
-    return NULL;
-
-  //
-  // allocate distances array:
-  //
-  int N = G->NumVertices;
-
-  int *distance = (int *)mymalloc(N * sizeof(int));
-  if (distance == NULL)
-  {
-    printf("\n**Error in Dijkstra: malloc failed to allocate\n\n");
-    exit(-1);
-  }
-
-  Vertex *predecessor = (Vertex *)mymalloc(N * sizeof(Vertex));
-  if (predecessor == NULL)
-  {
-    printf("\n**Error in Dijkstra: malloc failed to allocate\n\n");
-    exit(-1);
-  }
-
-  //
-  // for each vertex, add to Queue to be visited,
-  // initialize distance to Infinity, and set predecessor
-  // to -1:
-  //
-  Queue *unvisitedQ = CreateQueue(N);
-  int currentV;
-
-  for (currentV = 0; currentV < N; ++currentV)
-  {
-    Enqueue(unvisitedQ, currentV);
-    distance[currentV] = INF;
-    predecessor[currentV] = -1;
-  }
-
-  //
-  // starting vertex has a distance of 0 from itself:
-  //
-  distance[src] = 0;
-
-  //
-  // Now run Dijkstra's algorithm:
-  //
-  while (!isEmptyQueue(unvisitedQ))
-  {
-    //
-    // find the vertex with the smallest distance from
-    // the start, that's the vertex to explore next:
-    //
-    currentV = PopMin(unvisitedQ, distance);
-
-    // is there a path to the current vertex?  if not,
-    // there's no point in looking at neighbors...
-    if (distance[currentV] == INF)
-      break;
-
-    //
-    // now see if we have found any shorter paths for minV's
-    // neighboring vertices:
-    //
-    Vertex *neighbors = Neighbors(G, currentV);
-
-    int i = 0;
-    while (neighbors[i] != -1)  // for each neighbor:
-    {
-      int adjV = neighbors[i];
-
-      int edgeWeight = getEdgeWeight(G, currentV, adjV);
-      int altDistance = distance[currentV] + edgeWeight;
-
-      if (altDistance < distance[adjV])
-      {
-        distance[adjV] = altDistance;
-        predecessor[adjV] = currentV;
-      }
-
-      ++i;
-    }
-
-    myfree(neighbors);
-  }
-
-  //
-  // Okay, algorithm has run to completion, and the path (if
-  // any) is stored backwards in predecessor array.  So let's
-  // use a stack to reverse it:
-  //
-  Stack *S = CreateStack(N);
-
-  int v = dest;
-  while (predecessor[v] != -1)
-  {
-    Push(S, v);
-    v = predecessor[v];
-  }
-
-  // loop stops when it gets to src, so push src to finish:
-  Push(S, src);
-
-  //
-  // at this point we have the path on the stack, or if there's
-  // no path, just src is on the stack.  Allocated an array and
-  // fill with path, or if no path, just -1:
-  //
-  Vertex  *path;
-
-  if (S->NumElements == 1) // just src on stack, no path:
-  {
-    N = 1;  // just the -1:
-
-    path = (Vertex *)mymalloc(N * sizeof(Vertex));
-    if (path == NULL)
-    {
-      printf("\n**Error in Dijkstra: malloc failed to allocate\n\n");
-      exit(-1);
-    }
-
-    path[0] = -1;  // no path from src to dest:
-  }
-  else
-  {
-    N = S->NumElements + 1;  // path + -1 at the end
-
-    path = (Vertex *)mymalloc(N * sizeof(Vertex));
-    if (path == NULL)
-    {
-      printf("\n**Error in Dijkstra: malloc failed to allocate\n\n");
-      exit(-1);
-    }
-
-    // now empty the stack into the path array:
-    int i = 0;
-    while (!isEmptyStack(S))
-    {
-      path[i] = Pop(S);
-      ++i;
-    }
-
-    path[i] = -1;  // need -1 terminator at the end:
-  }
-
-  //
-  // done!
-  //
-  DeleteStack(S);
-  DeleteQueue(unvisitedQ);
-  myfree(distance);
-  myfree(predecessor);
-
-  return path;
-}
+/*graph.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <limits.h>
+
+#include "wordkey.h"
+#include "stack.h"
+#include "set.h"
+#include "graph.h"
+#include "hamming.h"
+#include "compress.h"
+#include "hyper.h"
+#include "implicit.h"
+#include "ladder.h"
+#include "bloom.h"
+#include "eytzinger.h"
+#include "pattern.h"
+#include "suggest.h"
+#include "search.h"
+#include "closest.h"
+#include "cost.h"
+#include "mymem.h"
+
+
+
+// #####################################################
+//
+// Graph:
+//
+
+//
+// _createKeyTable:
+//
+// Allocates an empty hash table of 2^bits key slots.
+//
+static KeySlot *_createKeyTable(int bits)
+{
+  int      N = 1 << bits;
+  int      i;
+  KeySlot *table = (KeySlot *)mymalloc(N * sizeof(KeySlot));
+
+  if (table == NULL)
+  {
+    printf("\n**Error in CreateGraph: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (i = 0; i < N; ++i)
+    table[i].V = -1;
+
+  return table;
+}
+
+//
+// _insertKey:
+//
+// Inserts (key, v) into the key table by linear probing, unless
+// the key is already there --- the first vertex with a given name
+// is the one found by lookups.
+//
+static void _insertKey(KeySlot *table, int bits, WordKey key, Vertex v)
+{
+  unsigned int mask = (1u << bits) - 1;
+  unsigned int h = HashKey(key, bits);
+
+  while (table[h].V != -1)
+  {
+    if (table[h].Key == key)  // already present:
+      return;
+
+    h = (h + 1) & mask;
+  }
+
+  table[h].Key = key;
+  table[h].V = v;
+}
+
+//
+// CreateGraph:
+//
+// Creates a directed graph with an initial capacity for N vertices;
+// at this point graph is limited to at most N vertices.  The implementation
+// is based on adjacency lists.
+//
+Graph *CreateGraph(int N)
+{
+  Graph *G;
+  int    i;
+
+  if (N < 1)
+  {
+    printf("\n**Error in CreateGraph: invalid parameter N (%d)\n\n", N);
+    return NULL;
+  }
+
+  //
+  // allocate graph header:
+  //
+  G = (Graph *)mymalloc(sizeof(Graph));
+  if (G == NULL)
+  {
+    printf("\n**Error in CreateGraph: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+
+  //allocate array of adjacency lists, one per vertex:
+
+  G->Vertices = (Edge **)mymalloc(N * sizeof(Edge *));
+  if (G->Vertices == NULL)
+  {
+    printf("\n**Error in CreateGraph: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (i = 0; i < N; ++i)  // initialize to empty lists:
+    G->Vertices[i] = NULL;
+
+  //
+  // allocate array for storing vertex names:
+  //
+  G->Names = (char **)mymalloc(N * sizeof(char *));
+  if (G->Names == NULL)
+  {
+    printf("\n**Error in CreateGraph: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (i = 0; i < N; ++i)  // initialize to empty names:
+    G->Names[i] = NULL;
+
+  //
+  // allocate array of packed keys, one per name:
+  //
+  G->Keys = (WordKey *)mymalloc(N * sizeof(WordKey));
+  if (G->Keys == NULL)
+  {
+    printf("\n**Error in CreateGraph: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  //
+  // and the letters of each name, as a bitmask:
+  //
+  G->LetterMask = (unsigned int *)mymalloc(N * sizeof(unsigned int));
+  if (G->LetterMask == NULL)
+  {
+    printf("\n**Error in CreateGraph: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  //
+  // and the hash table from keys to vertices, at most half full:
+  //
+  G->KeyTableBits = 1;
+  while ((1 << G->KeyTableBits) < 2 * N)
+    G->KeyTableBits++;
+
+  G->KeyTable = _createKeyTable(G->KeyTableBits);
+
+  //
+  // graph is empty to start --- initialize remaining fields:
+  //
+  G->NumVertices = 0;
+  G->NumEdges = 0;
+  G->Capacity = N;
+  G->NumKeys = 0;
+  G->Shards = NULL;
+  G->MaxLength = 0;
+  G->NumSharded = 0;
+  G->Original = NULL;
+  G->Compressed = NULL;
+  G->Hyper = NULL;
+  G->Implicit = 0;  /*false*/
+  G->Lazy = NULL;
+  G->Filter = NULL;
+  G->Patterns = NULL;
+  G->Suggest = NULL;
+  G->Components = NULL;
+  G->NumEditEdges = 0;
+  G->Cost = NULL;
+  G->CostCtx = NULL;
+  G->MaxWeight = 1;
+
+
+  //done!
+
+  return G;
+}
+
+//
+// _freeShards:
+//
+static void _freeShards(Graph *G)
+{
+  int  L;
+
+  if (G->Shards == NULL)
+    return;
+
+  for (L = 0; L <= G->MaxLength; ++L)
+  {
+    int i;
+
+    for (i = 0; i < L; ++i)
+      myfree(G->Shards[L].Alphabet[i]);
+
+    myfree(G->Shards[L].Alphabet);
+    myfree(G->Shards[L].IndexNames);
+    myfree(G->Shards[L].IndexWords);
+    myfree(G->Shards[L].Words);
+    myfree(G->Shards[L].Keys);
+  }
+
+  myfree(G->Shards);
+
+  G->Shards = NULL;
+  G->MaxLength = 0;
+  G->NumSharded = 0;
+}
+
+//
+// DeleteGraph:
+//
+// Frees the memory associated with this graph.
+//
+void DeleteGraph(Graph *G)
+{
+  int  i;
+
+  //
+  // Every vertex has a name, and a list of edges.  Free
+  // that memory:
+  //
+  for (i = 0; i < G->NumVertices; ++i)
+  {
+    // free vertex name:
+    myfree(G->Names[i]);
+
+    // free each edge:
+    Edge *cur, *temp;
+    cur = G->Vertices[i];
+    while (cur != NULL)
+    {
+      temp = cur;
+      cur = cur->next;
+
+      myfree(temp);
+    }
+  }
+  _freeShards(G);
+
+  if (G->Original != NULL)
+    myfree(G->Original);
+  if (G->Compressed != NULL)
+    DeleteCompressedAdj(G->Compressed);
+  if (G->Hyper != NULL)
+    DeleteHypergraph(G->Hyper);
+  if (G->Lazy != NULL)
+    DeleteLazyShards(G);
+  if (G->Filter != NULL)
+    DeleteBloomFilter(G->Filter);
+  if (G->Patterns != NULL)
+    DeletePatternIndex(G->Patterns);
+  if (G->Suggest != NULL)
+    DeleteSuggester(G->Suggest);
+  if (G->Components != NULL)
+    DeleteComponentIndex(G->Components);
+  DeleteCostModel(G);
+
+  // free the arrays we just traversed:
+  myfree(G->Vertices);
+  myfree(G->Names);
+  myfree(G->Keys);
+  myfree(G->LetterMask);
+  myfree(G->KeyTable);
+
+  // free head node:
+  myfree(G);
+
+   //post-order like FatalError hinted at
+}
+
+
+
+//
+// AddVertex:
+//
+// Adds a vertex with the given name to G, returning a unique integer id
+// identifying this vertex.  Returns -1 if adding the vertex failed, i.e.
+// if the graph is full and additional vertices cannot be created; this
+// occurs when the graph's capacity is reached.
+//
+int AddVertex(Graph *G, char *name)
+{
+  int v = G->NumVertices;  // next free location:
+
+  if (G->NumVertices == G->Capacity)  // graph is full:
+  {
+    // we need to dynamically grow, so let's double in size:
+    int N = 2 * G->Capacity;
+
+    //
+    // first we'll grow the array of names:
+    //
+    char **newNames = (char **)mymalloc(N * sizeof(char *));
+    if (newNames == NULL)
+    {
+      printf("\n**Error in AddVertex: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    // copy existing names over:
+    int  i;
+
+    for (i = 0; i < G->NumVertices; ++i)
+    {
+      newNames[i] = G->Names[i];
+    }
+
+    myfree(G->Names);
+
+    //
+    // now we need to grow the edge lists:
+    //
+    Edge **newVertices = (Edge **)mymalloc(N * sizeof(Edge *));
+    if (newVertices == NULL)
+    {
+      printf("\n**Error in AddVertex: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    // copy existing edge lists:
+    for (i = 0; i < G->NumVertices; ++i)
+    {
+      newVertices[i] = G->Vertices[i];
+    }
+
+    myfree(G->Vertices);
+
+    //
+    // and the packed keys:
+    //
+    WordKey *newKeys = (WordKey *)mymalloc(N * sizeof(WordKey));
+    if (newKeys == NULL)
+    {
+      printf("\n**Error in AddVertex: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    memcpy(newKeys, G->Keys, G->NumVertices * sizeof(WordKey));
+
+    myfree(G->Keys);
+
+    unsigned int *newMasks = (unsigned int *)mymalloc(N * sizeof(unsigned int));
+    if (newMasks == NULL)
+    {
+      printf("\n**Error in AddVertex: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    memcpy(newMasks, G->LetterMask, G->NumVertices * sizeof(unsigned int));
+
+    myfree(G->LetterMask);
+
+    //
+    // done, update graph header:
+    //
+    G->Names = newNames;
+    G->Vertices = newVertices;
+    G->Keys = newKeys;
+    G->LetterMask = newMasks;
+    G->Capacity = N;
+  }
+
+  // initialize edge list to empty:
+  G->Vertices[v] = NULL;
+
+  // make a copy of the name:
+  G->Names[v] = (char *)mymalloc(((int)(strlen(name) + 1)) * sizeof(char));
+  if (G->Names[v] == NULL)
+  {
+    printf("\n**Error in AddVertex: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  strcpy(G->Names[v], name);
+
+  //
+  // the letters a..z it has, for filtering searches (see search.c):
+  //
+  char *c;
+
+  G->LetterMask[v] = 0;
+  for (c = name; *c != '\0'; ++c)
+  {
+    if (*c >= 'a' && *c <= 'z')
+      G->LetterMask[v] |= 1u << (*c - 'a');
+  }
+
+  //
+  // pack the name, and if it fits, make it findable by key; the
+  // key table is doubled once it's half full:
+  //
+  G->Keys[v] = PackWord(name);
+
+  if (G->Keys[v] != WORDKEY_NONE)
+  {
+    if (2 * (G->NumKeys + 1) > (1 << G->KeyTableBits))
+    {
+      int      bits = G->KeyTableBits + 1;
+      KeySlot *newTable = _createKeyTable(bits);
+      int      i;
+
+      for (i = 0; i < (1 << G->KeyTableBits); ++i)
+      {
+        if (G->KeyTable[i].V != -1)
+          _insertKey(newTable, bits, G->KeyTable[i].Key, G->KeyTable[i].V);
+      }
+
+      myfree(G->KeyTable);
+
+      G->KeyTable = newTable;
+      G->KeyTableBits = bits;
+    }
+
+    _insertKey(G->KeyTable, G->KeyTableBits, G->Keys[v], v);
+    G->NumKeys++;
+  }
+
+  //
+  // the filter (if any) must never rule out an existing name that
+  // doesn't pack:
+  //
+  if (G->Filter != NULL && G->Keys[v] == WORDKEY_NONE)
+  {
+    BloomAdd(G->Filter, BloomHashName(name));
+    G->Filter->NumItems++;
+  }
+
+  // one more vertex now:
+  G->NumVertices++;
+
+  // done!  Return vertex's number:
+  return v;
+}
+
+//
+// Name2Vertex:
+//
+// Looks up a vertex by name, returning its vertex #
+// if found -- this value will be >= 0.  Returns -1 if
+// not found.  Names that pack into a key are found by
+// hashing; the rest by searching the index of their
+// shard (see Variant2Vertex), unless the filter (if any)
+// rules the name out first.
+//
+int Name2Vertex(Graph *G, char *Name)
+{
+  WordKey key = PackWord(Name);
+
+  if (key != WORDKEY_NONE)
+    return Key2Vertex(G, key);
+
+  if (G->Filter != NULL && !BloomMayContain(G->Filter, BloomHashName(Name)))
+    return -1;
+
+  return Variant2Vertex(G, Name, -1, 0);
+}
+
+//
+// Variant2Vertex:
+//
+// Looks up the vertex named word with position pos changed to c
+// (or word itself if pos < 0), without copying the word, returning
+// its vertex # or -1 if not found.  Searches the Eytzinger index of
+// the word's shard, then linearly any vertices added since the
+// shards were built.
+//
+int Variant2Vertex(Graph *G, char *word, int pos, char c)
+{
+  int len = (int)strlen(word);
+  int i;
+
+  if (G->Shards != NULL && len <= G->MaxLength)
+  {
+    Shard *S = &G->Shards[len];
+    int    k = EytzingerLowerBound(S->IndexNames, S->NumWords, word, pos, c);
+
+    if (k != 0 && CompareVariant(word, pos, c, S->IndexNames[k]) == 0)  // match!
+      return S->IndexWords[k];
+  }
+
+  for (i = G->NumSharded; i < G->NumVertices; ++i)
+  {
+    if (CompareVariant(word, pos, c, G->Names[i]) == 0)
+      return i;
+  }
+
+  // if get here, not found:
+  return -1;
+}
+
+//
+// WordsWithPrefix:
+//
+// Returns the words that start with the given prefix, a range of
+// each shard's index: shortest words first, and in ascending order
+// within a length (the order of the dictionary), followed by -1.
+//
+// NOTE: words added since BuildShards was last called are not
+// found.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *WordsWithPrefix(Graph *G, char *prefix)
+{
+  int     len = (int)strlen(prefix);
+  int     n = 0;
+  int     pass, L;
+  Vertex *words = NULL;
+
+  //
+  // count the words in the ranges, then allocate and fill:
+  //
+  for (pass = 0; pass < 2; ++pass)
+  {
+    n = 0;
+
+    for (L = len; G->Shards != NULL && L <= G->MaxLength; ++L)
+    {
+      Shard *S = &G->Shards[L];
+      int    k = EytzingerLowerBound(S->IndexNames, S->NumWords, prefix, -1, 0);
+
+      while (k != 0 && strncmp(S->IndexNames[k], prefix, len) == 0)
+      {
+        if (pass == 1)
+          words[n] = S->IndexWords[k];
+
+        n++;
+        k = EytzingerNext(k, S->NumWords);
+      }
+    }
+
+    if (pass == 0)
+    {
+      words = (Vertex *)mymalloc((n + 1) * sizeof(Vertex));
+      if (words == NULL)
+      {
+        printf("\n**Error in WordsWithPrefix: malloc failed to allocate\n\n");
+        exit(-1);
+      }
+    }
+  }
+
+  words[n] = -1;
+
+  return words;
+}
+
+//
+// Key2Vertex:
+//
+// Looks up a vertex by packed key, returning its vertex #
+// if found -- this value will be >= 0.  Returns -1 if
+// not found.
+//
+int Key2Vertex(Graph *G, WordKey key)
+{
+  unsigned int mask = (1u << G->KeyTableBits) - 1;
+  unsigned int h = HashKey(key, G->KeyTableBits);
+
+  while (G->KeyTable[h].V != -1)
+  {
+    if (G->KeyTable[h].Key == key)  // match!
+      return G->KeyTable[h].V;
+
+    h = (h + 1) & mask;
+  }
+
+  // if get here, not found:
+  return -1;
+}
+
+//
+// Keys2Vertices:
+//
+// Looks up n packed keys at once: vertices[i] is set to the vertex #
+// of keys[i], or -1 if not found, as by Key2Vertex.  The keys are
+// taken in groups of KEYS_GROUP: the hashes of a whole group are
+// computed and the memory they lead to prefetched before any key of
+// the group is resolved, so that the cache misses of the group
+// overlap instead of being paid one after the other.
+//
+#define KEYS_GROUP  16
+
+void Keys2Vertices(Graph *G, WordKey *keys, int n, Vertex *vertices)
+{
+  unsigned int mask = (1u << G->KeyTableBits) - 1;
+  unsigned int slot[KEYS_GROUP];
+  int          start, i;
+
+  for (start = 0; start < n; start += KEYS_GROUP)
+  {
+    int m = (n - start < KEYS_GROUP) ? n - start : KEYS_GROUP;
+
+    //
+    // (1) key table slots:
+    //
+    for (i = 0; i < m; ++i)
+    {
+      slot[i] = HashKey(keys[start + i], G->KeyTableBits);
+      __builtin_prefetch(&G->KeyTable[slot[i]]);
+    }
+
+    //
+    // (2) resolve, by linear probing as in Key2Vertex:
+    //
+    for (i = 0; i < m; ++i)
+    {
+      unsigned int h = slot[i];
+      WordKey      key = keys[start + i];
+
+      vertices[start + i] = -1;
+
+      while (G->KeyTable[h].V != -1)
+      {
+        if (G->KeyTable[h].Key == key)  // match!
+        {
+          vertices[start + i] = G->KeyTable[h].V;
+          break;
+        }
+
+        h = (h + 1) & mask;
+      }
+    }
+  }
+}
+
+//
+// Vertex2Name:
+//
+// Looks up a vertex by number, returning a pointer to
+// its name; returns NULL if v is invalid.
+//
+// NOTE: do not change the string via the returned
+// pointer; treat the pointer and the underlying string
+// read-only.
+//
+char *Vertex2Name(Graph *G, Vertex v)
+{
+  if (v < 0 || v >= G->NumVertices)
+    return NULL;
+
+  return G->Names[v];
+}
+
+//
+// AddEdge:
+//
+// Adds a directed edge (src, dest, weight) to G.  If successful, true
+// (non-zero) is returned; if the edge could not be added (i.e. due to
+// invalid vertex ids), then false (0) is returned.
+//
+// NOTE: loops and multi-edges are allowed.  To allow easier handling of
+// multi-edges, edges are stored "in order by destination".  So when
+// inserting a new edge E = (s,d,w), insert this edge in the list such
+// that E's position in the list is ordered by "d".  Example: if the list
+// contains (0,1,100)->(0,2,75), and the new edge is (0,2,150), then the
+// resulting list is (0,1,100)->(0,2,150)->(0,2,75).  The new edge is
+// inserted *before* existing edges with same or larger destination.
+//
+// NOTE: edges cannot be added once the graph has been compressed
+// (see CompressGraph); false is returned.
+//
+int AddEdge(Graph *G, Vertex src, Vertex dest, int weight)
+{
+  if (G->Compressed != NULL)  // lists are read-only now:
+    return 0;
+  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
+    return 0;
+  if (dest < 0 || dest >= G->NumVertices)  // invalid vertex #:
+    return 0;
+
+  //
+  // allocate memory for new edge:
+  //
+  Edge *edge = (Edge *)mymalloc(sizeof(Edge));
+  if (edge == NULL)
+  {
+    printf("\n**Error in AddEdge: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  //
+  // store data:
+  //
+  edge->src = src;
+  edge->dest = dest;
+  edge->weight = weight;
+
+  //
+  // link into edge list --- we want to insert in order so that we
+  // can detect multi-edges more easily (i.e. they will be consecutive
+  // in the adjacency list):
+  //
+  Edge *prev = NULL;
+  Edge *cur = G->Vertices[src];
+
+  while (cur != NULL)
+  {
+    if (dest <= cur->dest)  // insert here!
+      break;
+
+    // else keep going:
+    prev = cur;
+    cur = cur->next;
+  }
+
+  if (prev == NULL)  // update head pointer:
+  {
+    edge->next = G->Vertices[src];
+    G->Vertices[src] = edge;
+  }
+  else  // insert between prev and cur:
+  {
+    edge->next = prev->next;
+    prev->next = edge;
+  }
+
+  //
+  // done (atomically, since shards may be built concurrently, see
+  // MaterializeShard):
+  //
+  __sync_fetch_and_add(&G->NumEdges, 1);
+
+  int maxWeight;
+
+  while (weight > (maxWeight = G->MaxWeight) &&
+         !__sync_bool_compare_and_swap(&G->MaxWeight, maxWeight, weight))
+    ;
+
+  return 1;  // success!
+}
+
+//
+// BeginNeighbors:
+//
+// Starts iterating over the edges out of v; each call to
+// NextNeighbor then returns the dest of the next edge, or -1 once
+// there are no more.  This works the same whichever way the edges
+// are stored (adjacency lists, compressed, hypergraph, or not at
+// all in implicit mode), so traversals should use it rather than
+// following G->Vertices directly.  The dests come in ascending
+// order, except on a hypergraph, where they come pattern by
+// pattern, and in implicit mode, position by position.  Example:
+//
+//   NeighborIter it;
+//   Vertex       w;
+//
+//   BeginNeighbors(G, v, &it);
+//   while ((w = NextNeighbor(&it, NULL)) != -1)
+//     ...
+//
+void BeginNeighbors(Graph *G, Vertex v, NeighborIter *it)
+{
+  it->G = G;
+  it->Src = v;
+
+  if (G->Hyper != NULL)
+  {
+    it->Kind = NEIGHBORS_HYPER;
+    HyperFirst(G->Hyper, v, it);
+  }
+  else if (G->Implicit)
+  {
+    it->Kind = NEIGHBORS_IMPLICIT;
+    ImplicitFirst(G, v, it);
+  }
+  else if (G->Compressed != NULL)
+  {
+    it->Kind = NEIGHBORS_COMPRESSED;
+    CompressedFirst(G->Compressed, v, it);
+  }
+  else
+  {
+    if (G->Lazy != NULL)  // make sure v's edges exist:
+      MaterializeShard(G, (G->Keys[v] != WORDKEY_NONE) ? KeyLength(G->Keys[v])
+                                                       : (int)strlen(G->Names[v]));
+
+    it->Kind = NEIGHBORS_LISTS;
+    it->Cur = G->Vertices[v];
+  }
+}
+
+//
+// NextNeighbor:
+//
+// Returns the dest of the next edge, storing its weight via
+// weight (if not NULL); returns -1 if there are no more edges.
+//
+Vertex NextNeighbor(NeighborIter *it, int *weight)
+{
+  if (it->Kind == NEIGHBORS_COMPRESSED)
+    return CompressedNext(it, weight);
+
+  if (it->Kind == NEIGHBORS_HYPER || it->Kind == NEIGHBORS_IMPLICIT)
+  {
+    Vertex w = (it->Kind == NEIGHBORS_HYPER) ? HyperNext(it) : ImplicitNext(it);
+
+    if (weight != NULL)  // no edges, so no weights stored:
+      *weight = (w != -1) ? EdgeCost(it->G, it->Src, w) : 0;
+
+    return w;
+  }
+
+  Edge *cur = it->Cur;
+
+  if (cur == NULL)
+    return -1;
+
+  it->Cur = cur->next;
+
+  if (weight != NULL)
+    *weight = cur->weight;
+
+  return cur->dest;
+}
+
+static int _compareVertices(const void *a, const void *b)
+{
+  Vertex v1 = *(const Vertex *)a;
+  Vertex v2 = *(const Vertex *)b;
+
+  return (v1 > v2) - (v1 < v2);
+}
+
+//
+// _sortedNeighbors:
+//
+// Copies the iterator's neighbors into the given array, sorted and
+// without duplicates, followed by -1.
+//
+static Vertex *_sortedNeighbors(NeighborIter *it, Vertex *neighbors)
+{
+  Vertex dest;
+  int    n = 0;
+  int    i, j;
+
+  while ((dest = NextNeighbor(it, NULL)) != -1)
+    neighbors[n++] = dest;
+
+  qsort(neighbors, n, sizeof(Vertex), _compareVertices);
+
+  for (i = 0, j = 0; i < n; ++i)
+  {
+    if (j == 0 || neighbors[j - 1] != neighbors[i])
+      neighbors[j++] = neighbors[i];
+  }
+
+  neighbors[j] = -1;
+
+  return neighbors;
+}
+
+//
+// Neighbors:
+//
+// Returns the neighbors of a given vertex --- i.e. the vertices
+// adjacent to v.  The neighbors are returned in a dynamically-
+// allocated array, in ascending order; the vertices are followed
+// by -1 to denote the end of the data.  A vertex appears at most
+// once in the returned array, even in the presence of multi-edges.
+//
+// NOTE: returns NULL if v is not a valid vertex id.
+//
+// NOTE: it is the responsibility of the CALLER to free the returned
+// array when they are done.
+//
+Vertex *Neighbors(Graph *G, Vertex v)
+{
+  Vertex *neighbors;
+  int     N;
+  int     i;
+
+  if (v < 0 || v >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  //
+  // allocate array of worst-case size: # of vertices + 1
+  //
+  N = G->NumVertices + 1;
+
+  neighbors = (Vertex *)mymalloc(N * sizeof(Vertex));
+  if (neighbors == NULL)
+  {
+    printf("\n**Error in Neighbors: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  //
+  // Now loop through the edges and copy the dest
+  // vertex of each edge:
+  //
+  NeighborIter it;
+  Vertex       dest;
+
+  BeginNeighbors(G, v, &it);
+
+  if (it.Kind == NEIGHBORS_HYPER || it.Kind == NEIGHBORS_IMPLICIT)  // not in order, so sort:
+    return _sortedNeighbors(&it, neighbors);
+
+  i = 0;
+  while ((dest = NextNeighbor(&it, NULL)) != -1)  // for each edge out of v:
+  {
+    //
+    // the dest is our neighbor --- however, we have to be
+    // careful of multi-edges, i.e. edges with the same dest.
+    // Since edges are stored in order, edges with same dest
+    // appear next to each other in the list --- so look to
+    // see if array already contains dest before we copy over:
+    //
+    if (i == 0)  // first neighbor, we always copy:
+    {
+      neighbors[i] = dest;
+      ++i;
+    }
+    else if (neighbors[i - 1] != dest)  // make sure not a multi-edge:
+    {
+      neighbors[i] = dest;
+      ++i;
+    }
+    else // multi-edge, so ignore:
+      ;
+  }
+
+  //
+  // follow last element with -1 and return:
+  //
+  neighbors[i] = -1;
+
+  return neighbors;
+}
+
+static char **g_names;  // for the qsort comparator below:
+
+static int _byName(const void *a, const void *b)
+{
+  Vertex v1 = *(const Vertex *)a;
+  Vertex v2 = *(const Vertex *)b;
+  int    cmp = strcmp(g_names[v1], g_names[v2]);
+
+  if (cmp != 0)
+    return cmp;
+
+  return (v1 > v2) - (v1 < v2);
+}
+
+//
+// _indexShard:
+//
+// Builds S's index of names in Eytzinger order.  The shard's words
+// are in vertex order, which for a sorted dictionary is also name
+// order, and then the index is laid out in O(n); otherwise they
+// are sorted first.
+//
+static void _indexShard(Graph *G, Shard *S)
+{
+  int      n = S->NumWords;
+  Vertex  *sortedWords = (Vertex *)mymalloc((n + 1) * sizeof(Vertex));
+  char   **sortedNames = (char **)mymalloc((n + 1) * sizeof(char *));
+  int      sorted = 1;  /*true*/
+  int      i;
+
+  S->IndexNames = (char **)mymalloc((n + 1) * sizeof(char *));
+  S->IndexWords = (Vertex *)mymalloc((n + 1) * sizeof(Vertex));
+
+  if (sortedWords == NULL || sortedNames == NULL ||
+      S->IndexNames == NULL || S->IndexWords == NULL)
+  {
+    printf("\n**Error in BuildShards: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  memcpy(sortedWords, S->Words, n * sizeof(Vertex));
+
+  for (i = 1; i < n && sorted; ++i)
+    sorted = (strcmp(G->Names[sortedWords[i - 1]], G->Names[sortedWords[i]]) <= 0);
+
+  if (!sorted)
+  {
+    g_names = G->Names;
+    qsort(sortedWords, n, sizeof(Vertex), _byName);
+  }
+
+  for (i = 0; i < n; ++i)
+    sortedNames[i] = G->Names[sortedWords[i]];
+
+  EytzingerLayout(sortedNames, sortedWords, n, S->IndexNames, S->IndexWords);
+
+  myfree(sortedWords);
+  myfree(sortedNames);
+}
+
+//
+// BuildShards:
+//
+// Groups the vertices by the length of their names, so that the
+// words of length L are G->Shards[L].Words, ascending, with their
+// packed keys stored alongside.  Each shard also records which
+// characters occur at each position, in ascending order, so that
+// candidate words need only try those, and indexes its names in
+// Eytzinger order for Name2Vertex.  Call once all the vertices have
+// been added; calling again rebuilds the shards.
+//
+void BuildShards(Graph *G)
+{
+  int  v, L, i;
+
+  _freeShards(G);
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    int len = (int)strlen(G->Names[v]);
+
+    if (len > G->MaxLength)
+      G->MaxLength = len;
+  }
+
+  G->Shards = (Shard *)mymalloc((G->MaxLength + 1) * sizeof(Shard));
+  if (G->Shards == NULL)
+  {
+    printf("\n**Error in BuildShards: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  //
+  // count the words of each length, then allocate and fill:
+  //
+  for (L = 0; L <= G->MaxLength; ++L)
+    G->Shards[L].NumWords = 0;
+
+  for (v = 0; v < G->NumVertices; ++v)
+    G->Shards[strlen(G->Names[v])].NumWords++;
+
+  for (L = 0; L <= G->MaxLength; ++L)
+  {
+    Shard *S = &G->Shards[L];
+    int    N = S->NumWords + 1;  // never malloc 0 bytes:
+
+    S->Words = (Vertex *)mymalloc(N * sizeof(Vertex));
+    S->Keys = (WordKey *)mymalloc(N * sizeof(WordKey));
+    if (S->Words == NULL || S->Keys == NULL)
+    {
+      printf("\n**Error in BuildShards: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    S->NumWords = 0;
+  }
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    Shard *S = &G->Shards[strlen(G->Names[v])];
+
+    S->Words[S->NumWords] = v;
+    S->Keys[S->NumWords] = G->Keys[v];
+    S->NumWords++;
+  }
+
+  //
+  // and the alphabet of each (length, position):
+  //
+  for (L = 0; L <= G->MaxLength; ++L)
+  {
+    Shard *S = &G->Shards[L];
+
+    S->Alphabet = (char **)mymalloc((L + 1) * sizeof(char *));
+    if (S->Alphabet == NULL)
+    {
+      printf("\n**Error in BuildShards: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    for (i = 0; i < L; ++i)
+    {
+      unsigned char seen[256];
+      int           n = 0;
+      int           c, k;
+
+      memset(seen, 0, sizeof(seen));
+
+      for (k = 0; k < S->NumWords; ++k)
+        seen[(unsigned char)G->Names[S->Words[k]][i]] = 1;
+
+      for (c = 1; c < 256; ++c)
+        n += seen[c];
+
+      S->Alphabet[i] = (char *)mymalloc(n + 1);
+      if (S->Alphabet[i] == NULL)
+      {
+        printf("\n**Error in BuildShards: malloc failed to allocate\n\n");
+        exit(-1);
+      }
+
+      for (c = 1, n = 0; c < 256; ++c)
+      {
+        if (seen[c])
+          S->Alphabet[i][n++] = (char)c;
+      }
+
+      S->Alphabet[i][n] = '\0';
+    }
+  }
+
+  //
+  // and the index of each shard's names:
+  //
+  for (L = 0; L <= G->MaxLength; ++L)
+    _indexShard(G, &G->Shards[L]);
+
+  G->NumSharded = G->NumVertices;
+}
+
+//
+// ScanNeighbors:
+//
+// Returns the words that differ from v's name in exactly one
+// letter, found by scanning v's shard rather than following edges;
+// this works whether or not edges have been added.  The result is
+// the same as Neighbors(): ascending, followed by -1.
+//
+// NOTE: returns NULL if v is not a valid vertex id, or if
+// BuildShards has not been called.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *ScanNeighbors(Graph *G, Vertex v)
+{
+  if (v < 0 || v >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+  if (G->Shards == NULL)
+    return NULL;
+
+  Shard  *S = &G->Shards[strlen(G->Names[v])];
+  Vertex *neighbors = (Vertex *)mymalloc((S->NumWords + 1) * sizeof(Vertex));
+  if (neighbors == NULL)
+  {
+    printf("\n**Error in ScanNeighbors: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  int  n = 0;
+  int  i;
+
+  if (G->Keys[v] != WORDKEY_NONE)
+  {
+    //
+    // vectorized scan of the shard's keys, then map to vertices:
+    //
+    n = HammingScan(S->Keys, S->NumWords, G->Keys[v], neighbors);
+
+    for (i = 0; i < n; ++i)
+      neighbors[i] = S->Words[neighbors[i]];
+  }
+  else
+  {
+    //
+    // name doesn't pack, compare strings char by char:
+    //
+    char *name = G->Names[v];
+
+    for (i = 0; i < S->NumWords; ++i)
+    {
+      char *other = G->Names[S->Words[i]];
+      int   diffs = 0;
+      int   j;
+
+      for (j = 0; name[j] != '\0' && diffs < 2; ++j)
+      {
+        if (name[j] != other[j])
+          diffs++;
+      }
+
+      if (diffs == 1)
+      {
+        neighbors[n] = S->Words[i];
+        ++n;
+      }
+    }
+  }
+
+  neighbors[n] = -1;
+
+  return neighbors;
+}
+
+///
+// Prints the graph for debugging purposes.  Pass true
+// (non-zero) for the "complete" parameter to dump complete
+// info --- e.g. BFS and DFS from each vertex --- otherwise
+// pass false (0) for just graph stats.
+//
+void PrintGraph(Graph *G, char *title, int complete)
+{
+  printf(">>Graph: %s\n", title);
+  printf("  # of vertices: %d\n", G->NumVertices);
+  printf("  # of edges:    %d\n", G->NumEdges);
+
+  if (G->NumEditEdges > 0)
+    printf("  edit edges:    %d (insert/delete a letter), %d change a letter\n",
+      G->NumEditEdges, G->NumEdges - G->NumEditEdges);
+
+  if (G->Implicit)
+    printf("  (implicit:     neighbors generated on demand)\n");
+
+  if (G->Cost != NULL || G->MaxWeight > 1)
+    printf("  weights:       1..%d (%s cost)\n", G->MaxWeight, CostModelName(G));
+
+  if (G->Lazy != NULL)
+  {
+    int numShards;
+    int numBuilt = ShardsMaterialized(G, &numShards);
+
+    printf("  shards built:  %d of %d (lazily)\n", numBuilt, numShards);
+  }
+
+  if (G->Filter != NULL)
+  {
+    long long bytes = BloomBytes(G->Filter);
+
+    printf("  filter:        %lld bytes (%.1f bits per word, %d hashes), %.2f%% false positives, built in %.2f ms\n",
+      bytes, 8.0 * bytes / (G->Filter->NumItems > 0 ? G->Filter->NumItems : 1), G->Filter->NumHashes,
+      100.0 * G->Filter->FalsePositiveRate, G->Filter->BuildTime);
+  }
+
+  if (G->Hyper != NULL)
+  {
+    printf("  # of patterns: %d\n", G->Hyper->NumPatterns);
+    printf("  memberships:   %lld (%lld bytes, for %lld implied edges)\n",
+      G->Hyper->NumMemberships, HypergraphBytes(G->Hyper),
+      HypergraphImpliedEdges(G->Hyper));
+  }
+
+  if (G->Patterns != NULL)
+    printf("  pattern index: %lld bytes of bitmaps\n", G->Patterns->Bytes);
+
+  if (G->Suggest != NULL)
+    printf("  suggest index: %d deletions (up to %d), %lld bytes, built in %.2f ms\n",
+      G->Suggest->NumEntries, G->Suggest->MaxEdits, G->Suggest->Bytes,
+      G->Suggest->BuildTime);
+
+  if (G->Components != NULL)
+    printf("  components:    %d (%d by length), %lld bytes, built in %.2f ms\n",
+      G->Components->NumComponents, G->Components->NumBuckets, G->Components->Bytes,
+      G->Components->BuildTime);
+
+  if (G->Compressed != NULL)
+  {
+    long long bytes = CompressedBytes(G->Compressed);
+
+    printf("  compressed:    %lld bytes (%.2f per edge)\n", bytes,
+      (G->NumEdges > 0) ? (double)bytes / G->NumEdges : 0.0);
+  }
+
+  // is a complete print desired?  if not, return now:
+  if (!complete)
+    return;
+
+  //
+  // Otherwise dump complete graph info:
+  //
+  printf("  Adjacency Lists:\n");
+
+  int  v;
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    printf("   %d (%s): ", v, G->Names[v]);
+
+    NeighborIter it;
+    Vertex       dest;
+    int          weight;
+    int          first = 1;  /*true*/
+
+    BeginNeighbors(G, v, &it);
+    while ((dest = NextNeighbor(&it, &weight)) != -1)
+    {
+      if (!first)
+        printf(", ");
+
+      printf("(%d,%d,%d)", v, dest, weight);
+      first = 0;  /*false*/
+    }
+
+    printf("\n");
+  }
+
+  //
+  // neighbors:
+  //
+  printf("  Neighbors:\n");
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    printf("   %d (%s): ", v, G->Names[v]);
+
+    Vertex *neighbors = Neighbors(G, v);
+
+    if (neighbors == NULL)
+      printf("**ERROR: Neighbors returned NULL.\n\n");
+    else
+    {
+      int  j;
+
+      for (j = 0; neighbors[j] != -1; ++j)
+      {
+        printf("%d, ", neighbors[j]);
+      }
+
+      printf("-1\n");
+
+      myfree(neighbors);
+    }
+  }
+
+  //
+  // BFS:
+  //
+  printf("  BFS:\n");
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    printf("   %d (%s): ", v, G->Names[v]);
+
+    Vertex *visited = BFS(G, v);
+
+    if (visited == NULL)
+      printf("**ERROR: BFS returned NULL.\n\n");
+    else
+    {
+      int  j;
+
+      for (j = 0; visited[j] != -1; ++j)
+      {
+        printf("%d, ", visited[j]);
+      }
+
+      printf("-1\n");
+
+      myfree(visited);
+    }
+  }
+
+  //
+  // DFS:
+  //
+  printf("  DFS:\n");
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    printf("   %d (%s): ", v, G->Names[v]);
+
+    Vertex *visited = DFS(G, v);
+
+    if (visited == NULL)
+      printf("**ERROR: DFS returned NULL.\n\n");
+    else
+    {
+      int  j;
+
+      for (j = 0; visited[j] != -1; ++j)
+      {
+        printf("%d, ", visited[j]);
+      }
+
+      printf("-1\n");
+
+      myfree(visited);
+    }
+  }
+
+}
+
+//
+// BFS:
+//
+// Performs a breadth-first search starting from vertex v,
+// returning a dynamically-allocated array of the vertices
+// visited, in the order they are visited.  Note that v will
+// appear first in the returned array, and the last vertex
+// is followed by -1 to denote the end.  When the neighbors
+// of a vertex are visited, they are done so in ascending
+// order; no vertex is visited more than once, even in the
+// presence of cycles and multi-edges.
+//
+// NOTE: returns NULL if v is not a valid vertex id.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *BFS(Graph *G, Vertex v)
+{
+  Vertex *visited;
+  int     N;
+  int     i;
+
+  if (v < 0 || v >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  if (G->Hyper != NULL)  // search through the patterns instead:
+    return HyperBFS(G, v);
+
+  //
+  // allocate array of worst-case size: # of vertices + 1
+  //
+  N = G->NumVertices + 1;
+
+  visited = (Vertex *)mymalloc(N * sizeof(Vertex));
+  if (visited == NULL)
+  {
+    printf("\n**Error in BFS: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  //
+  // Perform BFS, starting at given vertex v:
+  //
+  Queue *frontierQ = CreateQueue(N);
+  Set   *discoveredSet = CreateSet(N);
+
+  if (!Enqueue(frontierQ, v)) { printf("Error!\n"); exit(-1); }
+  if (!AddToSet(discoveredSet, v)) { printf("Error!\n"); exit(-1); }
+
+  i = 0;  // index into visited of where next vertex goes:
+
+  while (!isEmptyQueue(frontierQ))
+  {
+    Vertex currentV = Dequeue(frontierQ);
+
+    // visit:  add to visited list:
+    visited[i] = currentV;
+    ++i;
+
+    Vertex *neighbors = Neighbors(G, currentV);
+
+    int j = 0;  // index into array of neighbors:
+    while (neighbors[j] != -1)
+    {
+      Vertex adjV = neighbors[j];
+
+      if (!isElementInSet(discoveredSet, adjV))
+      {
+        if (!Enqueue(frontierQ, adjV)) { printf("Error!\n"); exit(-1); }
+        if (!AddToSet(discoveredSet, adjV)) { printf("Error!\n"); exit(-1); }
+      }
+
+      ++j;
+    }
+
+    myfree(neighbors);
+  }//while
+
+   //
+   // done:
+   //
+  visited[i] = -1;  // mark end of vertices with -1:
+
+  DeleteQueue(frontierQ);
+  DeleteSet(discoveredSet);
+
+  return visited;
+}
+
+
+//
+// BFSd:
+//
+// Performs a breadth-first search starting from vertex v,
+// returning a dynamically-allocated array of the vertices
+// visited, in the order they are visited.  Unlike BFS(),
+// this function stops after walking "d" steps away from v.
+// A "step" is an edge, which implies that d=2 => visiting
+// all nodes 2 edges away from v.
+//
+// The returned array contains "markers" to denote vertices
+// that are 0 steps away, 1 step away, 2 steps away, etc.
+// Each marker is -1, so given a distance d, the caller should
+// loop through the returned vertex until d+1 markers are
+// processed.  Then stop.  Example: d=2 => 3 markers,
+// after step 0, step 1, and step 2.
+//
+// NOTE: returns NULL if v is not a valid vertex id, or
+// if distance < 1.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *BFSd(Graph *G, Vertex v, int distance)
+{
+  Vertex *visited;
+  int     N;
+  int     i;
+
+  if (v < 0 || v >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  if (distance < 1)
+    return NULL;
+
+  if (G->Hyper != NULL)  // search through the patterns instead:
+    return HyperBFSd(G, v, distance);
+
+  //
+  // allocate array of worst-case size: # of vertices + distance + 1
+  //
+  N = G->NumVertices + distance + 1;
+
+  visited = (Vertex *)mymalloc(N * sizeof(Vertex));
+  if (visited == NULL)
+  {
+    printf("\n**Error in BFS: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  //
+  // Perform BFS, starting at given vertex v:
+  //
+  Queue *frontierQ = CreateQueue(N);
+  Set   *discoveredSet = CreateSet(N);
+
+  if (!Enqueue(frontierQ, v)) { printf("Error!\n"); exit(-1); }
+  if (!AddToSet(discoveredSet, v)) { printf("Error!\n"); exit(-1); }
+
+  i = 0;  // index into visited of where next vertex goes:
+
+  Enqueue(frontierQ, -1);
+
+  while (!isEmptyQueue(frontierQ))
+  {
+
+    if (frontierQ->Elements[frontierQ->Front] == -1)
+    {
+      visited[i] = -1;
+      ++i;
+
+      distance--;
+      if (distance < 0)
+        break;
+
+      Dequeue(frontierQ);
+      Enqueue(frontierQ, -1);
+
+      continue;  // skip loop body and repeat:
+    }
+
+    Vertex currentV = Dequeue(frontierQ);
+
+    // visit:  add to visited list:
+    visited[i] = currentV;
+    ++i;
+
+    Vertex *neighbors = Neighbors(G, currentV);
+
+    int j = 0;  // index into array of neighbors:
+    while (neighbors[j] != -1)
+    {
+      Vertex adjV = neighbors[j];
+
+      if (!isElementInSet(discoveredSet, adjV))
+      {
+        if (!Enqueue(frontierQ, adjV)) { printf("Error!\n"); exit(-1); }
+        if (!AddToSet(discoveredSet, adjV)) { printf("Error!\n"); exit(-1); }
+      }
+
+      ++j;
+    }
+
+    myfree(neighbors);
+
+  }//while
+
+   //
+   // done:
+   //
+  visited[i] = -1;  // mark end of vertices with -1:
+
+  DeleteQueue(frontierQ);
+  DeleteSet(discoveredSet);
+
+  return visited;
+}
+
+//
+// DFS:
+//
+// Performs a depth-first search starting from vertex v,
+// returning a dynamically-allocated array of the vertices
+// visited, in the order they are visited.  Note that v will
+// appear first in the returned array, and the last vertex
+// is followed by -1 to denote the end; a vertex appears
+// at most once in the visited array.  When the neighbors
+// of a vertex are visited, they are done so in ascending
+// order.
+//
+// NOTE: returns NULL if v is not a valid vertex id.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *DFS(Graph *G, Vertex v)
+{
+  if (v < 0 || v >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  //
+  // Perform DFS, starting at given vertex v:
+  //
+  int N = G->NumVertices + 1;
+
+  Stack *frontierStack = CreateStack(N);
+  Set   *visitedSet = CreateSet(N);
+  Queue *visitedQ = CreateQueue(N);
+
+  if (!Push(frontierStack, v)) { printf("Error!\n"); exit(-1); }
+
+  while (!isEmptyStack(frontierStack))
+  {
+    Vertex currentV = Pop(frontierStack);
+
+    //
+    // visit:  add to visited list *if* not already there, since
+    // DFS may end up visiting vertices multiple times:
+    //
+    if (!isElementInQueue(visitedQ, currentV))
+    {
+      if (!Enqueue(visitedQ, currentV)) { printf("Error!\n"); exit(-1); }
+    }
+
+    //
+    // now push neighbors in reverse order so that we visit in
+    // ascending order:
+    //
+    if (!isElementInSet(visitedSet, currentV))
+    {
+      if (!AddToSet(visitedSet, currentV)) { printf("Error!\n"); exit(-1); }
+
+      Vertex *neighbors = Neighbors(G, currentV);
+
+      //
+      // Note: push them backwards onto stack so vertices are
+      // on the stack in ascending order:
+      //
+      int j = 0;  // index into array of neighbors:
+
+      while (neighbors[j] != -1)  // find the end
+        j++;
+
+      j--;  // advance to last vertex in the visited array:
+
+      while (j >= 0)  // now push backwards:
+      {
+        Vertex adjV = neighbors[j];
+
+        if (!Push(frontierStack, adjV)) { printf("Error!\n"); exit(-1); }
+
+        --j;
+      }
+
+      myfree(neighbors);
+    }
+  }//while
+
+  //
+  // done: our set of visited vertices is in visitedQ, so let's
+  // copy out of there into a dynamically-allocated array:
+  //
+
+  //
+  // allocate array of worst-case size: # of vertices + 1
+  //
+  Vertex *visited;
+
+  visited = (Vertex *)mymalloc(N * sizeof(Vertex));
+  if (visited == NULL)
+  {
+    printf("\n**Error in DFS: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  // dequeue vertices into the visited array:
+  int i = 0;  // index into visited array:
+
+  while (!isEmptyQueue(visitedQ))
+  {
+    visited[i] = Dequeue(visitedQ);
+    ++i;
+  }
+
+  visited[i] = -1;  // mark end of vertices with -1:
+
+  //
+  // Done:
+  //
+  DeleteStack(frontierStack);
+  DeleteSet(visitedSet);
+  DeleteQueue(visitedQ);
+
+  return visited;
+}
+
+
+//------------------------------------Dijkstra ALGORITHM---------------------------------------------------//
+//
+// getEdgeWeight:
+//
+// Returns the weight along edge src -> dest.  If there are
+// multiple edges, returns the minimum weight; if there is no
+// such edge, an error message is printed and the program is
+// exited.
+//
+// NOTE: the error message and program exit occur since you
+// should never call function unless the edge exists.
+//
+int getEdgeWeight(Graph *G, Vertex src, Vertex dest)
+{
+  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
+  {
+    printf("\n**Error in getEdgeWeight: src vertex (%d) invalid.\n\n", src);
+    exit(-1);
+  }
+  if (dest < 0 || dest >= G->NumVertices)  // invalid vertex #:
+  {
+    printf("\n**Error in getEdgeWeight: dest vertex (%d) invalid.\n\n", dest);
+    exit(-1);
+  }
+
+  //
+  // search src's edge list, note that multi-edges appear together:
+  //
+  NeighborIter it;
+  Vertex       curDest;
+  int          curWeight;
+  int          weight = 0;
+  int          haveEdge = 0;  /*false*/
+
+  BeginNeighbors(G, src, &it);
+
+  while ((curDest = NextNeighbor(&it, &curWeight)) != -1)
+  {
+    if (dest == curDest)  // candidate edge:
+    {
+      if (!haveEdge) // first edge:
+      {
+        haveEdge = 1;  /*true*/
+        weight = curWeight;
+      }
+      else if (curWeight < weight)  // multi-edge:
+      {
+        weight = curWeight;  // smaller, so update:
+      }
+    }
+    else if (dest < curDest && it.Kind != NEIGHBORS_HYPER &&
+             it.Kind != NEIGHBORS_IMPLICIT)  // out of order, end search:
+      break;
+  }
+
+  //
+  // did we find an edge?  make sure...
+  //
+  if (!haveEdge)
+  {
+    printf("\n**Error in getEdgeWeight: no edge found from %d to %d.\n\n", src, dest);
+    exit(-1);
+  }
+
+  //
+  // success:
+  //
+  return weight;
+}
+
+
+//
+// PopMin:
+//
+// Removes and returns the vertex of the queue with the smallest
+// distance, by a linear search of the queue.  (Dijkstra now uses
+// a bucket queue instead, see search.c.)
+//
+int PopMin(Queue *unvisitedQ, int distance[])
+{
+  int    N = unvisitedQ->NumElements;
+  Stack *S = CreateStack(N);
+
+  assert(!isEmptyQueue(unvisitedQ));
+
+  //
+  // search for smallest vertex distance in the queue,
+  // saving other elements in a stack so we can put back
+  // later:
+  //
+  int minV = Dequeue(unvisitedQ);  // assume first vertex is the min:
+
+  while (!isEmptyQueue(unvisitedQ))  // look for smaller vertex:
+  {
+    int v = Dequeue(unvisitedQ);
+
+    if (distance[v] < distance[minV])
+    {
+      Push(S, minV);  // save so we can put back in queue:
+      minV = v;  // our new min:
+    }
+    else  // not smaller, so save to enqueue later:
+    {
+      Push(S, v);
+    }
+  }
+
+  //
+  // empty the stack back into the queue:
+  //
+  while (!isEmptyStack(S))
+  {
+    Enqueue(unvisitedQ, Pop(S));
+  }
+
+  // NOTE: at this point queue is now one smaller, with
+  // min element removed.  Let's confirm:
+  assert(unvisitedQ->NumElements == (N - 1));
+
+  //
+  // done:
+  //
+  DeleteStack(S);
+
+  return minV;
+}
+
+
+//
+// Performs Dijkstra's shortest path algorithm to find the shortest path
+// from src to dest.  Returns a dynamically-allocated array of vertices
+// denoting this path; the array will start with src, contain 0 or more
+// vertices that lead to dest, followed by dest, and ending with -1.
+// If there is no pat from src to dest, the array will contain only -1.
+// The edge weights are small, so the search runs on a bucket queue
+// (see search.c); call WeightedShortestPath directly to reuse one
+// workspace across many searches.
+//
+// NOTE: returns NULL if src or dest are not valid vertex ids.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *Dijkstra(Graph *G, Vertex src, Vertex dest)
+{
+  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+  if (dest < 0 || dest >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  if (G->Hyper != NULL && G->Cost == NULL)  // unweighted, so BFS through the patterns:
+    return HyperShortestPath(G, src, dest);
+
+  SearchWorkspace *W = CreateWorkspace(G);
+  Vertex          *path = WeightedShortestPath(G, W, src, dest);
+
+  DeleteWorkspace(W);
+
+  return path;
+}
@@ -1,45 +1,123 @@
-/*graph.h*/
-
-//
-// Graph:
-//
-#include "queue.h"
-typedef int Vertex;
-
-
-typedef struct Edge
-{
-  Vertex  src;
-  Vertex  dest;
-  int     weight;
-  struct Edge *next;
-} Edge;
-
-typedef struct Graph
-{
-  Edge    **Vertices;
-  char    **Names;
-  int       NumVertices;
-  int       NumEdges;
-  int       Capacity;
-  AVLNode *NamesTree;
-} Graph;
-
-Graph  *CreateGraph(int N);
-void    DeleteGraph(Graph *G);
-int     AddVertex(Graph *G, char *name);
-int     Name2Vertex(Graph *G, char *Name);
-char   *Vertex2Name(Graph *G, Vertex v);
-int     AddEdge(Graph *G, Vertex src, Vertex dest, int weight);
-
-Vertex *Neighbors(Graph *G, Vertex v);
-void    PrintGraph(Graph *G, char *title, int complete);
-Vertex *BFS(Graph *G, Vertex v);
-Vertex *BFSd(Graph *G, Vertex v, int distance);
-Vertex *DFS(Graph *G, Vertex v);
-
-
-
-int getEdgeWeight(Graph *G, Vertex src, Vertex dest);
-int PopMin(Queue *unvisitedQ, int distance[]);
-Vertex *Dijkstra(Graph *G, Vertex src, Vertex dest);
+/*graph.h*/
+
+//
+// Graph:
+//
+#include "queue.h"
+typedef int Vertex;
+
+//
+// NOTE: include "wordkey.h" before this file.
+//
+
+
+typedef struct Edge
+{
+  Vertex  src;
+  Vertex  dest;
+  int     weight;
+  struct Edge *next;
+} Edge;
+
+typedef struct KeySlot  // entry in the hash table of packed keys:
+{
+  WordKey  Key;
+  Vertex   V;
+} KeySlot;
+
+#define NEIGHBORS_LISTS       0  // kinds of neighbor iteration:
+#define NEIGHBORS_COMPRESSED  1
+#define NEIGHBORS_HYPER       2
+#define NEIGHBORS_IMPLICIT    3
+
+typedef struct NeighborIter  // see BeginNeighbors:
+{
+  struct Graph  *G;
+  Vertex         Src;
+  int            Kind;        // NEIGHBORS_ kind, from how G is stored
+  Edge          *Cur;         // adjacency list: next edge
+  unsigned char *Pos;         // compressed: next byte to decode
+  int            Remaining;   // compressed: # of neighbors left
+  int            First;       // compressed: next is the first?
+  int            Weighted;    // compressed: weights stored?
+  Vertex         Last;        // compressed: previous neighbor
+  int            PatternPos;  // hypergraph: next of Src's patterns
+  int            PatternEnd;
+  int            MemberPos;   // hypergraph: next word of the pattern
+  int            MemberEnd;
+  int            Position;    // implicit: position being changed
+  int            Letter;      // implicit: next letter to try there
+  int            Length;      // implicit: length of Src's name
+  Vertex         Batch[26];   // implicit: letter changes at Position,
+  int            BatchPos;    //   looked up together (see Keys2Vertices)
+  int            BatchLen;
+} NeighborIter;
+
+typedef struct Shard  // all the words of one length:
+{
+  int       NumWords;
+  Vertex   *Words;         // vertex #s, ascending
+  WordKey  *Keys;          // Keys[i] is the packed key of Words[i]
+  char    **Alphabet;      // Alphabet[i]: the chars found at position i
+  char    **IndexNames;    // the names in Eytzinger order, 1..NumWords,
+  Vertex   *IndexWords;    //   with their vertex #s (see eytzinger.c)
+} Shard;
+
+typedef int (*CostFunction)(struct Graph *G, Vertex v, Vertex w, void *context);
+
+typedef struct Graph
+{
+  Edge    **Vertices;
+  char    **Names;
+  WordKey  *Keys;          // packed key of each name (or WORDKEY_NONE)
+  unsigned int *LetterMask; // bit c-'a' set => the name has letter c
+  int       NumVertices;
+  int       NumEdges;
+  int       NumEditEdges;  // of which insert/delete a letter (AddEditEdges)
+  int       Capacity;
+  KeySlot  *KeyTable;      // open addressing, V == -1 => empty slot
+  int       KeyTableBits;  // table holds 2^KeyTableBits slots
+  int       NumKeys;
+  Shard    *Shards;        // Shards[L] holds the words of length L
+  int       MaxLength;     // (NULL until BuildShards is called)
+  int       NumSharded;    // vertices 0..NumSharded-1 are in the shards
+  Vertex   *Original;      // vertex # before relabeling (NULL if never)
+  struct CompressedAdj *Compressed;  // if not NULL, read instead of lists
+  struct Hypergraph    *Hyper;       // if not NULL, used instead of edges
+  int                   Implicit;    // true => neighbors generated on demand
+  struct LazyShards    *Lazy;        // if not NULL, edges built per shard
+  struct BloomFilter   *Filter;      // if not NULL, checked before unpacked name lookups
+  struct PatternIndex  *Patterns;    // if not NULL, bitmaps for BeginPattern
+  struct Suggester     *Suggest;     // if not NULL, deletion index for Suggest
+  struct ComponentIndex *Components; // if not NULL, for ClosestReachable
+  CostFunction          Cost;        // if not NULL, cost of each step (see cost.c)
+  void                 *CostCtx;
+  int                   MaxWeight;   // no edge weighs more
+} Graph;
+
+Graph  *CreateGraph(int N);
+void    DeleteGraph(Graph *G);
+int     AddVertex(Graph *G, char *name);
+int     Name2Vertex(Graph *G, char *Name);
+int     Variant2Vertex(Graph *G, char *word, int pos, char c);
+Vertex *WordsWithPrefix(Graph *G, char *prefix);
+int     Key2Vertex(Graph *G, WordKey key);
+void    Keys2Vertices(Graph *G, WordKey *keys, int n, Vertex *vertices);
+char   *Vertex2Name(Graph *G, Vertex v);
+int     AddEdge(Graph *G, Vertex src, Vertex dest, int weight);
+
+void    BuildShards(Graph *G);
+void    BeginNeighbors(Graph *G, Vertex v, NeighborIter *it);
+Vertex  NextNeighbor(NeighborIter *it, int *weight);
+Vertex *Neighbors(Graph *G, Vertex v);
+Vertex *ScanNeighbors(Graph *G, Vertex v);
+void    PrintGraph(Graph *G, char *title, int complete);
+Vertex *BFS(Graph *G, Vertex v);
+Vertex *BFSd(Graph *G, Vertex v, int distance);
+Vertex *DFS(Graph *G, Vertex v);
+
+
+
+int getEdgeWeight(Graph *G, Vertex src, Vertex dest);
+int PopMin(Queue *unvisitedQ, int distance[]);
+Vertex *Dijkstra(Graph *G, Vertex src, Vertex dest);
@@ -0,0 +1,253 @@
+/*hamming.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "hamming.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HAMMING_X86
+#include <immintrin.h>
+#endif
+
+
+// #####################################################
+//
+// Hamming scan:
+//
+// Compares a query key against an array of keys and reports the
+// indices of the keys at Hamming distance exactly 1, i.e. the same
+// length and exactly one differing letter.  For each key the test
+// is branch-free: xor with the query, fold each 5-bit letter onto
+// its low bit, then "exactly one bit set" <=> d != 0 && (d & (d-1))
+// == 0.  The SSE4.1 and AVX2 kernels do the same test on 2 and 4
+// keys at a time; the kernel is chosen at runtime from the CPU's
+// features (CPUID) the first time HammingScan is called.
+//
+
+typedef int (*HammingKernel)(WordKey *keys, int n, WordKey query, int *out);
+
+//
+// _scanRange:
+//
+// Scalar scan of keys[start..n-1], storing matching indices into
+// out[] and returning the # of matches.
+//
+static int _scanRange(WordKey *keys, int start, int n, WordKey query, int *out)
+{
+  int count = 0;
+  int i;
+
+  for (i = start; i < n; ++i)
+  {
+    WordKey x = keys[i] ^ query;
+    WordKey d = (x | (x >> 1) | (x >> 2) | (x >> 3) | (x >> 4)) & WORDKEY_LOWBITS;
+
+    if ((x >> WORDKEY_LENSHIFT) == 0 && d != 0 && (d & (d - 1)) == 0)
+    {
+      out[count] = i;
+      count++;
+    }
+  }
+
+  return count;
+}
+
+static int _scanScalar(WordKey *keys, int n, WordKey query, int *out)
+{
+  return _scanRange(keys, 0, n, query, out);
+}
+
+#ifdef HAMMING_X86
+
+//
+// _scanSSE41:
+//
+__attribute__((target("sse4.1")))
+static int _scanSSE41(WordKey *keys, int n, WordKey query, int *out)
+{
+  __m128i q = _mm_set1_epi64x((long long)query);
+  __m128i low = _mm_set1_epi64x((long long)WORDKEY_LOWBITS);
+  __m128i one = _mm_set1_epi64x(1);
+  __m128i zero = _mm_setzero_si128();
+  int     count = 0;
+  int     i;
+
+  for (i = 0; i + 2 <= n; i += 2)
+  {
+    __m128i x = _mm_xor_si128(_mm_loadu_si128((__m128i *)&keys[i]), q);
+
+    __m128i d = _mm_or_si128(x, _mm_srli_epi64(x, 1));
+    d = _mm_or_si128(d, _mm_srli_epi64(x, 2));
+    d = _mm_or_si128(d, _mm_srli_epi64(x, 3));
+    d = _mm_or_si128(d, _mm_srli_epi64(x, 4));
+    d = _mm_and_si128(d, low);
+
+    __m128i single = _mm_cmpeq_epi64(_mm_and_si128(d, _mm_sub_epi64(d, one)), zero);
+    __m128i none = _mm_cmpeq_epi64(d, zero);
+    __m128i sameLen = _mm_cmpeq_epi64(_mm_srli_epi64(x, WORDKEY_LENSHIFT), zero);
+    __m128i match = _mm_andnot_si128(none, _mm_and_si128(single, sameLen));
+
+    int mask = _mm_movemask_pd(_mm_castsi128_pd(match));
+
+    while (mask != 0)
+    {
+      out[count] = i + __builtin_ctz(mask);
+      count++;
+      mask &= mask - 1;
+    }
+  }
+
+  return count + _scanRange(keys, i, n, query, out + count);
+}
+
+//
+// _scanAVX2:
+//
+__attribute__((target("avx2")))
+static int _scanAVX2(WordKey *keys, int n, WordKey query, int *out)
+{
+  __m256i q = _mm256_set1_epi64x((long long)query);
+  __m256i low = _mm256_set1_epi64x((long long)WORDKEY_LOWBITS);
+  __m256i one = _mm256_set1_epi64x(1);
+  __m256i zero = _mm256_setzero_si256();
+  int     count = 0;
+  int     i;
+
+  for (i = 0; i + 4 <= n; i += 4)
+  {
+    __m256i x = _mm256_xor_si256(_mm256_loadu_si256((__m256i *)&keys[i]), q);
+
+    __m256i d = _mm256_or_si256(x, _mm256_srli_epi64(x, 1));
+    d = _mm256_or_si256(d, _mm256_srli_epi64(x, 2));
+    d = _mm256_or_si256(d, _mm256_srli_epi64(x, 3));
+    d = _mm256_or_si256(d, _mm256_srli_epi64(x, 4));
+    d = _mm256_and_si256(d, low);
+
+    __m256i single = _mm256_cmpeq_epi64(_mm256_and_si256(d, _mm256_sub_epi64(d, one)), zero);
+    __m256i none = _mm256_cmpeq_epi64(d, zero);
+    __m256i sameLen = _mm256_cmpeq_epi64(_mm256_srli_epi64(x, WORDKEY_LENSHIFT), zero);
+    __m256i match = _mm256_andnot_si256(none, _mm256_and_si256(single, sameLen));
+
+    int mask = _mm256_movemask_pd(_mm256_castsi256_pd(match));
+
+    while (mask != 0)
+    {
+      out[count] = i + __builtin_ctz(mask);
+      count++;
+      mask &= mask - 1;
+    }
+  }
+
+  return count + _scanRange(keys, i, n, query, out + count);
+}
+
+#endif
+
+//
+// the kernels, best last:
+//
+static struct
+{
+  char          *Name;
+  HammingKernel  Kernel;
+} g_kernels[] =
+{
+  { "scalar", _scanScalar },
+#ifdef HAMMING_X86
+  { "sse4.1", _scanSSE41 },
+  { "avx2",   _scanAVX2 },
+#endif
+};
+
+static int g_numKernels = sizeof(g_kernels) / sizeof(g_kernels[0]);
+static int g_kernel = -1;  // -1 => not chosen yet
+
+//
+// _supported:
+//
+// Returns true (non-zero) if this CPU can run the ith kernel.
+//
+static int _supported(int i)
+{
+#ifdef HAMMING_X86
+  __builtin_cpu_init();
+
+  if (strcmp(g_kernels[i].Name, "sse4.1") == 0)
+    return __builtin_cpu_supports("sse4.1");
+  if (strcmp(g_kernels[i].Name, "avx2") == 0)
+    return __builtin_cpu_supports("avx2");
+#endif
+
+  return 1;  // scalar
+}
+
+static void _chooseKernel()
+{
+  int i;
+
+  g_kernel = 0;
+
+  for (i = 0; i < g_numKernels; ++i)
+  {
+    if (_supported(i))
+      g_kernel = i;
+  }
+}
+
+//
+// HammingScan:
+//
+// Scans the n keys for those at Hamming distance exactly 1 from
+// query, storing their indices (ascending) into out[], which must
+// have room for n indices.  Returns the # of indices stored.
+//
+int HammingScan(WordKey *keys, int n, WordKey query, int *out)
+{
+  if (g_kernel < 0)
+    _chooseKernel();
+
+  return g_kernels[g_kernel].Kernel(keys, n, query, out);
+}
+
+//
+// HammingKernelName:
+//
+// Returns the name of the kernel HammingScan uses.
+//
+char *HammingKernelName()
+{
+  if (g_kernel < 0)
+    _chooseKernel();
+
+  return g_kernels[g_kernel].Name;
+}
+
+//
+// SetHammingKernel:
+//
+// Makes HammingScan use the named kernel ("scalar", "sse4.1" or
+// "avx2"), e.g. for benchmarking.  Returns true (non-zero) if
+// successful, false (0) if the kernel is unknown or not supported
+// by this CPU.
+//
+int SetHammingKernel(char *name)
+{
+  int i;
+
+  for (i = 0; i < g_numKernels; ++i)
+  {
+    if (strcmp(g_kernels[i].Name, name) == 0 && _supported(i))
+    {
+      g_kernel = i;
+      return 1;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,10 @@
+/*hamming.h*/
+
+//
+// Hamming-distance-1 scan over packed keys:
+//
+// NOTE: include "wordkey.h" before this file.
+//
+int   HammingScan(WordKey *keys, int n, WordKey query, int *out);
+char *HammingKernelName();
+int   SetHammingKernel(char *name);
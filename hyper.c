@@ -0,0 +1,628 @@
+/*hyper.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "hyper.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Hypergraph:
+//
+// All the words matching a one-wildcard pattern such as "c?t" are
+// pairwise adjacent, so materializing edges costs k*(k-1) edges
+// for a pattern of k words.  The hypergraph instead stores, for
+// each pattern with at least 2 words, its list of words, and for
+// each word the list of its patterns: O(V x L) memberships in all.
+// Two words are adjacent iff they share a pattern.
+//
+// The searches below expand a word by expanding each of its
+// patterns, and each pattern is expanded at most once per search:
+// once its words have all been discovered there is nothing more
+// to find through it, no matter how many of them are dequeued.
+//
+
+//
+// _patternHash:
+//
+// Hash of v's name with position pos wildcarded (FNV-1a).
+//
+static unsigned long long _patternHash(char *name, int pos)
+{
+  unsigned long long h = 14695981039346656037ULL;
+  int                i;
+
+  for (i = 0; name[i] != '\0'; ++i)
+  {
+    h ^= (i == pos) ? 0xFF : (unsigned char)name[i];
+    h *= 1099511628211ULL;
+  }
+
+  h ^= (unsigned long long)pos << 32;
+  h *= 1099511628211ULL;
+
+  return h;
+}
+
+//
+// _samePattern:
+//
+// Returns true (non-zero) if name1 and name2, both with position
+// pos wildcarded, are the same pattern.
+//
+static int _samePattern(char *name1, char *name2, int pos)
+{
+  if (strlen(name1) != strlen(name2))
+    return 0;
+
+  return strncmp(name1, name2, pos) == 0 && strcmp(name1 + pos + 1, name2 + pos + 1) == 0;
+}
+
+//
+// BuildHypergraph:
+//
+// Builds G->Hyper from the names in G; no edges are needed.  Once
+// built, BFS, BFSd and Dijkstra run on the hypergraph, and the
+// neighbor iterator enumerates neighbors through it.
+//
+void BuildHypergraph(Graph *G)
+{
+  int        N = G->NumVertices;
+  long long  total = 0;
+  Vertex     v;
+  int        i;
+
+  if (G->Hyper != NULL)
+  {
+    DeleteHypergraph(G->Hyper);
+    G->Hyper = NULL;
+  }
+
+  //
+  // (1) give each (word, position) an id for its pattern: patterns
+  // are found through an open addressing table of pattern ids, each
+  // represented by the first word and position that had it:
+  //
+  int *first = (int *)mymalloc((N + 1) * sizeof(int));  // v's (word, position) ids start here:
+
+  for (v = 0; v < N; ++v)
+  {
+    first[v] = (int)total;
+    total += strlen(G->Names[v]);
+  }
+  first[N] = (int)total;
+
+  int *patternOf = (int *)mymalloc((unsigned int)(total + 1) * sizeof(int));
+  Vertex *repWord = (Vertex *)mymalloc((unsigned int)(total + 1) * sizeof(Vertex));
+  int *repPos = (int *)mymalloc((unsigned int)(total + 1) * sizeof(int));
+  int *count = (int *)mymalloc((unsigned int)(total + 1) * sizeof(int));
+
+  int bits = 1;
+  while ((1LL << bits) < 2 * total + 2)
+    bits++;
+
+  unsigned int mask = (1u << bits) - 1;
+  int *table = (int *)mymalloc((mask + 1) * sizeof(int));
+
+  if (first == NULL || patternOf == NULL || repWord == NULL || repPos == NULL ||
+      count == NULL || table == NULL)
+  {
+    printf("\n**Error in BuildHypergraph: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  memset(table, -1, (mask + 1) * sizeof(int));
+
+  int numPatterns = 0;
+
+  for (v = 0; v < N; ++v)
+  {
+    char *name = G->Names[v];
+    int   len = first[v + 1] - first[v];
+
+    for (i = 0; i < len; ++i)
+    {
+      unsigned int h = (unsigned int)(_patternHash(name, i) >> (64 - bits));
+
+      while (table[h] != -1)
+      {
+        int p = table[h];
+
+        if (repPos[p] == i && _samePattern(G->Names[repWord[p]], name, i))
+          break;
+
+        h = (h + 1) & mask;
+      }
+
+      if (table[h] == -1)  // new pattern:
+      {
+        table[h] = numPatterns;
+        repWord[numPatterns] = v;
+        repPos[numPatterns] = i;
+        count[numPatterns] = 0;
+        numPatterns++;
+      }
+
+      patternOf[first[v] + i] = table[h];
+      count[table[h]]++;
+    }
+  }
+
+  myfree(table);
+  myfree(repWord);
+
+  //
+  // (2) keep only patterns with 2+ words --- the others link
+  // nothing --- renumbering them densely:
+  //
+  int *newId = count;  // reuse: count[p] becomes p's new id or -1
+  int  numKept = 0;
+
+  Hypergraph *H = (Hypergraph *)mymalloc(sizeof(Hypergraph));
+  if (H == NULL)
+  {
+    printf("\n**Error in BuildHypergraph: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  int *size = (int *)mymalloc((numPatterns + 1) * sizeof(int));
+
+  for (i = 0; i < numPatterns; ++i)
+  {
+    if (count[i] >= 2)
+    {
+      size[numKept] = count[i];
+      newId[i] = numKept;
+      numKept++;
+    }
+    else
+      newId[i] = -1;
+  }
+
+  H->NumVertices = N;
+  H->NumPatterns = numKept;
+  H->PatternStart = (int *)mymalloc((numKept + 1) * sizeof(int));
+  H->PatternPos = (int *)mymalloc((numKept + 1) * sizeof(int));
+  H->WordStart = (int *)mymalloc((N + 1) * sizeof(int));
+
+  for (i = 0; i < numPatterns; ++i)
+  {
+    if (newId[i] >= 0)
+      H->PatternPos[newId[i]] = repPos[i];
+  }
+
+  myfree(repPos);
+
+  long long memberships = 0;
+
+  for (i = 0; i < numKept; ++i)
+  {
+    H->PatternStart[i] = (int)memberships;
+    memberships += size[i];
+  }
+  H->PatternStart[numKept] = (int)memberships;
+  H->NumMemberships = memberships;
+
+  H->WordPatterns = (int *)mymalloc((unsigned int)(memberships + 1) * sizeof(int));
+  H->PatternWords = (Vertex *)mymalloc((unsigned int)(memberships + 1) * sizeof(Vertex));
+  if (H->PatternStart == NULL || H->PatternPos == NULL || H->WordStart == NULL ||
+      H->WordPatterns == NULL || H->PatternWords == NULL)
+  {
+    printf("\n**Error in BuildHypergraph: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  //
+  // (3) fill both directions; words are visited in ascending order,
+  // so each pattern's words come out ascending:
+  //
+  int next = 0;
+
+  for (i = 0; i < numKept; ++i)
+    size[i] = H->PatternStart[i];  // reuse: next free slot of pattern i
+
+  for (v = 0; v < N; ++v)
+  {
+    H->WordStart[v] = next;
+
+    for (i = first[v]; i < first[v + 1]; ++i)
+    {
+      int p = newId[patternOf[i]];
+
+      if (p < 0)
+        continue;
+
+      H->WordPatterns[next++] = p;
+      H->PatternWords[size[p]++] = v;
+    }
+  }
+  H->WordStart[N] = next;
+
+  myfree(size);
+  myfree(count);
+  myfree(patternOf);
+  myfree(first);
+
+  //
+  // (4) and a table to find the kept patterns by pattern string,
+  // for FindPattern:
+  //
+  H->TableBits = 1;
+  while ((1LL << H->TableBits) < 2LL * numKept + 2)
+    H->TableBits++;
+
+  mask = (1u << H->TableBits) - 1;
+  H->Table = (int *)mymalloc((mask + 1) * sizeof(int));
+  if (H->Table == NULL)
+  {
+    printf("\n**Error in BuildHypergraph: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  memset(H->Table, -1, (mask + 1) * sizeof(int));
+
+  for (i = 0; i < numKept; ++i)
+  {
+    char        *name = G->Names[H->PatternWords[H->PatternStart[i]]];
+    unsigned int h = (unsigned int)(_patternHash(name, H->PatternPos[i]) >> (64 - H->TableBits));
+
+    while (H->Table[h] != -1)
+      h = (h + 1) & mask;
+
+    H->Table[h] = i;
+  }
+
+  G->Hyper = H;
+}
+
+//
+// FindPattern:
+//
+// Returns the id of the pattern formed by the given word with
+// position pos wildcarded (whatever character it has there), or -1
+// if fewer than 2 words match it.
+//
+int FindPattern(Graph *G, char *word, int pos)
+{
+  Hypergraph  *H = G->Hyper;
+  unsigned int mask = (1u << H->TableBits) - 1;
+  unsigned int h = (unsigned int)(_patternHash(word, pos) >> (64 - H->TableBits));
+
+  while (H->Table[h] != -1)
+  {
+    int p = H->Table[h];
+
+    if (H->PatternPos[p] == pos &&
+        _samePattern(G->Names[H->PatternWords[H->PatternStart[p]]], word, pos))
+      return p;
+
+    h = (h + 1) & mask;
+  }
+
+  return -1;
+}
+
+//
+// DeleteHypergraph:
+//
+void DeleteHypergraph(Hypergraph *H)
+{
+  myfree(H->WordStart);
+  myfree(H->WordPatterns);
+  myfree(H->PatternStart);
+  myfree(H->PatternPos);
+  myfree(H->PatternWords);
+  myfree(H->Table);
+  myfree(H);
+}
+
+//
+// HypergraphBytes:
+//
+// Returns the # of bytes used by the hypergraph's arrays.
+//
+long long HypergraphBytes(Hypergraph *H)
+{
+  return 2 * H->NumMemberships * (long long)sizeof(int) +
+         2 * (H->NumPatterns + 1) * (long long)sizeof(int) +
+         (H->NumVertices + 1) * (long long)sizeof(int) +
+         (1LL << H->TableBits) * (long long)sizeof(int);
+}
+
+//
+// HypergraphImpliedEdges:
+//
+// Returns the # of (directed) edges the patterns stand for, i.e.
+// what materializing them would cost.
+//
+long long HypergraphImpliedEdges(Hypergraph *H)
+{
+  long long edges = 0;
+  int       p;
+
+  for (p = 0; p < H->NumPatterns; ++p)
+  {
+    long long k = H->PatternStart[p + 1] - H->PatternStart[p];
+
+    edges += k * (k - 1);
+  }
+
+  return edges;
+}
+
+//
+// HyperFirst:
+//
+// Positions the iterator before v's first pattern.
+//
+void HyperFirst(Hypergraph *H, Vertex v, NeighborIter *it)
+{
+  it->PatternPos = H->WordStart[v];
+  it->PatternEnd = H->WordStart[v + 1];
+  it->MemberPos = 0;
+  it->MemberEnd = 0;
+}
+
+//
+// HyperNext:
+//
+// Returns the next word sharing a pattern with the iterator's
+// source, or -1 if there are no more.  Neighbors come pattern by
+// pattern, so they are not in ascending order overall.
+//
+Vertex HyperNext(NeighborIter *it)
+{
+  Hypergraph *H = it->G->Hyper;
+
+  while (1)
+  {
+    while (it->MemberPos < it->MemberEnd)
+    {
+      Vertex w = H->PatternWords[it->MemberPos++];
+
+      if (w != it->Src)
+        return w;
+    }
+
+    if (it->PatternPos == it->PatternEnd)  // no more patterns:
+      return -1;
+
+    int p = H->WordPatterns[it->PatternPos++];
+
+    it->MemberPos = H->PatternStart[p];
+    it->MemberEnd = H->PatternStart[p + 1];
+  }
+}
+
+static int _compareVertices(const void *a, const void *b)
+{
+  Vertex v1 = *(const Vertex *)a;
+  Vertex v2 = *(const Vertex *)b;
+
+  return (v1 > v2) - (v1 < v2);
+}
+
+//
+// _hyperSearch:
+//
+// BFS from v through the patterns, level by level, for at most
+// maxDepth levels (all if < 0), stopping once dest (if >= 0) is
+// discovered.  The vertices discovered from each dequeued vertex
+// are enqueued in ascending order, so the order matches BFS().
+// If markers is true, a -1 follows each level, maxDepth+1 in all,
+// as in BFSd().  If pred is not NULL, pred[w] is set to the vertex
+// w was discovered from.  Returns the -1 terminated visit order.
+//
+static Vertex *_hyperSearch(Graph *G, Vertex v, int maxDepth, int markers,
+                            Vertex dest, Vertex *pred)
+{
+  Hypergraph    *H = G->Hyper;
+  int            N = G->NumVertices;
+  Vertex        *visited = (Vertex *)mymalloc((N + (markers ? maxDepth + 1 : 0) + 1) * sizeof(Vertex));
+  unsigned char *discovered = (unsigned char *)mymalloc(N + 1);
+  unsigned char *expanded = (unsigned char *)mymalloc(H->NumPatterns + 1);
+
+  if (visited == NULL || discovered == NULL || expanded == NULL)
+  {
+    printf("\n**Error in HyperBFS: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  memset(discovered, 0, N);
+  memset(expanded, 0, H->NumPatterns);
+
+  discovered[v] = 1;
+  if (pred != NULL)
+    pred[v] = -1;
+
+  visited[0] = v;
+
+  int i = 1;            // where the next vertex goes:
+  int levelStart = 0;   // the level being expanded is visited[levelStart..levelEnd-1]
+  int levelEnd = 1;
+  int depth = 0;
+  int found = (v == dest);
+
+  if (markers)
+  {
+    visited[i] = -1;
+    ++i;
+  }
+
+  while (levelEnd > levelStart && (maxDepth < 0 || depth < maxDepth) && !found)
+  {
+    int nextStart = i;
+    int k;
+
+    for (k = levelStart; k < levelEnd && !found; ++k)
+    {
+      Vertex u = visited[k];
+      int    from = i;
+      int    j;
+
+      for (j = H->WordStart[u]; j < H->WordStart[u + 1]; ++j)
+      {
+        int p = H->WordPatterns[j];
+
+        if (expanded[p])  // its words are all discovered already:
+          continue;
+
+        expanded[p] = 1;
+
+        int m;
+        for (m = H->PatternStart[p]; m < H->PatternStart[p + 1]; ++m)
+        {
+          Vertex w = H->PatternWords[m];
+
+          if (!discovered[w])
+          {
+            discovered[w] = 1;
+            if (pred != NULL)
+              pred[w] = u;
+            if (w == dest)
+              found = 1;
+
+            visited[i] = w;
+            ++i;
+          }
+        }
+      }
+
+      qsort(&visited[from], i - from, sizeof(Vertex), _compareVertices);
+    }
+
+    levelStart = nextStart;
+    levelEnd = i;
+    depth++;
+
+    if (markers)
+    {
+      visited[i] = -1;
+      ++i;
+    }
+  }
+
+  if (markers)  // always maxDepth+1 markers:
+  {
+    while (depth < maxDepth)
+    {
+      visited[i] = -1;
+      ++i;
+      depth++;
+    }
+  }
+
+  visited[i] = -1;
+
+  myfree(discovered);
+  myfree(expanded);
+
+  return visited;
+}
+
+//
+// HyperBFS:
+//
+// Same as BFS(), but on the hypergraph.
+//
+Vertex *HyperBFS(Graph *G, Vertex v)
+{
+  if (v < 0 || v >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  return _hyperSearch(G, v, -1, 0 /*false*/, -1, NULL);
+}
+
+//
+// HyperBFSd:
+//
+// Same as BFSd(), but on the hypergraph.
+//
+Vertex *HyperBFSd(Graph *G, Vertex v, int distance)
+{
+  if (v < 0 || v >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  if (distance < 1)
+    return NULL;
+
+  return _hyperSearch(G, v, distance, 1 /*true*/, -1, NULL);
+}
+
+//
+// HyperShortestPath:
+//
+// Returns a shortest ladder from src to dest on the hypergraph, in
+// the same format as Dijkstra(): src, ..., dest, -1, or just -1 if
+// there is no path.
+//
+// NOTE: returns NULL if src or dest are not valid vertex ids.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *HyperShortestPath(Graph *G, Vertex src, Vertex dest)
+{
+  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+  if (dest < 0 || dest >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  Vertex *pred = (Vertex *)mymalloc(G->NumVertices * sizeof(Vertex));
+  if (pred == NULL)
+  {
+    printf("\n**Error in HyperShortestPath: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  Vertex *visited = _hyperSearch(G, src, -1, 0 /*false*/, dest, pred);
+
+  //
+  // was dest reached?  if so, walk back to src:
+  //
+  int reached = 0;  /*false*/
+  int length = 0;
+  int i;
+
+  for (i = 0; visited[i] != -1; ++i)
+  {
+    if (visited[i] == dest)
+      reached = 1;  /*true*/
+  }
+
+  Vertex *path;
+
+  if (!reached || src == dest)
+  {
+    path = (Vertex *)mymalloc(sizeof(Vertex));
+    path[0] = -1;  // no path from src to dest:
+  }
+  else
+  {
+    Vertex v;
+
+    for (v = dest; v != -1; v = pred[v])
+      length++;
+
+    path = (Vertex *)mymalloc((length + 1) * sizeof(Vertex));
+
+    i = length - 1;
+    for (v = dest; v != -1; v = pred[v])
+      path[i--] = v;
+
+    path[length] = -1;
+  }
+
+  myfree(visited);
+  myfree(pred);
+
+  return path;
+}
@@ -0,0 +1,33 @@
+/*hyper.h*/
+
+//
+// Word-pattern hypergraph:
+//
+// NOTE: include "graph.h" before this file.
+//
+typedef struct Hypergraph
+{
+  int        NumVertices;
+  int        NumPatterns;
+  long long  NumMemberships;
+  int       *WordStart;      // v's patterns: WordPatterns[WordStart[v]..WordStart[v+1]-1]
+  int       *WordPatterns;
+  int       *PatternStart;   // p's words: PatternWords[PatternStart[p]..PatternStart[p+1]-1]
+  Vertex    *PatternWords;   // (ascending)
+  int       *PatternPos;     // position of p's wildcard
+  int       *Table;          // pattern ids by hash, -1 => empty (see FindPattern)
+  int        TableBits;
+} Hypergraph;
+
+void       BuildHypergraph(Graph *G);
+void       DeleteHypergraph(Hypergraph *H);
+long long  HypergraphBytes(Hypergraph *H);
+long long  HypergraphImpliedEdges(Hypergraph *H);
+int        FindPattern(Graph *G, char *word, int pos);
+
+void       HyperFirst(Hypergraph *H, Vertex v, NeighborIter *it);
+Vertex     HyperNext(NeighborIter *it);
+
+Vertex    *HyperBFS(Graph *G, Vertex v);
+Vertex    *HyperBFSd(Graph *G, Vertex v, int distance);
+Vertex    *HyperShortestPath(Graph *G, Vertex src, Vertex dest);
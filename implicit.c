@@ -0,0 +1,144 @@
+/*implicit.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "implicit.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Implicit neighbors:
+//
+// AddEdges spends most of the startup time finding neighbors that
+// a given run may never ask for.  In implicit mode no edges are
+// stored at all: the neighbor iterator generates the one-letter
+// variants of a word as it goes, exactly the candidates AddEdges
+// would probe, and returns those that are words.  Startup is just
+// loading the names, and every search works unchanged through the
+// iterator, but each expansion now costs a lookup per character
+// of the alphabet at each position instead of a walk down a list.
+//
+
+//
+// UseImplicitEdges:
+//
+// Switches G to implicit mode: from now on the neighbors of a word
+// are generated on demand (see BeginNeighbors), so AddEdges need
+// not be called.  Any edges already added are ignored.
+//
+void UseImplicitEdges(Graph *G)
+{
+  G->Implicit = 1;  /*true*/
+}
+
+//
+// _batchLetters:
+//
+// For a packable source, looks up the changes of position
+// it->Position to each other letter 'a'..'z' of the alphabet there,
+// all at once, into it->Batch.
+//
+static void _batchLetters(NeighborIter *it)
+{
+  Graph  *G = it->G;
+  WordKey key = G->Keys[it->Src];
+  char   *alphabet = G->Shards[it->Length].Alphabet[it->Position];
+  int     own = KeyLetter(key, it->Position);
+  WordKey candidates[26];
+  int     n = 0;
+  char   *c;
+
+  for (c = alphabet; *c != '\0'; ++c)
+  {
+    if (*c >= 'a' && *c <= 'z' && *c - 'a' + 1 != own)
+      candidates[n++] = KeySetLetter(key, it->Position, *c);
+  }
+
+  Keys2Vertices(G, candidates, n, it->Batch);
+
+  it->BatchPos = 0;
+  it->BatchLen = n;
+}
+
+//
+// ImplicitFirst:
+//
+// Positions the iterator before v's first candidate variant.
+//
+void ImplicitFirst(Graph *G, Vertex v, NeighborIter *it)
+{
+  it->Position = 0;
+  it->Letter = 0;
+  it->Length = (int)strlen(G->Names[v]);
+  it->BatchPos = 0;
+  it->BatchLen = 0;
+
+  if (G->Keys[v] != WORDKEY_NONE && it->Length > 0)
+    _batchLetters(it);
+}
+
+//
+// ImplicitNext:
+//
+// Returns the next word that differs from the iterator's source by
+// one letter, or -1 if there are no more.  Variants are generated
+// position by position, trying the characters of the shard's
+// alphabet at each, the same candidates as AddEdges, so the
+// neighbors are not in ascending order.  For a packable source the
+// letter changes at a position are looked up together (it->Batch),
+// then the other characters one by one (it->Letter indexes the
+// alphabet).
+//
+Vertex ImplicitNext(NeighborIter *it)
+{
+  Graph  *G = it->G;
+  char   *word = G->Names[it->Src];
+  int     packs = (G->Keys[it->Src] != WORDKEY_NONE);
+  Shard  *S = &G->Shards[it->Length];
+
+  while (it->Position < it->Length)
+  {
+    char *alphabet = S->Alphabet[it->Position];
+
+    while (it->BatchPos < it->BatchLen)
+    {
+      Vertex w = it->Batch[it->BatchPos++];
+
+      if (w >= 0)
+        return w;
+    }
+
+    while (alphabet[it->Letter] != '\0')
+    {
+      char   c = alphabet[it->Letter++];
+      Vertex w;
+
+      if (c == word[it->Position])  // that's the word itself:
+        continue;
+      if (packs && c >= 'a' && c <= 'z')  // in the batch:
+        continue;
+
+      w = Variant2Vertex(G, word, it->Position, c);
+
+      if (w >= 0)
+        return w;
+    }
+
+    it->Position++;
+    it->Letter = 0;
+    it->BatchLen = 0;
+
+    if (packs && it->Position < it->Length)
+      _batchLetters(it);
+  }
+
+  return -1;
+}
@@ -0,0 +1,12 @@
+/*implicit.h*/
+
+//
+// Implicit (edge-free) neighbors: one-letter variants generated on
+// demand and looked up in the name indexes.
+//
+// NOTE: include "graph.h" before this file.
+//
+void   UseImplicitEdges(Graph *G);
+
+void   ImplicitFirst(Graph *G, Vertex v, NeighborIter *it);
+Vertex ImplicitNext(NeighborIter *it);
@@ -0,0 +1,347 @@
+/*kpaths.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "search.h"
+#include "kpaths.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// K shortest ladders:
+//
+// Yen's algorithm finds the k least-cost loopless paths in order.
+// Given the paths found so far, the next one deviates from one of
+// them: it follows a found path P up to some spur vertex P[i],
+// then leaves it by an edge that no found path with the same root
+// P[0..i] takes, and never returns to the root.  So for each spur
+// vertex of the last path found, a search from the spur to dest,
+// with the root's vertices and those edges banned, gives a
+// candidate; the next path is the cheapest candidate.
+//
+// Every search runs in one SearchWorkspace, so no search pays to
+// initialize per-vertex state, and lifting the bans is O(1).  Two
+// more savings avoid searches altogether:
+//
+//   - spur vertices before the one a path deviated at give the
+//     same candidates as they gave for its parent path (Lawler), so
+//     only the vertices from its deviation on are spurs;
+//   - only the candidates that can still be among the k paths are
+//     kept, and once there are enough, the searches are bounded by
+//     the cost of the dearest one (W->MaxDistance), so most spur
+//     searches stop early or find nothing.
+//
+
+typedef struct KPath
+{
+  Vertex *Path;        // src, ..., dest, -1
+  int     Length;      // # of vertices
+  int     Cost;
+  int     Deviation;   // index of the spur vertex it was found at
+} KPath;
+
+typedef struct KPaths  // paths in ascending order of cost:
+{
+  KPath  *Paths;
+  int     Count;
+  int     Capacity;
+} KPaths;
+
+static void _initPaths(KPaths *L, int capacity)
+{
+  L->Count = 0;
+  L->Capacity = capacity;
+  L->Paths = (KPath *)mymalloc(capacity * sizeof(KPath));
+  if (L->Paths == NULL)
+  {
+    printf("\n**Error in KShortestPaths: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+}
+
+//
+// _sameAs:
+//
+// Returns true (non-zero) if the path is already in L.
+//
+static int _sameAs(KPaths *L, Vertex *path, int length, int cost)
+{
+  int i;
+
+  for (i = 0; i < L->Count; ++i)
+  {
+    if (L->Paths[i].Cost == cost && L->Paths[i].Length == length &&
+        memcmp(L->Paths[i].Path, path, length * sizeof(Vertex)) == 0)
+      return 1;
+  }
+
+  return 0;
+}
+
+//
+// _insertCandidate:
+//
+// Adds the path to the candidates B, in order of cost (after those
+// of the same cost), keeping at most max of them.  Frees the path
+// if it isn't kept.
+//
+static void _insertCandidate(KPaths *B, KPath P, int max)
+{
+  int i;
+
+  if (_sameAs(B, P.Path, P.Length, P.Cost) || (B->Count >= max && B->Paths[max - 1].Cost <= P.Cost))
+  {
+    myfree(P.Path);
+    return;
+  }
+
+  if (B->Count == max)  // full, so the dearest goes:
+    myfree(B->Paths[--B->Count].Path);
+
+  if (B->Count == B->Capacity)  // full, double in size:
+  {
+    KPath *paths = (KPath *)mymalloc(2 * B->Capacity * sizeof(KPath));
+    if (paths == NULL)
+    {
+      printf("\n**Error in KShortestPaths: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    memcpy(paths, B->Paths, B->Count * sizeof(KPath));
+    myfree(B->Paths);
+
+    B->Paths = paths;
+    B->Capacity *= 2;
+  }
+
+  for (i = B->Count; i > 0 && B->Paths[i - 1].Cost > P.Cost; --i)
+    B->Paths[i] = B->Paths[i - 1];
+
+  B->Paths[i] = P;
+  B->Count++;
+}
+
+//
+// _pathLength:
+//
+static int _pathLength(Vertex *path)
+{
+  int n = 0;
+
+  while (path[n] != -1)
+    n++;
+
+  return n;
+}
+
+//
+// KShortestPaths:
+//
+// Returns a dynamically-allocated, NULL-terminated array of the (at
+// most) k least-cost loopless paths from src to dest, cheapest
+// first, each in the format Dijkstra() returns (src, ..., dest,
+// -1).  If costs is not NULL, costs[i] is set to the cost of the
+// i-th path.  If O is not NULL, the paths only enter the words it
+// allows (see SearchOptions), and all the searches share its budget
+// (see ShareBudget).  There are fewer than k if there are no more
+// paths, none if src == dest, and if the budget runs out, those
+// found by then.  If R is not NULL, R->Status says whether any were
+// found, or the budget ran out, and the rest of R how much work the
+// searches did (see BudgetResult).
+//
+// NOTE: returns NULL if src or dest are not valid vertex ids.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned paths when they are done (see DeletePaths).
+//
+Vertex **KShortestPaths(Graph *G, Vertex src, Vertex dest, int k, SearchOptions *O, int *costs,
+                        SearchResult *R)
+{
+  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+  if (dest < 0 || dest >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  SearchWorkspace *W = CreateWorkspace(G);
+  KPaths           A, B;
+  int             *rootCost;
+  int              status = SEARCH_NOPATH;
+  int              i, j, n;
+
+  W->Options = O;
+  ShareBudget(W);
+
+  if (k < 0)
+    k = 0;
+
+  _initPaths(&A, k + 1);
+  _initPaths(&B, 64);
+
+  if (k > 0 && src != dest)
+    status = SearchFrom(G, W, src, dest);
+
+  if (status >= 0)
+  {
+    KPath first;
+
+    first.Path = WorkspacePath(W, src, dest);
+    first.Length = _pathLength(first.Path);
+    first.Cost = W->Distance[dest];
+    first.Deviation = 0;
+
+    A.Paths[A.Count++] = first;
+    status = SEARCH_FOUND;
+  }
+
+  while (status == SEARCH_FOUND && A.Count < k)
+  {
+    KPath *P = &A.Paths[A.Count - 1];
+    int    needed = k - A.Count;  // # of paths still to find
+
+    rootCost = (int *)mymalloc(P->Length * sizeof(int));
+    if (rootCost == NULL)
+    {
+      printf("\n**Error in KShortestPaths: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    rootCost[0] = 0;
+    for (i = 1; i < P->Length; ++i)
+      rootCost[i] = rootCost[i - 1] + getEdgeWeight(G, P->Path[i - 1], P->Path[i]);
+
+    for (i = P->Deviation; i < P->Length - 1; ++i)
+    {
+      Vertex spur = P->Path[i];
+
+      //
+      // bound the search by the dearest candidate that can still
+      // be needed, if there are enough:
+      //
+      W->MaxDistance = -1;
+
+      if (B.Count >= needed)
+      {
+        W->MaxDistance = B.Paths[needed - 1].Cost - rootCost[i] - 1;
+
+        if (W->MaxDistance < 0)  // every path from here costs too much:
+          continue;
+      }
+
+      //
+      // ban the root, and the edges the found paths with this root
+      // take from the spur:
+      //
+      ClearBans(W);
+
+      for (j = 0; j < i; ++j)
+        BanVertex(W, P->Path[j]);
+
+      for (j = 0; j < A.Count; ++j)
+      {
+        KPath *Q = &A.Paths[j];
+
+        if (Q->Length > i + 1 && memcmp(Q->Path, P->Path, (i + 1) * sizeof(Vertex)) == 0)
+          BanEdge(W, spur, Q->Path[i + 1]);
+      }
+
+      int distance = SearchFrom(G, W, spur, dest);
+      if (distance == SEARCH_TIMEDOUT)  // out of budget, stop here:
+      {
+        status = SEARCH_TIMEDOUT;
+        break;
+      }
+      if (distance < 0)
+        continue;
+
+      //
+      // the candidate is the root, then the spur path:
+      //
+      Vertex *spurPath = WorkspacePath(W, spur, dest);
+      int     spurLength = _pathLength(spurPath);
+      KPath   C;
+
+      C.Length = i + spurLength;
+      C.Cost = rootCost[i] + distance;
+      C.Deviation = i;
+      C.Path = (Vertex *)mymalloc((C.Length + 1) * sizeof(Vertex));
+      if (C.Path == NULL)
+      {
+        printf("\n**Error in KShortestPaths: malloc failed to allocate\n\n");
+        exit(-1);
+      }
+
+      memcpy(C.Path, P->Path, i * sizeof(Vertex));
+      memcpy(&C.Path[i], spurPath, (spurLength + 1) * sizeof(Vertex));
+      myfree(spurPath);
+
+      _insertCandidate(&B, C, needed);
+    }
+
+    myfree(rootCost);
+
+    if (status == SEARCH_TIMEDOUT || B.Count == 0)  // no more paths:
+      break;
+
+    //
+    // the cheapest candidate is the next path:
+    //
+    A.Paths[A.Count++] = B.Paths[0];
+
+    B.Count--;
+    memmove(&B.Paths[0], &B.Paths[1], B.Count * sizeof(KPath));
+  }
+
+  //
+  // done, return the paths found:
+  //
+  Vertex **paths = (Vertex **)mymalloc((A.Count + 1) * sizeof(Vertex *));
+  if (paths == NULL)
+  {
+    printf("\n**Error in KShortestPaths: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (n = 0; n < A.Count; ++n)
+  {
+    paths[n] = A.Paths[n].Path;
+    if (costs != NULL)
+      costs[n] = A.Paths[n].Cost;
+  }
+
+  paths[n] = NULL;
+
+  for (i = 0; i < B.Count; ++i)
+    myfree(B.Paths[i].Path);
+
+  if (R != NULL)
+    BudgetResult(W, status, R);
+
+  myfree(A.Paths);
+  myfree(B.Paths);
+  DeleteWorkspace(W);
+
+  return paths;
+}
+
+//
+// DeletePaths:
+//
+// Frees the paths returned by KShortestPaths.
+//
+void DeletePaths(Vertex **paths)
+{
+  int i;
+
+  for (i = 0; paths[i] != NULL; ++i)
+    myfree(paths[i]);
+
+  myfree(paths);
+}
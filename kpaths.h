@@ -0,0 +1,10 @@
+/*kpaths.h*/
+
+//
+// K shortest loopless ladders (Yen's algorithm):
+//
+// NOTE: include "graph.h" and "search.h" before this file.
+//
+Vertex **KShortestPaths(Graph *G, Vertex src, Vertex dest, int k, SearchOptions *O, int *costs,
+                        SearchResult *R);
+void     DeletePaths(Vertex **paths);
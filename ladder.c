@@ -0,0 +1,481 @@
+/*ladder.c*/
+
+//
+// Word ladder graph construction: reading a dictionary into a
+// graph, then linking words that differ by one letter.
+//
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "hamming.h"
+#include "ladder.h"
+#include "cost.h"
+#include "mymem.h"
+
+//
+// Read_and_AddWords:
+//
+// Reads the given dictionary file, one word per line, and returns
+// a graph with one vertex per word and no edges yet.
+//
+Graph *Read_and_AddWords(char *filename)
+{
+  FILE  *input;
+  char   line[256];
+  int    linesize = sizeof(line) / sizeof(line[0]);
+
+  input = fopen(filename, "r");
+  if (input == NULL)
+  {
+    printf("**ERROR: '%s' not found\n\n", filename);
+    exit(-1);
+  }
+
+  //
+  // (1) input words and insert each word as a vertex:
+  //
+  printf(">>Building Graph from '%s'...\n", filename);
+
+  Graph *G = CreateGraph(256);  // 256 => initial size:
+
+  fgets(line, linesize, input);
+
+  while (!feof(input))
+  {
+    line[strcspn(line, "\r\n")] = '\0';  // strip EOL(s) char at end:
+
+    if (AddVertex(G, line) < 0)
+    {
+      printf("**Error: AddVertex failed?!\n\n");
+      exit(-1);
+    }
+
+    fgets(line, linesize, input);
+  }
+
+  //
+  // done, group the words by length:
+  //
+  fclose(input);
+
+  BuildShards(G);
+
+  return G;
+}
+
+
+
+//
+// _addEdge:
+//
+// Adds an edge from v to v2, weighted by G's cost model.
+//
+static void _addEdge(Graph *G, Vertex v, Vertex v2)
+{
+  if (!AddEdge(G, v, v2, EdgeCost(G, v, v2)))
+  {
+    printf("**Error: AddEdge failed?!\n\n");
+    exit(-1);
+  }
+}
+
+//
+// _probeNames:
+//
+// Adds an edge from v to each word that differs from v's name by
+// one character, changing characters in a copy of the name.  If
+// the name packs, only the characters that aren't 'a'..'z' are
+// tried, the rest being left to the key probes.
+//
+static void _probeNames(Graph *G, Vertex v)
+{
+  char   *word = G->Names[v];
+  int     packs = (G->Keys[v] != WORDKEY_NONE);
+  int     len = (int)strlen(word);
+  Shard  *S = &G->Shards[len];
+
+  int  i;
+  char *temp = (char *)mymalloc(((int)(len + 1)) * sizeof(char));
+
+  for (i = 0; i < len; ++i)
+  {
+    char *c;
+
+    strcpy(temp, word);
+
+    for (c = S->Alphabet[i]; *c != '\0'; ++c)
+    {
+      if (*c == word[i] || (packs && *c >= 'a' && *c <= 'z'))
+        continue;
+
+      temp[i] = *c;  // change one letter:
+
+      int v2 = Name2Vertex(G, temp);
+      if (v2 >= 0 && v2 != v)  // dest exists, add edge:
+        _addEdge(G, v, v2);
+    }
+  }
+
+  myfree(temp);
+}
+
+//
+// _probeEdges:
+//
+// Generates all possible words that differ from v's name by one
+// letter, and adds an edge from v to each one that exists.  Only
+// the characters that occur at each position in words of v's
+// length are tried (see BuildShards), which covers digits, quotes
+// and the like as well as 'a'..'z'.
+//
+static void _probeEdges(Graph *G, Vertex v)
+{
+  WordKey key = G->Keys[v];
+
+  int  i;
+
+  //
+  // if the word packs into a key, candidates with a letter changed
+  // to another letter are keys too, so changing a letter and
+  // probing for it are integer operations:
+  //
+  if (key != WORDKEY_NONE)
+  {
+    WordKey candidates[WORDKEY_MAXLEN * 26];
+    Vertex  found[WORDKEY_MAXLEN * 26];
+    int     len = KeyLength(key);
+    Shard  *S = &G->Shards[len];
+    int     others = 0;  /*false*/
+    int     n = 0;
+
+    for (i = 0; i < len; ++i)
+    {
+      char *c;
+
+      for (c = S->Alphabet[i]; *c != '\0'; ++c)
+      {
+        if (*c < 'a' || *c > 'z')  // not a letter, see below:
+          others = 1;  /*true*/
+        else
+          candidates[n++] = KeySetLetter(key, i, *c);
+      }
+    }
+
+    //
+    // looked up all at once, so the cache misses overlap:
+    //
+    Keys2Vertices(G, candidates, n, found);
+
+    for (i = 0; i < n; ++i)
+    {
+      if (found[i] >= 0 && found[i] != v)  // dest exists, add edge:
+        _addEdge(G, v, found[i]);
+    }
+
+    if (!others)  // done:
+      return;
+  }
+
+  //
+  // otherwise (or for the other characters) fall back to changing
+  // letters in a copy of the word:
+  //
+  _probeNames(G, v);
+}
+
+//
+// AddEdges:
+//
+// For each word, generates all possible words that differ by one
+// letter, and adds edges to/from these words in the graph.
+//
+void AddEdges(Graph *G)
+{
+  int  v;
+
+  for (v = 0; v < G->NumVertices; ++v)
+    _probeEdges(G, v);
+}
+
+//
+// _hasOthers:
+//
+// Returns true (non-zero) if some word of shard S, of length L,
+// has a character other than 'a'..'z'.
+//
+static int _hasOthers(Shard *S, int L)
+{
+  int   i;
+  char *c;
+
+  for (i = 0; i < L; ++i)
+  {
+    for (c = S->Alphabet[i]; *c != '\0'; ++c)
+    {
+      if (*c < 'a' || *c > 'z')
+        return 1;
+    }
+  }
+
+  return 0;
+}
+
+//
+// AddEdgesByScan:
+//
+// Builds the same edges as AddEdges, but instead of probing for
+// every candidate word, each packable word is compared against all
+// the words of its length with the vectorized HammingScan.  Words
+// that don't pack are probed as in AddEdges, as are the changes to
+// characters other than 'a'..'z'.  Faster than probing
+// for shards that are small relative to 26 x length probes.
+//
+void AddEdgesByScan(Graph *G)
+{
+  int  L, i, j;
+
+  for (L = 1; L <= G->MaxLength; ++L)
+  {
+    Shard *S = &G->Shards[L];
+
+    if (S->NumWords == 0)
+      continue;
+
+    int  others = _hasOthers(S, L);
+    int *matches = (int *)mymalloc(S->NumWords * sizeof(int));
+    if (matches == NULL)
+    {
+      printf("\n**Error in AddEdgesByScan: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    for (i = 0; i < S->NumWords; ++i)
+    {
+      Vertex v = S->Words[i];
+
+      if (S->Keys[i] == WORDKEY_NONE)  // doesn't pack, so probe:
+      {
+        _probeEdges(G, v);
+        continue;
+      }
+
+      int n = HammingScan(S->Keys, S->NumWords, S->Keys[i], matches);
+
+      for (j = 0; j < n; ++j)
+        _addEdge(G, v, S->Words[matches[j]]);
+
+      if (others)
+        _probeNames(G, v);
+    }
+
+    myfree(matches);
+  }
+}
+
+//
+// AddEditEdges:
+//
+// Adds edges to/from each word and the words one letter shorter
+// that it becomes by deleting a letter, so that inserting or
+// deleting a letter is also a step (cat => cart => card).  Rather
+// than probing every insertion of every char into every word, each
+// word's deletion neighborhood --- its L deletions --- is looked up
+// among the shorter words, by key where the word packs (deleting
+// any letter of a run gives the same word, so only the first is
+// deleted).  The edges are counted in G->NumEditEdges too.
+//
+// NOTE: needs the adjacency lists, so call after AddEdges or
+// AddEdgesByScan (not with lazy, hypergraph or implicit edges).
+//
+void AddEditEdges(Graph *G)
+{
+  Vertex v;
+  int    i;
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    char   *name = G->Names[v];
+    WordKey key = G->Keys[v];
+    int     len = (int)strlen(name);
+    Vertex  found[256];
+    int     n = 0;
+
+    if (len < 2 || len >= 256)
+      continue;
+
+    if (key != WORDKEY_NONE)
+    {
+      WordKey candidates[WORDKEY_MAXLEN];
+
+      for (i = 0; i < len; ++i)
+      {
+        if (i == 0 || name[i] != name[i - 1])
+          candidates[n++] = KeyDeleteLetter(key, i);
+      }
+
+      Keys2Vertices(G, candidates, n, found);
+    }
+    else  // delete chars in a copy of the name:
+    {
+      char temp[256];
+
+      for (i = 0; i < len; ++i)
+      {
+        if (i > 0 && name[i] == name[i - 1])
+          continue;
+
+        memcpy(temp, name, i);
+        strcpy(&temp[i], &name[i + 1]);
+
+        found[n++] = Name2Vertex(G, temp);
+      }
+    }
+
+    for (i = 0; i < n; ++i)
+    {
+      if (found[i] < 0)
+        continue;
+
+      _addEdge(G, v, found[i]);
+      _addEdge(G, found[i], v);
+      G->NumEditEdges += 2;
+    }
+  }
+}
+
+
+
+// #####################################################
+//
+// Lazy edges:
+//
+// A one-letter change keeps the length of a word, so each length
+// shard's edges can be built on their own.  AddEdgesLazily builds
+// none up front; instead BeginNeighbors calls MaterializeShard for
+// the shard of the vertex being expanded, which probes the edges of
+// all the shard's words the first time.  Each shard has its own
+// lock, so concurrent first queries on the same shard build it
+// once while queries on other shards go ahead.  Built[L] is read
+// without the lock: once it is set, shard L's lists are final.
+//
+
+typedef struct LazyShards
+{
+  int              MaxLength;
+  int             *Built;      // Built[L] true => shard L's edges exist
+  pthread_mutex_t *Locks;      // Locks[L] guards building shard L
+  int              NumBuilt;   // # of shards built (with words)
+  int              NumShards;  // # of shards with words
+} LazyShards;
+
+//
+// AddEdgesLazily:
+//
+// Like AddEdges, except that the edges of each length shard are
+// only added once some search first expands a word of that length
+// (see MaterializeShard).
+//
+void AddEdgesLazily(Graph *G)
+{
+  LazyShards *Z = (LazyShards *)mymalloc(sizeof(LazyShards));
+  int         L;
+
+  if (Z == NULL)
+  {
+    printf("\n**Error in AddEdgesLazily: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  Z->MaxLength = G->MaxLength;
+  Z->Built = (int *)mymalloc((G->MaxLength + 1) * sizeof(int));
+  Z->Locks = (pthread_mutex_t *)mymalloc((G->MaxLength + 1) * sizeof(pthread_mutex_t));
+  Z->NumBuilt = 0;
+  Z->NumShards = 0;
+
+  if (Z->Built == NULL || Z->Locks == NULL)
+  {
+    printf("\n**Error in AddEdgesLazily: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (L = 0; L <= G->MaxLength; ++L)
+  {
+    Z->Built[L] = (G->Shards[L].NumWords == 0);  // nothing to build:
+    if (!Z->Built[L])
+      Z->NumShards++;
+
+    pthread_mutex_init(&Z->Locks[L], NULL);
+  }
+
+  G->Lazy = Z;
+}
+
+//
+// MaterializeShard:
+//
+// Adds the edges of all the words of length L, unless already done.
+// Safe to call from several threads at once.
+//
+void MaterializeShard(Graph *G, int L)
+{
+  LazyShards *Z = G->Lazy;
+  int         i;
+
+  if (L < 0 || L > Z->MaxLength ||
+      __atomic_load_n(&Z->Built[L], __ATOMIC_ACQUIRE))
+    return;
+
+  pthread_mutex_lock(&Z->Locks[L]);
+
+  if (!Z->Built[L])  // we're first, so build:
+  {
+    Shard *S = &G->Shards[L];
+
+    for (i = 0; i < S->NumWords; ++i)
+      _probeEdges(G, S->Words[i]);
+
+    __sync_fetch_and_add(&Z->NumBuilt, 1);
+    __atomic_store_n(&Z->Built[L], 1, __ATOMIC_RELEASE);
+  }
+
+  pthread_mutex_unlock(&Z->Locks[L]);
+}
+
+//
+// ShardsMaterialized:
+//
+// Returns the # of length shards whose edges have been built, and
+// the # of shards (with words) in *numShards.
+//
+int ShardsMaterialized(Graph *G, int *numShards)
+{
+  *numShards = G->Lazy->NumShards;
+
+  return G->Lazy->NumBuilt;
+}
+
+//
+// DeleteLazyShards:
+//
+void DeleteLazyShards(Graph *G)
+{
+  LazyShards *Z = G->Lazy;
+  int         L;
+
+  for (L = 0; L <= Z->MaxLength; ++L)
+    pthread_mutex_destroy(&Z->Locks[L]);
+
+  myfree(Z->Built);
+  myfree(Z->Locks);
+  myfree(Z);
+
+  G->Lazy = NULL;
+}
@@ -0,0 +1,16 @@
+/*ladder.h*/
+
+//
+// Word ladder graph construction:
+//
+// NOTE: include "graph.h" before this file.
+//
+Graph *Read_and_AddWords(char *filename);
+void   AddEdges(Graph *G);
+void   AddEdgesByScan(Graph *G);
+void   AddEditEdges(Graph *G);
+
+void   AddEdgesLazily(Graph *G);
+void   MaterializeShard(Graph *G, int L);
+int    ShardsMaterialized(Graph *G, int *numShards);
+void   DeleteLazyShards(Graph *G);
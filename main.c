@@ -1,314 +1,1184 @@
-/*main.c*/
-
-//
-// Word Ladders using Graphs
-//
-// Srinivas C Lingutla
-// MAC OS X with Xcode 2015
-// U. of Illinois, Chicago
-// CS251, Fall 2016
-// HW #12: Solution
-//
-
-#define _CRT_SECURE_NO_WARNINGS
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <math.h>
-#include <assert.h>
-
-#include "avl.h"
-#include "graph.h"
-#include "mymem.h"
-#include "timer.h"
-
-//
-// Read_and_AddWords:
-//
-Graph *Read_and_AddWords(char *filename)
-{
-  FILE  *input;
-  char   line[256];
-  int    linesize = sizeof(line) / sizeof(line[0]);
-
-  input = fopen(filename, "r");
-  if (input == NULL)
-  {
-    printf("**ERROR: '%s' not found\n\n", filename);
-    exit(-1);
-  }
-
-  //
-  // (1) input words and insert each word as a vertex:
-  //
-  printf(">>Building Graph from '%s'...\n", filename);
-
-  Graph *G = CreateGraph(256);  // 256 => initial size:
-
-  fgets(line, linesize, input);
-
-  while (!feof(input))
-  {
-    line[strcspn(line, "\r\n")] = '\0';  // strip EOL(s) char at end:
-
-    if (AddVertex(G, line) < 0)
-    {
-      printf("**Error: AddVertex failed?!\n\n");
-      exit(-1);
-    }
-
-    fgets(line, linesize, input);
-  }
-
-  //
-  // done:
-  //
-  fclose(input);
-
-  return G;
-}
-
-
-//
-// AddEdges:
-//
-void AddEdges(Graph *G)
-{
-  //
-  // (2) Now for each word, let's generate all possible
-  // words that differ by one letter, and add edges to/from
-  // these words in the graph:
-  //
-  int  v;
-
-  for (v = 0; v < G->NumVertices; ++v)
-  {
-    char *word = G->Names[v];
-
-    char *temp = (char *)mymalloc(((int)(strlen(word) + 1)) * sizeof(char));
-
-    int  i;
-    for (i = 0; i < (int)strlen(word); ++i)
-    {
-      strcpy(temp, word);
-
-      char  c = 'a';
-      while (c <= 'z')
-      {
-        temp[i] = c;  // change one letter:
-
-        int v2 = Name2Vertex(G, temp);
-        if (v2 >= 0 && v2 != v)  // dest exists, add edge:
-        {
-          if (!AddEdge(G, v, v2, 1))
-          {
-            printf("**Error: AddEdge failed?!\n\n");
-            exit(-1);
-          }
-        }//if
-
-        ++c;
-      }
-    }
-
-    myfree(temp);
-  }
-}
-
-
-//
-// PrintNeighborsAndBFS:
-//
-void PrintNeighborsAndBFS(Graph *G, int v)
-{
-  char line[256];
-  int  linesize = sizeof(line) / sizeof(line[0]);
-
-  Vertex *V = Neighbors(G, v);
-
-  //
-  // Neighbors:
-  //
-  printf("** Neighbors:\n");
-  printf("   ");
-
-  int  i = 0;
-  while (V[i] != -1)  // ends with -1:
-  {
-    Vertex v = V[i];
-
-    printf("(%d,%s) ", v, Vertex2Name(G, v));
-    ++i;
-  }
-
-  printf("\n");
-
-  myfree(V);
-
-  //
-  // Now call BFS with a distance and output those results:
-  //
-  int distance;
-  printf(">> enter a BFS distance: ");
-
-  scanf("%d", &distance);
-  fgets(line, linesize, stdin);  // discard rest of line:
-
-  V = BFSd(G, v, distance);
-
-  //
-  // BFSd returns vertices separated by "markers" of -1
-  // between each step of the BFS.  Given a distance d, there
-  // will be d+1 markers in the returned array.  Example:
-  //
-  //    0, -1, 1, 2, 3, 5, -1, ...
-  //
-  printf("** BFS:\n");
-
-  int  d;
-  i = 0;
-
-  for (d = 0; d <= distance; ++d)  // d+1 markers:
-  {
-    printf("   distance %d: ", d);
-
-    while (V[i] != -1)  // loop until next marker:
-    {
-      Vertex v = V[i];
-
-      printf("(%d,%s) ", v, Vertex2Name(G, v));
-      ++i;
-    }
-
-    ++i;  // skip over the -1:
-
-    printf("\n");
-  }
-
-  myfree(V);
-}
-
-void PrintDikstraPath(Graph *G, Vertex *path)
-{
-  int i = 0;
-  printf("** Shortest Word Ladder: \n");
-  while(path[i] != -1)
-  {
-      printf("   %s\n", Vertex2Name(G, path[i]) );
-      i++;
-  }
-
-  printf("   Length: %d\n",i-1 );
-
-}
-
-//
-// main:
-//
-int main()
-{
-  Graph *G;
-  char  *filename = "merriam-webster.txt";
-  char   line[256];
-  char   lin2[256];
-  int    linesize = sizeof(line) / sizeof(line[0]);
-
-  printf("** Starting Word Ladder App **\n\n");
-
-  //
-  // (1) input words and insert each word as a vertex:
-  //
-  timer_start();
-
-  G = Read_and_AddWords(filename);
-
-  //
-  // (2) Now for each word, let's generate all possible
-  // words that differ by one letter, and add edges to/from
-  // these words in the graph:
-  //
-  AddEdges(G);
-
-  //
-  // (3) print some graph stats:
-  //
-  PrintGraph(G, "Word Ladder", 0 /*false*/);
-
-  timer_stop();
-  timer_stats(">>Build time:    ");
-
-  printf("\n");
-
-  //
-  // (4) input words from the user and perform BFS:
-  //
-  printf(">> enter a word (ENTER to quit): ");
-
-  fgets(line, linesize, stdin);
-  line[strcspn(line, "\r\n")] = '\0';  // strip EOL(s) char at end:
-
-  printf(">> enter another word : ");
-
-  fgets(lin2, linesize, stdin);
-  lin2[strcspn(lin2, "\r\n")] = '\0';  // strip EOL(s) char at end:
-
-  while (strlen(line) > 0 && strlen(lin2) > 0 )
-  {
-    timer_start();
-    int v1 = Name2Vertex(G, line);
-    int v2 = Name2Vertex(G, lin2);
-
-    if (v1 < 0)
-    {
-      printf("Word 1 not found, please try again...\n");
-      timer_stop();
-    }
-    else if (v2 < 0)
-    {
-      printf("Word 2 not found, please try again...\n");
-      timer_stop();
-    }
-    else
-    {
-      int* path = Dijkstra(G, v1, v2);
-
-      if (path[0] == -1) {
-        printf("There is no path from '%s' to '%s' \n", Vertex2Name(G, v1), Vertex2Name(G, v2));
-        timer_stop();
-      }
-      else{
-        PrintDikstraPath(G, path);
-      }
-
-      timer_stop();
-      timer_stats(">>Run time:    ");
-      myfree(path);
-
-    }
-
-
-    printf("\n");
-    printf(">> enter a word (ENTER to quit): ");
-
-    fgets(line, linesize, stdin);
-    line[strcspn(line, "\r\n")] = '\0';  // strip EOL(s) char at end:
-
-    printf(">> enter another word : ");
-
-    fgets(lin2, linesize, stdin);
-    lin2[strcspn(lin2, "\r\n")] = '\0';  // strip EOL(s) char at end:
-  }
-
-  //
-  // done:
-  //
-  DeleteGraph(G);
-
-  printf("\n** Done **\n");
-  mymem_stats();
-
-  printf("\n");
-
-  return 0;
-}
+/*main.c*/
+
+//
+// Word Ladders using Graphs
+//
+// Srinivas C Lingutla
+// MAC OS X with Xcode 2015
+// U. of Illinois, Chicago
+// CS251, Fall 2016
+// HW #12: Solution
+//
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "ladder.h"
+#include "compress.h"
+#include "hyper.h"
+#include "implicit.h"
+#include "bloom.h"
+#include "pattern.h"
+#include "suggest.h"
+#include "cost.h"
+#include "search.h"
+#include "sstree.h"
+#include "cache.h"
+#include "kpaths.h"
+#include "spdag.h"
+#include "waypoint.h"
+#include "closest.h"
+#include "msbfs.h"
+#include "relabel.h"
+#include "mymem.h"
+#include "timer.h"
+
+//
+// PrintNeighborsAndBFS:
+//
+void PrintNeighborsAndBFS(Graph *G, int v)
+{
+  char line[256];
+  int  linesize = sizeof(line) / sizeof(line[0]);
+
+  Vertex *V = Neighbors(G, v);
+
+  //
+  // Neighbors:
+  //
+  printf("** Neighbors:\n");
+  printf("   ");
+
+  int  i = 0;
+  while (V[i] != -1)  // ends with -1:
+  {
+    Vertex v = V[i];
+
+    printf("(%d,%s) ", v, Vertex2Name(G, v));
+    ++i;
+  }
+
+  printf("\n");
+
+  myfree(V);
+
+  //
+  // Now call BFS with a distance and output those results:
+  //
+  int distance;
+  printf(">> enter a BFS distance: ");
+
+  scanf("%d", &distance);
+  fgets(line, linesize, stdin);  // discard rest of line:
+
+  V = BFSd(G, v, distance);
+
+  //
+  // BFSd returns vertices separated by "markers" of -1
+  // between each step of the BFS.  Given a distance d, there
+  // will be d+1 markers in the returned array.  Example:
+  //
+  //    0, -1, 1, 2, 3, 5, -1, ...
+  //
+  printf("** BFS:\n");
+
+  int  d;
+  i = 0;
+
+  for (d = 0; d <= distance; ++d)  // d+1 markers:
+  {
+    printf("   distance %d: ", d);
+
+    while (V[i] != -1)  // loop until next marker:
+    {
+      Vertex v = V[i];
+
+      printf("(%d,%s) ", v, Vertex2Name(G, v));
+      ++i;
+    }
+
+    ++i;  // skip over the -1:
+
+    printf("\n");
+  }
+
+  myfree(V);
+}
+
+void PrintDikstraPath(Graph *G, Vertex *path)
+{
+  int i = 0;
+  printf("** Shortest Word Ladder: \n");
+  while(path[i] != -1)
+  {
+      printf("   %s\n", Vertex2Name(G, path[i]) );
+      i++;
+  }
+
+  printf("   Length: %d\n",i-1 );
+
+  if (G->Cost != NULL)
+    printf("   Cost: %d\n", PathCost(G, path));
+
+}
+
+//
+// PrintLadders:
+//
+// Prints the given paths (see KShortestPaths), one per line, with
+// their lengths and costs.
+//
+void PrintLadders(Graph *G, Vertex **paths, int *costs)
+{
+  int n, i;
+
+  for (n = 0; paths[n] != NULL; ++n)
+  {
+    printf("  %3d:", n + 1);
+    for (i = 0; paths[n][i] != -1; ++i)
+      printf(" %s", Vertex2Name(G, paths[n][i]));
+    printf(" (length %d, cost %d)\n", i - 1, costs[n]);
+  }
+}
+
+//
+// PrintShortestLadders:
+//
+// Prints the # of shortest ladders from v1 to v2, then the first
+// max of them, one per line (see BuildShortestPathDAG); only those
+// through the words options allows, if not NULL, and "timed out"
+// if that runs out of their budget.
+//
+void PrintShortestLadders(Graph *G, Vertex v1, Vertex v2, int max, SearchOptions *options)
+{
+  ShortestPathDAG *D = BuildShortestPathDAG(G, v1, v2, options);
+  DAGPathIter      it;
+  Vertex          *path;
+  int              n, i;
+
+  if (D->TimedOut)
+  {
+    printf("%s %s: timed out\n", Vertex2Name(G, v1), Vertex2Name(G, v2));
+    DeleteShortestPathDAG(D);
+    return;
+  }
+
+  if (D->NumPaths == SPDAG_SATURATED)
+    printf("%s %s: at least %llu shortest ladders (length %d)\n",
+           Vertex2Name(G, v1), Vertex2Name(G, v2), D->NumPaths, D->Length);
+  else
+    printf("%s %s: %llu shortest ladders (length %d)\n",
+           Vertex2Name(G, v1), Vertex2Name(G, v2), D->NumPaths, D->Length);
+
+  BeginShortestPaths(D, &it);
+
+  for (n = 0; n < max && (path = NextShortestPath(&it)) != NULL; ++n)
+  {
+    printf("  %3d:", n + 1);
+    for (i = 0; path[i] != -1; ++i)
+      printf(" %s", Vertex2Name(G, path[i]));
+    printf("\n");
+  }
+
+  if ((unsigned long long)n < D->NumPaths)
+    printf("  ...\n");
+
+  EndShortestPaths(&it);
+  DeleteShortestPathDAG(D);
+}
+
+//
+// FindLadder:
+//
+// Returns the least-cost ladder from v1 to v2, as Dijkstra() does:
+// only through the words options allows, and within its budget, if
+// not NULL (see SearchOptions and BudgetedShortestPath), else from
+// the cache, if not NULL (see CachedShortestPath).  R->Status says
+// whether the search found a ladder, found none, or ran out of
+// budget; only the budgeted search fills in the rest of R.
+//
+// NOTE: the cache is keyed by the words alone, so it is never used
+// with options (main does not create one then).
+//
+Vertex *FindLadder(Graph *G, Vertex v1, Vertex v2, SearchOptions *options, LadderCache *cache,
+                   SearchResult *R)
+{
+  Vertex *path;
+
+  if (options != NULL)
+    return BudgetedShortestPath(G, v1, v2, options, R);
+  else if (cache != NULL)
+    path = CachedShortestPath(G, cache, v1, v2);
+  else
+    path = Dijkstra(G, v1, v2);
+
+  R->Status = (path[0] == -1) ? SEARCH_NOPATH : SEARCH_FOUND;
+
+  return path;
+}
+
+//
+// PrintTimedOut:
+//
+// For a query whose search ran out of budget, prints the prefix then
+// "timed out after n words (m edges, t ms)", and if it sought the
+// word reached closest to the target, ", nearest 'w' (d edits): ..."
+// with the ladder to it, path (see BudgetedShortestPath; not read
+// otherwise, so may be NULL).
+//
+void PrintTimedOut(Graph *G, char *prefix, Vertex v1, Vertex *path, SearchResult *R)
+{
+  int i;
+
+  printf("%stimed out after %d words (%d edges, %.3f ms)", prefix, R->Settled, R->Scanned,
+    R->Elapsed);
+
+  if (R->Nearest >= 0)
+  {
+    printf(", nearest '%s' (%d edits):", Vertex2Name(G, R->Nearest), R->Edits);
+    if (path[0] == -1)  // (the nearest is v1)
+      printf(" %s", Vertex2Name(G, v1));
+    for (i = 0; path[i] != -1; ++i)
+      printf(" %s", Vertex2Name(G, path[i]));
+    printf(" (length %d)", (i > 0) ? i - 1 : 0);
+  }
+
+  printf("\n");
+}
+
+//
+// PrintClosest:
+//
+// For a query from v1 to the given word with no ladder, prints the
+// prefix then "closest 'w' (metric d): ..." with the ladder from v1
+// to the reachable word w closest to it by the given CLOSEST_
+// metric (see ClosestReachable), if there is one; only through the
+// words options allows, if not NULL.
+//
+void PrintClosest(Graph *G, char *prefix, Vertex v1, char *word, int metric,
+                  SearchOptions *options)
+{
+  int    distance, i;
+  Vertex w = ClosestReachable(G, v1, word, metric, options, &distance);
+
+  if (w < 0)
+    return;
+
+  Vertex *path;
+
+  if (options != NULL)
+    path = ConstrainedShortestPath(G, v1, w, options);
+  else
+    path = Dijkstra(G, v1, w);
+
+  if (path[0] == -1 && w != v1)  // (out of the options' budget)
+  {
+    printf("%sclosest: timed out\n", prefix);
+    myfree(path);
+    return;
+  }
+
+  printf("%sclosest '%s' (%s %d):", prefix, Vertex2Name(G, w),
+    (metric == CLOSEST_HAMMING) ? "hamming" : "edit", distance);
+  if (path[0] == -1)  // (w is v1)
+    printf(" %s", Vertex2Name(G, v1));
+  for (i = 0; path[i] != -1; ++i)
+    printf(" %s", Vertex2Name(G, path[i]));
+  printf(" (length %d)\n", (i > 0) ? i - 1 : 0);
+
+  myfree(path);
+}
+
+//
+// PrintHistogram:
+//
+// Prints "word: n reachable, ladders of length 1: a, 2: b, ...",
+// the # of words reachable from v by ladders of each length (see
+// LadderHistogram); only through the words options allows, if not
+// NULL, and "word: timed out" if that runs out of their budget.
+//
+void PrintHistogram(Graph *G, Vertex v, SearchOptions *options)
+{
+  SearchWorkspace  *W = CreateWorkspace(G);
+  SingleSourceTree *T;
+  int              *counts;
+  int               i;
+
+  W->Options = options;
+  T = BuildSingleSourceTree(G, W, v);
+  DeleteWorkspace(W);
+
+  if (T == NULL)
+  {
+    printf("%s: timed out\n", Vertex2Name(G, v));
+    return;
+  }
+
+  counts = LadderHistogram(T);
+
+  printf("%s: %d reachable", Vertex2Name(G, v), T->NumReached - 1);
+  for (i = 1; counts[i] != -1; ++i)
+    printf("%s %d: %d", (i == 1) ? ", ladders of length" : ",", i, counts[i]);
+  printf("\n");
+
+  myfree(counts);
+  DeleteSingleSourceTree(T);
+}
+
+//
+// PrintSuggestions:
+//
+// If G has a suggestion index, prints " (did you mean: ...?)" with
+// the words closest to the given one, if any.
+//
+void PrintSuggestions(Graph *G, char *word)
+{
+  if (G->Suggest == NULL)
+    return;
+
+  Vertex *V = Suggest(G, word, G->Suggest->MaxEdits, 5, NULL);
+  int     i;
+
+  for (i = 0; V[i] != -1; ++i)
+    printf("%s%s", (i == 0) ? " (did you mean: " : ", ", Vertex2Name(G, V[i]));
+
+  if (i > 0)
+    printf("?)");
+
+  myfree(V);
+}
+
+//
+// ReadWordList:
+//
+// Reads a file of words, one per line, and returns a dynamically-
+// allocated array of their vertex #s; words not in the graph are
+// reported and skipped.  The # of vertices is returned via count.
+//
+Vertex *ReadWordList(Graph *G, char *filename, int *count)
+{
+  FILE  *input;
+  char   line[256];
+  int    linesize = sizeof(line) / sizeof(line[0]);
+
+  input = fopen(filename, "r");
+  if (input == NULL)
+  {
+    printf("**ERROR: '%s' not found\n\n", filename);
+    exit(-1);
+  }
+
+  int     N = 64;
+  Vertex *words = (Vertex *)mymalloc(N * sizeof(Vertex));
+  if (words == NULL)
+  {
+    printf("\n**Error in ReadWordList: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  *count = 0;
+
+  while (fgets(line, linesize, input) != NULL)
+  {
+    line[strcspn(line, "\r\n")] = '\0';  // strip EOL(s) char at end:
+
+    if (strlen(line) == 0)
+      continue;
+
+    Vertex v = Name2Vertex(G, line);
+    if (v < 0)
+    {
+      printf("**Warning: '%s' not found, skipped\n", line);
+      continue;
+    }
+
+    if (*count == N)  // full, double in size:
+    {
+      Vertex *newWords = (Vertex *)mymalloc(2 * N * sizeof(Vertex));
+      if (newWords == NULL)
+      {
+        printf("\n**Error in ReadWordList: malloc failed to allocate\n\n");
+        exit(-1);
+      }
+
+      memcpy(newWords, words, N * sizeof(Vertex));
+      myfree(words);
+
+      words = newWords;
+      N = 2 * N;
+    }
+
+    words[*count] = v;
+    (*count)++;
+  }
+
+  fclose(input);
+
+  return words;
+}
+
+//
+// PrintWaypointLadder:
+//
+// Prints the ladder through the words of the given line, in order
+// or if anyOrder, in the cheapest order (see WaypointLadder), as
+// one line of output; only through the words options allows, if
+// not NULL, and "timed out" if that runs out of their budget.
+//
+void PrintWaypointLadder(Graph *G, char *line, int anyOrder, SearchOptions *options)
+{
+  char    query[256];
+  char    copy[256];
+  char   *names[128];
+  Vertex  waypoints[128];
+  char   *word;
+  int     n = 0;
+  int     i, cost;
+
+  strcpy(query, line);
+  query[strcspn(query, "\r\n")] = '\0';  // strip EOL(s) char at end:
+  strcpy(copy, query);
+
+  for (word = strtok(copy, " \t"); word != NULL && n < 128; word = strtok(NULL, " \t"))
+  {
+    names[n] = word;
+    waypoints[n] = Name2Vertex(G, word);
+
+    if (waypoints[n] < 0)
+    {
+      printf("%s: '%s' not found", query, word);
+      PrintSuggestions(G, word);
+      printf("\n");
+      return;
+    }
+
+    n++;
+  }
+
+  for (i = 0; i < n; ++i)
+    printf("%s%s", (i > 0) ? " " : "", names[i]);
+
+  Vertex *path = WaypointLadder(G, waypoints, n, anyOrder, options, &cost);
+
+  if (cost == SEARCH_TIMEDOUT)
+    printf(": timed out\n");
+  else if (cost < 0)
+    printf(": no path\n");
+  else
+  {
+    if (anyOrder)
+    {
+      printf(" (as");
+      for (i = 0; i < n; ++i)
+        printf(" %s", Vertex2Name(G, waypoints[i]));
+      printf(")");
+    }
+
+    printf(":");
+    if (path[0] == -1)  // (no steps)
+      printf(" %s", Vertex2Name(G, waypoints[0]));
+    for (i = 0; path[i] != -1; ++i)
+      printf(" %s", Vertex2Name(G, path[i]));
+    if (G->Cost != NULL)
+      printf(" (length %d, cost %d)\n", (i > 0) ? i - 1 : 0, cost);
+    else
+      printf(" (length %d)\n", (i > 0) ? i - 1 : 0);
+  }
+
+  myfree(path);
+}
+
+//
+// RunBatch:
+//
+// Answers ladder queries from a file, one "word1 word2" pair per
+// line, printing one line of output per query, or if numPaths > 1,
+// up to that many ladders per query (see KShortestPaths), or if
+// count, the # of shortest ladders and the first few of them.  A
+// line of more than 2 words asks for the ladder from the first to
+// the last through the others, in order or if anyOrder, in any
+// order (see PrintWaypointLadder).  If options is not NULL, every
+// answer only enters the words it allows (see SearchOptions).  If
+// closest is a CLOSEST_ metric, a query with no ladder is also
+// answered with the ladder to the closest reachable word.  A line
+// of 1 word asks for the # of words reachable by ladders of each
+// length (see PrintHistogram).  Single ladders come from the cache,
+// if not NULL (see FindLadder); a query that runs out of the
+// options' budget says so (see PrintTimedOut).
+//
+void RunBatch(Graph *G, char *filename, int numPaths, int count, int anyOrder,
+              SearchOptions *options, int closest, LadderCache *cache)
+{
+  FILE  *input;
+  char   line[256];
+  char   word1[256];
+  char   word2[256];
+  char   word3[256];
+  int    linesize = sizeof(line) / sizeof(line[0]);
+
+  input = fopen(filename, "r");
+  if (input == NULL)
+  {
+    printf("**ERROR: '%s' not found\n\n", filename);
+    exit(-1);
+  }
+
+  while (fgets(line, linesize, input) != NULL)
+  {
+    if (sscanf(line, "%255s %255s %255s", word1, word2, word3) == 3)
+    {
+      PrintWaypointLadder(G, line, anyOrder, options);
+      continue;
+    }
+
+    int numWords = sscanf(line, "%255s %255s", word1, word2);
+
+    if (numWords == 1)
+    {
+      if (Name2Vertex(G, word1) < 0)
+      {
+        printf("%s: '%s' not found", word1, word1);
+        PrintSuggestions(G, word1);
+        printf("\n");
+      }
+      else
+        PrintHistogram(G, Name2Vertex(G, word1), options);
+      continue;
+    }
+
+    if (numWords != 2)
+      continue;
+
+    int v1 = Name2Vertex(G, word1);
+    int v2 = Name2Vertex(G, word2);
+
+    if (v1 < 0)
+    {
+      printf("%s %s: '%s' not found", word1, word2, word1);
+      PrintSuggestions(G, word1);
+      printf("\n");
+      continue;
+    }
+    else if (v2 < 0)
+    {
+      printf("%s %s: '%s' not found", word1, word2, word2);
+      PrintSuggestions(G, word2);
+      printf("\n");
+      continue;
+    }
+
+    if (count)
+    {
+      PrintShortestLadders(G, v1, v2, 10, options);
+      continue;
+    }
+
+    if (numPaths > 1)
+    {
+      SearchResult result;
+      int         *costs = (int *)mymalloc(numPaths * sizeof(int));
+      Vertex     **paths = KShortestPaths(G, v1, v2, numPaths, options, costs, &result);
+      int          n = 0;
+
+      while (paths[n] != NULL)
+        n++;
+
+      printf("%s %s: %d ladders\n", word1, word2, n);
+      PrintLadders(G, paths, costs);
+
+      if (result.Status == SEARCH_TIMEDOUT)
+      {
+        char prefix[520];
+
+        sprintf(prefix, "%s %s: ", word1, word2);
+        PrintTimedOut(G, prefix, v1, NULL, &result);
+      }
+
+      DeletePaths(paths);
+      myfree(costs);
+      continue;
+    }
+
+    SearchResult result;
+    Vertex      *path = FindLadder(G, v1, v2, options, cache, &result);
+
+    if (result.Status == SEARCH_TIMEDOUT)
+    {
+      char prefix[520];
+
+      sprintf(prefix, "%s %s: ", word1, word2);
+      PrintTimedOut(G, prefix, v1, path, &result);
+    }
+    else if (path[0] == -1)
+    {
+      printf("%s %s: no path\n", word1, word2);
+
+      if (closest != 0 && v1 != v2)
+      {
+        char prefix[520];
+
+        sprintf(prefix, "%s %s: ", word1, word2);
+        PrintClosest(G, prefix, v1, word2, closest, options);
+      }
+    }
+    else
+    {
+      int i;
+
+      printf("%s %s:", word1, word2);
+      for (i = 0; path[i] != -1; ++i)
+        printf(" %s", Vertex2Name(G, path[i]));
+      if (G->Cost != NULL)
+        printf(" (length %d, cost %d)\n", i - 1, PathCost(G, path));
+      else
+        printf(" (length %d)\n", i - 1);
+    }
+
+    myfree(path);
+  }
+
+  fclose(input);
+}
+
+//
+// RunPatterns:
+//
+// Answers pattern queries from a file, one "pattern [length]" per
+// line (see BeginPattern), printing the first few matches and the
+// # of matches.
+//
+void RunPatterns(Graph *G, char *filename)
+{
+  FILE  *input;
+  char   line[256];
+  char   pattern[256];
+  int    linesize = sizeof(line) / sizeof(line[0]);
+
+  input = fopen(filename, "r");
+  if (input == NULL)
+  {
+    printf("**ERROR: '%s' not found\n\n", filename);
+    exit(-1);
+  }
+
+  while (fgets(line, linesize, input) != NULL)
+  {
+    PatternIter it;
+    Vertex      w;
+    int         length = 0;
+    int         n = 0;
+
+    if (sscanf(line, "%255s %d", pattern, &length) < 1)
+      continue;
+
+    printf("%s:", pattern);
+
+    BeginPattern(G, pattern, length, &it);
+    while ((w = NextMatch(&it)) != -1)
+    {
+      if (n < 10)
+        printf(" %s", Vertex2Name(G, w));
+      else if (n == 10)
+        printf(" ...");
+
+      n++;
+    }
+    EndPattern(&it);
+
+    printf(" (%d matches)\n", n);
+  }
+
+  fclose(input);
+}
+
+//
+// RunMatrix:
+//
+// Prints the table of ladder lengths from every word in one file
+// to every word in another, computed by multi-source BFS.  "-"
+// denotes there is no ladder.
+//
+void RunMatrix(Graph *G, char *sourcesFile, char *targetsFile)
+{
+  int numSources, numTargets;
+  int s, t;
+
+  Vertex *sources = ReadWordList(G, sourcesFile, &numSources);
+  Vertex *targets = ReadWordList(G, targetsFile, &numTargets);
+
+  if (numSources > 0 && numTargets > 0)
+  {
+    int *table = MultiSourceDistances(G, sources, numSources, targets, numTargets);
+
+    printf("%-16s", "");
+    for (t = 0; t < numTargets; ++t)
+      printf(" %s", Vertex2Name(G, targets[t]));
+    printf("\n");
+
+    for (s = 0; s < numSources; ++s)
+    {
+      printf("%-16s", Vertex2Name(G, sources[s]));
+
+      for (t = 0; t < numTargets; ++t)
+      {
+        int d = table[s * numTargets + t];
+        int w = (int)strlen(Vertex2Name(G, targets[t]));
+
+        if (d < 0)
+          printf(" %*s", w, "-");
+        else
+          printf(" %*d", w, d);
+      }
+
+      printf("\n");
+    }
+
+    myfree(table);
+  }
+
+  myfree(sources);
+  myfree(targets);
+}
+
+//
+// RunInteractive:
+//
+// Inputs pairs of words from the user and outputs the shortest
+// word ladder between them (or if numPaths > 1, up to that many of
+// the shortest, or if count, the # of shortest ladders and the
+// first few), until the user enters an empty word.  If options is
+// not NULL, every answer only enters the words it allows; if
+// closest is a CLOSEST_ metric, pairs with no ladder are answered
+// with the ladder to the closest reachable word.  Single ladders
+// come from the cache, if not NULL (see FindLadder), and a query
+// that runs out of the options' budget says so.
+//
+void RunInteractive(Graph *G, int numPaths, int count, SearchOptions *options, int closest,
+                    LadderCache *cache)
+{
+  char   line[256];
+  char   lin2[256];
+  int    linesize = sizeof(line) / sizeof(line[0]);
+
+  printf(">> enter a word (ENTER to quit): ");
+
+  fgets(line, linesize, stdin);
+  line[strcspn(line, "\r\n")] = '\0';  // strip EOL(s) char at end:
+
+  printf(">> enter another word : ");
+
+  fgets(lin2, linesize, stdin);
+  lin2[strcspn(lin2, "\r\n")] = '\0';  // strip EOL(s) char at end:
+
+  while (strlen(line) > 0 && strlen(lin2) > 0 )
+  {
+    timer_start();
+    int v1 = Name2Vertex(G, line);
+    int v2 = Name2Vertex(G, lin2);
+
+    if (v1 < 0)
+    {
+      printf("Word 1 not found");
+      PrintSuggestions(G, line);
+      printf(", please try again...\n");
+      timer_stop();
+    }
+    else if (v2 < 0)
+    {
+      printf("Word 2 not found");
+      PrintSuggestions(G, lin2);
+      printf(", please try again...\n");
+      timer_stop();
+    }
+    else if (count)
+    {
+      PrintShortestLadders(G, v1, v2, 10, options);
+
+      timer_stop();
+      timer_stats(">>Run time:    ");
+    }
+    else if (numPaths > 1)
+    {
+      SearchResult result;
+      int         *costs = (int *)mymalloc(numPaths * sizeof(int));
+      Vertex     **paths = KShortestPaths(G, v1, v2, numPaths, options, costs, &result);
+
+      if (paths[0] == NULL && result.Status != SEARCH_TIMEDOUT)
+        printf("There is no path from '%s' to '%s' \n", Vertex2Name(G, v1), Vertex2Name(G, v2));
+      else if (paths[0] != NULL)
+      {
+        printf("** Shortest Word Ladders: \n");
+        PrintLadders(G, paths, costs);
+      }
+
+      if (result.Status == SEARCH_TIMEDOUT)
+        PrintTimedOut(G, "** ", v1, NULL, &result);
+
+      timer_stop();
+      timer_stats(">>Run time:    ");
+
+      DeletePaths(paths);
+      myfree(costs);
+    }
+    else
+    {
+      SearchResult result;
+      int* path = FindLadder(G, v1, v2, options, cache, &result);
+
+      if (result.Status == SEARCH_TIMEDOUT)
+        PrintTimedOut(G, "** ", v1, path, &result);
+      else if (path[0] == -1) {
+        printf("There is no path from '%s' to '%s' \n", Vertex2Name(G, v1), Vertex2Name(G, v2));
+        if (closest != 0 && v1 != v2)
+          PrintClosest(G, "", v1, lin2, closest, options);
+        timer_stop();
+      }
+      else{
+        PrintDikstraPath(G, path);
+      }
+
+      timer_stop();
+      timer_stats(">>Run time:    ");
+      myfree(path);
+
+    }
+
+
+    printf("\n");
+    printf(">> enter a word (ENTER to quit): ");
+
+    fgets(line, linesize, stdin);
+    line[strcspn(line, "\r\n")] = '\0';  // strip EOL(s) char at end:
+
+    printf(">> enter another word : ");
+
+    fgets(lin2, linesize, stdin);
+    lin2[strcspn(lin2, "\r\n")] = '\0';  // strip EOL(s) char at end:
+  }
+}
+
+//
+// main:
+//
+// Usage: a.out [-dict file] [-edges probe|scan|lazy|hyper|implicit]
+//              [-filter bits] [-relabel bfs|rcm|degree] [-compress]
+//              [-batch file] [-matrix sources targets] [-patterns file]
+//              [-suggest edits] [-edits] [-cost unit|position|rarity]
+//              [-paths k] [-count] [-anyorder] [-avoid file]
+//              [-noletters [pos:]letters] [-closest hamming|edit]
+//              [-cache MB] [-timeout ms] [-steps n] [-partial]
+//
+// With no options, words are input interactively.  -edges picks
+// how edges are built (see AddEdges, AddEdgesByScan and
+// AddEdgesLazily), or with "hyper" stores word patterns instead of edges (see hyper.c), or
+// with "implicit" stores nothing (see implicit.c); -edits also
+// links words that differ by inserting or deleting a letter (see
+// AddEditEdges, needs probe or scan edges); -cost weighs each step
+// by the given cost model (see cost.c); -paths answers with up to
+// k ladders per query, shortest first (see kpaths.c); -count
+// answers with the # of shortest ladders, and the first 10 of them
+// (see spdag.c); -anyorder lets batch queries of more than 2 words
+// visit the words between the first and last in any order (see
+// waypoint.c); -avoid keeps ladders from entering the words in
+// the given file, and -noletters from entering words with any of
+// the given letters (at the given 1-based position, if any; may be
+// repeated), without changing the graph (see SearchOptions; not
+// with -matrix);
+// -closest answers single ladder queries with no ladder with the
+// ladder to the reachable word closest to the target, by Hamming
+// or edit distance, with an index of the components (see
+// closest.c); -cache keeps up to the given MB of ladders and
+// shortest-path trees found, to answer repeated queries from (see
+// cache.c; with -avoid, -noletters, -timeout or -steps it is not
+// used, and a note says so); -timeout and -steps give each query a budget of the
+// given ms or # of words settled, shared by all of its searches,
+// past which it gives up and says so (not with -matrix), and
+// -partial then also answers single ladder queries with the ladder
+// to the word reached closest to the target (see SearchOptions);
+// -filter checks
+// a Bloom filter of about the given bits per word before looking up
+// candidate words too long to pack (see bloom.c); -relabel
+// renumbers the vertices for locality once built (see relabel.c;
+// not with lazy edges, as it would build them all);
+// -compress replaces the adjacency lists by compressed ones; -batch
+// answers the "word1 word2" queries in the given file; -matrix
+// prints the ladder lengths from every word in one file to every
+// word in the other; -patterns answers the wildcard queries in the
+// given file, with a pattern index; -suggest builds an index of
+// the words within the given # of edits (1 or 2) of each word,
+// from which words not found are answered with suggestions (see
+// suggest.c).
+//
+int main(int argc, char *argv[])
+{
+  Graph *G;
+  char  *filename = "merriam-webster.txt";
+  char  *batchFile = NULL;
+  char  *sourcesFile = NULL;
+  char  *targetsFile = NULL;
+  char  *patternsFile = NULL;
+  char  *edges = "probe";
+  int    relabel = 0;    // RELABEL_ method, 0 => none
+  int    compress = 0;   /*false*/
+  int    edits = 0;      /*false*/
+  int    cost = 0;       // COST_ model, 0 => unit
+  int    numPaths = 1;   // ladders per query
+  int    count = 0;      /*false*/
+  int    anyOrder = 0;   /*false*/
+  char  *avoidFile = NULL;
+  char  *noLetters[SEARCH_MAXPOSITIONS];
+  int    numNoLetters = 0;
+  int    closest = 0;    // CLOSEST_ metric, 0 => none
+  int    cacheMB = 0;    // 0 => no cache
+  double timeLimit = 0;  // ms per search, 0 => none
+  int    maxSteps = 0;   // words settled per search, 0 => no limit
+  int    partial = 0;    /*false*/
+  int    filterBits = 0; // bits per word, 0 => no filter
+  int    suggestEdits = 0; // 0 => no suggestions
+  int    i;
+
+  for (i = 1; i < argc; ++i)
+  {
+    if (strcmp(argv[i], "-dict") == 0 && i + 1 < argc)
+      filename = argv[++i];
+    else if (strcmp(argv[i], "-edges") == 0 && i + 1 < argc &&
+             (strcmp(argv[i + 1], "probe") == 0 || strcmp(argv[i + 1], "scan") == 0 ||
+              strcmp(argv[i + 1], "lazy") == 0 ||
+              strcmp(argv[i + 1], "hyper") == 0 || strcmp(argv[i + 1], "implicit") == 0))
+      edges = argv[++i];
+    else if (strcmp(argv[i], "-relabel") == 0 && i + 1 < argc &&
+             ParseRelabelMethod(argv[i + 1]) != 0)
+      relabel = ParseRelabelMethod(argv[++i]);
+    else if (strcmp(argv[i], "-filter") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+      filterBits = atoi(argv[++i]);
+    else if (strcmp(argv[i], "-suggest") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+      suggestEdits = atoi(argv[++i]);
+    else if (strcmp(argv[i], "-cost") == 0 && i + 1 < argc &&
+             ParseCostModel(argv[i + 1]) != 0)
+      cost = ParseCostModel(argv[++i]);
+    else if (strcmp(argv[i], "-paths") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+      numPaths = atoi(argv[++i]);
+    else if (strcmp(argv[i], "-avoid") == 0 && i + 1 < argc)
+      avoidFile = argv[++i];
+    else if (strcmp(argv[i], "-noletters") == 0 && i + 1 < argc && numNoLetters < SEARCH_MAXPOSITIONS)
+      noLetters[numNoLetters++] = argv[++i];
+    else if (strcmp(argv[i], "-closest") == 0 && i + 1 < argc &&
+             ParseClosestMetric(argv[i + 1]) != 0)
+      closest = ParseClosestMetric(argv[++i]);
+    else if (strcmp(argv[i], "-cache") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+      cacheMB = atoi(argv[++i]);
+    else if (strcmp(argv[i], "-timeout") == 0 && i + 1 < argc && atof(argv[i + 1]) > 0)
+      timeLimit = atof(argv[++i]);
+    else if (strcmp(argv[i], "-steps") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+      maxSteps = atoi(argv[++i]);
+    else if (strcmp(argv[i], "-partial") == 0)
+      partial = 1;  /*true*/
+    else if (strcmp(argv[i], "-anyorder") == 0)
+      anyOrder = 1;  /*true*/
+    else if (strcmp(argv[i], "-count") == 0)
+      count = 1;  /*true*/
+    else if (strcmp(argv[i], "-edits") == 0)
+      edits = 1;  /*true*/
+    else if (strcmp(argv[i], "-compress") == 0)
+      compress = 1;  /*true*/
+    else if (strcmp(argv[i], "-batch") == 0 && i + 1 < argc)
+      batchFile = argv[++i];
+    else if (strcmp(argv[i], "-patterns") == 0 && i + 1 < argc)
+      patternsFile = argv[++i];
+    else if (strcmp(argv[i], "-matrix") == 0 && i + 2 < argc)
+    {
+      sourcesFile = argv[++i];
+      targetsFile = argv[++i];
+    }
+    else
+    {
+      printf("usage: %s [-dict file] [-edges probe|scan|lazy|hyper|implicit] [-filter bits] [-relabel bfs|rcm|degree] [-compress] [-batch file] [-matrix sources targets] [-patterns file] [-suggest edits] [-edits] [-cost unit|position|rarity] [-paths k] [-count] [-anyorder] [-avoid file] [-noletters [pos:]letters] [-closest hamming|edit] [-cache MB] [-timeout ms] [-steps n] [-partial]\n", argv[0]);
+      return -1;
+    }
+  }
+
+  if (relabel != 0 && strcmp(edges, "lazy") == 0)  // (it would build every length)
+  {
+    printf("**ERROR: -relabel does not apply to -edges lazy\n\n");
+    return -1;
+  }
+
+  if (sourcesFile != NULL && (avoidFile != NULL || numNoLetters > 0))
+  {
+    printf("**ERROR: -avoid and -noletters do not apply to -matrix\n\n");
+    return -1;
+  }
+
+  if (sourcesFile != NULL && (timeLimit > 0 || maxSteps > 0))
+  {
+    printf("**ERROR: -timeout and -steps do not apply to -matrix\n\n");
+    return -1;
+  }
+
+  printf("** Starting Word Ladder App **\n\n");
+
+  //
+  // (1) input words and insert each word as a vertex:
+  //
+  timer_start();
+
+  G = Read_and_AddWords(filename);
+
+  if (filterBits > 0)
+    BuildFilter(G, filterBits);
+
+  if (suggestEdits > 0)
+    BuildSuggester(G, suggestEdits);
+
+  if (cost != 0)  // before the edges, which are weighted as added:
+    UseCostModel(G, cost);
+
+  //
+  // (2) Now for each word, let's generate all possible
+  // words that differ by one letter, and add edges to/from
+  // these words in the graph:
+  //
+  if (strcmp(edges, "scan") == 0)
+    AddEdgesByScan(G);
+  else if (strcmp(edges, "lazy") == 0)
+    AddEdgesLazily(G);
+  else if (strcmp(edges, "hyper") == 0)
+    BuildHypergraph(G);
+  else if (strcmp(edges, "implicit") == 0)
+    UseImplicitEdges(G);
+  else
+    AddEdges(G);
+
+  if (edits && G->Hyper == NULL && !G->Implicit && G->Lazy == NULL)  // (else no lists)
+    AddEditEdges(G);
+
+  if (relabel != 0)
+  {
+    Vertex *order = RelabelOrder(G, relabel);
+
+    RelabelGraph(G, order);
+    myfree(order);
+  }
+
+  if (patternsFile != NULL)
+    BuildPatternIndex(G);
+
+  if (closest != 0)
+    BuildComponentIndex(G);
+
+  if (compress && G->Hyper == NULL && !G->Implicit && G->Lazy == NULL)  // (else no lists yet)
+    CompressGraph(G, 1 /*free lists*/);
+
+  //
+  // (3) print some graph stats:
+  //
+  PrintGraph(G, "Word Ladder", 0 /*false*/);
+
+  timer_stop();
+  timer_stats(">>Build time:    ");
+
+  printf("\n");
+
+  //
+  // (4) the words queries may not enter, and their budget, if any:
+  //
+  SearchOptions  filter;
+  SearchOptions *options = NULL;
+
+  InitSearchOptions(&filter);
+
+  if (avoidFile != NULL)
+  {
+    int     n;
+    Vertex *avoid = ReadWordList(G, avoidFile, &n);
+
+    for (i = 0; i < n; ++i)
+      ExcludeVertex(G, &filter, avoid[i]);
+
+    myfree(avoid);
+    options = &filter;
+  }
+
+  for (i = 0; i < numNoLetters; ++i)
+  {
+    char *colon = strchr(noLetters[i], ':');
+
+    if (colon != NULL && atoi(noLetters[i]) > 0)
+      ExcludeLetters(&filter, atoi(noLetters[i]) - 1, colon + 1);
+    else
+      ExcludeLetters(&filter, -1, noLetters[i]);
+
+    options = &filter;
+  }
+
+  if (timeLimit > 0 || maxSteps > 0)
+  {
+    filter.TimeLimit = timeLimit;
+    filter.MaxSteps = maxSteps;
+    filter.Partial = partial;
+    options = &filter;
+  }
+
+  LadderCache *cache = NULL;
+
+  if (cacheMB > 0 && options != NULL)  // (its entries would ignore them)
+    printf("** Note: -cache is not used with -avoid, -noletters, -timeout or -steps **\n\n");
+  else if (cacheMB > 0)
+    cache = CreateLadderCache(cacheMB * 1024LL * 1024LL);
+
+  //
+  // (5) answer queries, from files or from the user:
+  //
+  if (batchFile != NULL || sourcesFile != NULL || patternsFile != NULL)
+  {
+    timer_start();
+
+    if (batchFile != NULL)
+      RunBatch(G, batchFile, numPaths, count, anyOrder, options, closest, cache);
+    if (sourcesFile != NULL)
+      RunMatrix(G, sourcesFile, targetsFile);
+    if (patternsFile != NULL)
+      RunPatterns(G, patternsFile);
+
+    timer_stop();
+    timer_stats(">>Run time:    ");
+  }
+  else
+  {
+    RunInteractive(G, numPaths, count, options, closest, cache);
+  }
+
+  if (G->Lazy != NULL)
+  {
+    int numShards;
+    int numBuilt = ShardsMaterialized(G, &numShards);
+
+    printf(">>Shards built:  %d of %d, %d edges\n", numBuilt, numShards, G->NumEdges);
+  }
+
+  if (cache != NULL)
+  {
+    PrintCacheStats(cache);
+    DeleteLadderCache(cache);
+  }
+
+  //
+  // done:
+  //
+  ClearSearchOptions(&filter);
+  DeleteGraph(G);
+
+  printf("\n** Done **\n");
+  mymem_stats();
+
+  printf("\n");
+
+  return 0;
+}
@@ -0,0 +1,220 @@
+/*msbfs.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "msbfs.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Multi-source BFS:
+//
+// Runs up to 64 BFS's at once, one per bit of a 64-bit word.  Each
+// vertex has three bitmasks: "seen" (bit i set => source i reached
+// this vertex), "frontier" (reached at the current level) and "next"
+// (reached at the next level).  Expanding a vertex pushes its whole
+// frontier mask to every neighbor with one OR, so a vertex and its
+// edges are touched once per level for the whole batch instead of
+// once per source.
+//
+
+#define MSBFS_BATCH  64
+
+typedef unsigned long long BitMask;
+
+//
+// _runBatch:
+//
+// Fills in rows [first, first+count) of the distance table, i.e.
+// the distances from sources[first..] to every target.
+//
+static void _runBatch(Graph *G, Vertex *sources, int first, int count,
+                      Vertex *targets, int numTargets, int *table,
+                      BitMask *seen, BitMask *frontier, BitMask *next)
+{
+  int N = G->NumVertices;
+  int i, t;
+  Vertex v;
+
+  memset(seen, 0, N * sizeof(BitMask));
+  memset(frontier, 0, N * sizeof(BitMask));
+  memset(next, 0, N * sizeof(BitMask));
+
+  //
+  // level 0 is the sources themselves:
+  //
+  BitMask all = 0;
+
+  for (i = 0; i < count; ++i)
+  {
+    Vertex s = sources[first + i];
+
+    if (s < 0 || s >= N)  // invalid source, row stays all -1:
+      continue;
+
+    seen[s] |= (1ULL << i);
+    frontier[s] |= (1ULL << i);
+    all |= (1ULL << i);
+  }
+
+  //
+  // # of (source, target) pairs still to be found, so we can stop
+  // as soon as they are all done:
+  //
+  int remaining = 0;
+
+  for (t = 0; t < numTargets; ++t)
+  {
+    Vertex tv = targets[t];
+
+    if (tv < 0 || tv >= N)
+      continue;
+
+    for (i = 0; i < count; ++i)
+    {
+      if (!(all & (1ULL << i)))
+        continue;
+
+      if (seen[tv] & (1ULL << i))
+        table[(first + i) * numTargets + t] = 0;
+      else
+        remaining++;
+    }
+  }
+
+  int depth = 0;
+  int active = (all != 0);
+
+  while (active && remaining > 0)
+  {
+    depth++;
+
+    //
+    // top-down step: push each frontier to the neighbors:
+    //
+    for (v = 0; v < N; ++v)
+    {
+      BitMask f = frontier[v];
+
+      if (f == 0)
+        continue;
+
+      NeighborIter it;
+      Vertex       w;
+
+      BeginNeighbors(G, v, &it);
+      while ((w = NextNeighbor(&it, NULL)) != -1)
+        next[w] |= f;
+    }
+
+    //
+    // keep only bits that are new, and they become the frontier:
+    //
+    active = 0;
+
+    for (v = 0; v < N; ++v)
+    {
+      BitMask n = next[v] & ~seen[v];
+
+      seen[v] |= n;
+      frontier[v] = n;
+      next[v] = 0;
+
+      if (n != 0)
+        active = 1;
+    }
+
+    //
+    // record the targets reached at this depth:
+    //
+    for (t = 0; t < numTargets; ++t)
+    {
+      Vertex tv = targets[t];
+
+      if (tv < 0 || tv >= N)
+        continue;
+
+      BitMask reached = frontier[tv];
+
+      while (reached != 0)
+      {
+        i = __builtin_ctzll(reached);
+        reached &= reached - 1;
+
+        table[(first + i) * numTargets + t] = depth;
+        remaining--;
+      }
+    }
+  }
+}
+
+//
+// MultiSourceDistances:
+//
+// Computes the BFS distance (# of steps) from every source to every
+// target, returning a dynamically-allocated table of numSources rows
+// by numTargets columns: the distance from sources[s] to targets[t]
+// is table[s * numTargets + t].  Unreachable pairs, and pairs with an
+// invalid vertex id, have a distance of -1.  The sources are run in
+// batches of 64, one pass over the graph per BFS level per batch.
+//
+// NOTE: returns NULL if numSources or numTargets is < 1.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned table when they are done.
+//
+int *MultiSourceDistances(Graph *G, Vertex *sources, int numSources,
+                          Vertex *targets, int numTargets)
+{
+  int N = G->NumVertices;
+  int i;
+
+  if (numSources < 1 || numTargets < 1)
+    return NULL;
+
+  int *table = (int *)mymalloc(numSources * numTargets * sizeof(int));
+  if (table == NULL)
+  {
+    printf("\n**Error in MultiSourceDistances: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (i = 0; i < numSources * numTargets; ++i)
+    table[i] = -1;
+
+  if (N < 1)
+    return table;
+
+  BitMask *seen = (BitMask *)mymalloc(N * sizeof(BitMask));
+  BitMask *frontier = (BitMask *)mymalloc(N * sizeof(BitMask));
+  BitMask *next = (BitMask *)mymalloc(N * sizeof(BitMask));
+  if (seen == NULL || frontier == NULL || next == NULL)
+  {
+    printf("\n**Error in MultiSourceDistances: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (i = 0; i < numSources; i += MSBFS_BATCH)
+  {
+    int count = numSources - i;
+    if (count > MSBFS_BATCH)
+      count = MSBFS_BATCH;
+
+    _runBatch(G, sources, i, count, targets, numTargets, table,
+              seen, frontier, next);
+  }
+
+  myfree(seen);
+  myfree(frontier);
+  myfree(next);
+
+  return table;
+}
@@ -0,0 +1,9 @@
+/*msbfs.h*/
+
+//
+// Multi-source (bit-parallel) BFS:
+//
+// NOTE: include "graph.h" before this file.
+//
+int *MultiSourceDistances(Graph *G, Vertex *sources, int numSources,
+                          Vertex *targets, int numTargets);
@@ -1,15 +1,15 @@
-/*mymem.h*/
-
-//
-// wrapper funtions for malloc and free
-//
-// Prof. Joe Hummel
-// Visual Studio 2015 on Windows
-// U. of Illinois, Chicago
-// CS251, Fall 2016
-// HW #9
-//
-
-void *mymalloc(unsigned int size);
-void  myfree(void *ptr);
-void  mymem_stats();
+/*mymem.h*/
+
+//
+// wrapper funtions for malloc and free
+//
+// Prof. Joe Hummel
+// Visual Studio 2015 on Windows
+// U. of Illinois, Chicago
+// CS251, Fall 2016
+// HW #9
+//
+
+void *mymalloc(unsigned int size);
+void  myfree(void *ptr);
+void  mymem_stats();
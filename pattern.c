@@ -0,0 +1,442 @@
+/*pattern.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "hyper.h"
+#include "pattern.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Pattern queries:
+//
+// A pattern is a word in which '?' matches any one character, and
+// which may end with '*' to match any suffix.  Queries are served
+// three ways, cheapest first:
+//
+//   - one '?' and no '*': the words are the bucket of that pattern
+//     in the hypergraph, if there is one (see FindPattern), or else
+//     found by probing each character of the shard's alphabet at
+//     the wildcard, as AddEdges does;
+//   - otherwise, with a pattern index (BuildPatternIndex): for each
+//     length, the bitmaps of the words having each fixed character
+//     at its position are ANDed together, 64 words at a time;
+//   - otherwise, each length shard is scanned.
+//
+// Matches stream out of NextMatch, so a query that stops early
+// does not pay for the rest.
+//
+
+//
+// BuildPatternIndex:
+//
+// Builds G->Patterns: for each length shard, position and character
+// of the shard's alphabet there, the bitmap of the shard's words
+// that have that character at that position.
+//
+void BuildPatternIndex(Graph *G)
+{
+  int L, i, j, k;
+
+  if (G->Patterns != NULL)
+  {
+    DeletePatternIndex(G->Patterns);
+    G->Patterns = NULL;
+  }
+
+  PatternIndex *X = (PatternIndex *)mymalloc(sizeof(PatternIndex));
+  if (X == NULL)
+  {
+    printf("\n**Error in BuildPatternIndex: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  X->MaxLength = G->MaxLength;
+  X->Shards = (PatternShard *)mymalloc((G->MaxLength + 1) * sizeof(PatternShard));
+  X->Bytes = 0;
+  if (X->Shards == NULL)
+  {
+    printf("\n**Error in BuildPatternIndex: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (L = 0; L <= G->MaxLength; ++L)
+  {
+    Shard        *S = &G->Shards[L];
+    PatternShard *P = &X->Shards[L];
+    int           numBitmaps = 0;
+
+    P->NumChunks = (S->NumWords + 63) / 64;
+    P->Start = (int *)mymalloc((L + 1) * sizeof(int));
+    if (P->Start == NULL)
+    {
+      printf("\n**Error in BuildPatternIndex: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    for (i = 0; i < L; ++i)
+    {
+      P->Start[i] = numBitmaps;
+      numBitmaps += (int)strlen(S->Alphabet[i]);
+    }
+    P->Start[L] = numBitmaps;
+
+    P->Bitmaps = (unsigned long long **)mymalloc((numBitmaps + 1) * sizeof(unsigned long long *));
+    if (P->Bitmaps == NULL)
+    {
+      printf("\n**Error in BuildPatternIndex: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    for (j = 0; j < numBitmaps; ++j)
+    {
+      P->Bitmaps[j] = (unsigned long long *)mymalloc((P->NumChunks + 1) * sizeof(unsigned long long));
+      if (P->Bitmaps[j] == NULL)
+      {
+        printf("\n**Error in BuildPatternIndex: malloc failed to allocate\n\n");
+        exit(-1);
+      }
+
+      memset(P->Bitmaps[j], 0, P->NumChunks * sizeof(unsigned long long));
+    }
+
+    X->Bytes += (long long)numBitmaps * P->NumChunks * sizeof(unsigned long long);
+
+    for (k = 0; k < S->NumWords; ++k)
+    {
+      char *name = G->Names[S->Words[k]];
+
+      for (i = 0; i < L; ++i)
+      {
+        j = (int)(strchr(S->Alphabet[i], name[i]) - S->Alphabet[i]);
+
+        P->Bitmaps[P->Start[i] + j][k / 64] |= 1ULL << (k % 64);
+      }
+    }
+  }
+
+  G->Patterns = X;
+}
+
+//
+// DeletePatternIndex:
+//
+void DeletePatternIndex(PatternIndex *X)
+{
+  int L, j;
+
+  for (L = 0; L <= X->MaxLength; ++L)
+  {
+    PatternShard *P = &X->Shards[L];
+
+    for (j = 0; j < P->Start[L]; ++j)
+      myfree(P->Bitmaps[j]);
+
+    myfree(P->Bitmaps);
+    myfree(P->Start);
+  }
+
+  myfree(X->Shards);
+  myfree(X);
+}
+
+//
+// _probeWildcard:
+//
+// Returns a dynamically-allocated array of the words matching the
+// pattern, which has its only wildcard at pos, with their # in *n.
+//
+static Vertex *_probeWildcard(Graph *G, char *pattern, int len, int pos, int *n)
+{
+  char   *alphabet = G->Shards[len].Alphabet[pos];
+  Vertex *found = (Vertex *)mymalloc(((int)strlen(alphabet) + 1) * sizeof(Vertex));
+  char   *c;
+
+  if (found == NULL)
+  {
+    printf("\n**Error in BeginPattern: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  *n = 0;
+
+  for (c = alphabet; *c != '\0'; ++c)
+  {
+    Vertex w = Variant2Vertex(G, pattern, pos, *c);
+
+    if (w >= 0)
+      found[(*n)++] = w;
+  }
+
+  return found;
+}
+
+//
+// _matches:
+//
+// Returns true (non-zero) if the first n chars of name match the
+// pattern.
+//
+static int _matches(char *pattern, int n, char *name)
+{
+  int i;
+
+  for (i = 0; i < n; ++i)
+  {
+    if (pattern[i] != '?' && pattern[i] != name[i])
+      return 0;
+  }
+
+  return 1;
+}
+
+//
+// _chunk:
+//
+// Returns the bitmap of the iterator's current 64 words that match.
+//
+static unsigned long long _chunk(PatternIter *it)
+{
+  Shard             *S = &it->G->Shards[it->Length];
+  int                first = 64 * it->Chunk;
+  int                last = (first + 64 < S->NumWords) ? first + 64 : S->NumWords;
+  unsigned long long bits;
+  int                k;
+
+  if (it->Kind == PATTERN_BITMAPS)
+  {
+    bits = (last - first == 64) ? ~0ULL : (1ULL << (last - first)) - 1;
+
+    for (k = 0; k < it->NumBits && bits != 0; ++k)
+      bits &= it->Bits[k][it->Chunk];
+
+    return bits;
+  }
+
+  // else scan:
+  bits = 0;
+
+  for (k = first; k < last; ++k)
+  {
+    if (_matches(it->Pattern, it->Fixed, it->G->Names[S->Words[k]]))
+      bits |= 1ULL << (k - first);
+  }
+
+  return bits;
+}
+
+//
+// _beginShard:
+//
+// Sets up the iterator for the words of length it->Length, returning
+// false (0) if none can match.
+//
+static int _beginShard(PatternIter *it)
+{
+  Graph *G = it->G;
+  Shard *S = &G->Shards[it->Length];
+  int    i;
+
+  if (S->NumWords == 0)
+    return 0;
+
+  it->Chunk = 0;
+  it->NumChunks = (S->NumWords + 63) / 64;
+  it->NumBits = 0;
+
+  if (it->Kind == PATTERN_BITMAPS)
+  {
+    PatternShard *P = &G->Patterns->Shards[it->Length];
+
+    for (i = 0; i < it->Fixed; ++i)
+    {
+      char *c;
+
+      if (it->Pattern[i] == '?')
+        continue;
+
+      c = strchr(S->Alphabet[i], it->Pattern[i]);
+      if (c == NULL || *c == '\0')  // no word has it there:
+        return 0;
+
+      it->Bits[it->NumBits++] = P->Bitmaps[P->Start[i] + (int)(c - S->Alphabet[i])];
+    }
+  }
+
+  it->Current = _chunk(it);
+
+  return 1;
+}
+
+//
+// BeginPattern:
+//
+// Starts a query for the words matching the pattern, where '?'
+// matches any one character and a final '*' any suffix (possibly
+// empty).  If length > 0, only words of that length match.  Each
+// call to NextMatch then returns the next match, or -1 once there
+// are no more; the matches come in no particular order.  Call
+// EndPattern when done.  Example:
+//
+//   PatternIter it;
+//   Vertex      w;
+//
+//   BeginPattern(G, "c?t", 0, &it);
+//   while ((w = NextMatch(&it)) != -1)
+//     printf("%s\n", Vertex2Name(G, w));
+//   EndPattern(&it);
+//
+// NOTE: the pattern must not change until EndPattern is called.
+//
+void BeginPattern(Graph *G, char *pattern, int length, PatternIter *it)
+{
+  int len = (int)strlen(pattern);
+  int star = (len > 0 && pattern[len - 1] == '*');
+  int wildcards = 0, pos = -1;
+  int i;
+
+  it->G = G;
+  it->Pattern = pattern;
+  it->Fixed = len - star;
+  it->Kind = PATTERN_NONE;
+  it->List = NULL;
+  it->ListPos = it->ListEnd = 0;
+  it->OwnsList = 0;  /*false*/
+  it->Bits = NULL;
+  it->Current = 0;
+
+  for (i = 0; i < it->Fixed; ++i)
+  {
+    if (pattern[i] == '?')
+    {
+      wildcards++;
+      pos = i;
+    }
+  }
+
+  //
+  // the range of lengths to look at:
+  //
+  it->Length = it->Fixed;
+  it->LastLength = star ? G->MaxLength : it->Fixed;
+
+  if (length > 0)
+  {
+    if (length < it->Length || length > it->LastLength)  // nothing:
+      return;
+
+    it->Length = it->LastLength = length;
+  }
+
+  if (G->Shards == NULL || it->Length > G->MaxLength || (it->Fixed == 0 && !star))
+    return;
+
+  //
+  // one wildcard, one length: a bucket, or probes:
+  //
+  if (wildcards == 1 && !star)
+  {
+    int p = (G->Hyper != NULL) ? FindPattern(G, pattern, pos) : -1;
+
+    it->Kind = PATTERN_LIST;
+
+    if (p >= 0)
+    {
+      it->List = &G->Hyper->PatternWords[G->Hyper->PatternStart[p]];
+      it->ListEnd = G->Hyper->PatternStart[p + 1] - G->Hyper->PatternStart[p];
+    }
+    else
+    {
+      it->List = _probeWildcard(G, pattern, it->Fixed, pos, &it->ListEnd);
+      it->OwnsList = 1;  /*true*/
+    }
+
+    return;
+  }
+
+  //
+  // otherwise bitmaps or scans, shard by shard:
+  //
+  it->Kind = (G->Patterns != NULL) ? PATTERN_BITMAPS : PATTERN_SCAN;
+
+  it->Bits = (unsigned long long **)mymalloc((it->Fixed + 1) * sizeof(unsigned long long *));
+  if (it->Bits == NULL)
+  {
+    printf("\n**Error in BeginPattern: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  if (it->LastLength > G->MaxLength)
+    it->LastLength = G->MaxLength;
+
+  while (it->Length <= it->LastLength && !_beginShard(it))
+    it->Length++;
+}
+
+//
+// NextMatch:
+//
+// Returns the next word matching the iterator's pattern, or -1 if
+// there are no more.
+//
+Vertex NextMatch(PatternIter *it)
+{
+  if (it->Kind == PATTERN_LIST)
+    return (it->ListPos < it->ListEnd) ? it->List[it->ListPos++] : -1;
+
+  if (it->Kind == PATTERN_NONE)
+    return -1;
+
+  while (it->Length <= it->LastLength)
+  {
+    if (it->Current != 0)  // next match of this chunk:
+    {
+      int k = 64 * it->Chunk + __builtin_ctzll(it->Current);
+
+      it->Current &= it->Current - 1;
+
+      return it->G->Shards[it->Length].Words[k];
+    }
+
+    if (++it->Chunk < it->NumChunks)
+    {
+      it->Current = _chunk(it);
+      continue;
+    }
+
+    //
+    // on to the next length with words that can match:
+    //
+    do
+      it->Length++;
+    while (it->Length <= it->LastLength && !_beginShard(it));
+  }
+
+  return -1;
+}
+
+//
+// EndPattern:
+//
+// Frees the memory used by the query.
+//
+void EndPattern(PatternIter *it)
+{
+  if (it->OwnsList)
+    myfree(it->List);
+  if (it->Bits != NULL)
+    myfree(it->Bits);
+
+  it->Kind = PATTERN_NONE;
+  it->List = NULL;
+  it->Bits = NULL;
+  it->OwnsList = 0;  /*false*/
+}
@@ -0,0 +1,51 @@
+/*pattern.h*/
+
+//
+// Wildcard pattern queries ("c?t", "??ing", "re?d*"):
+//
+// NOTE: include "graph.h" before this file.
+//
+#define PATTERN_NONE     0  // kinds of pattern iteration:
+#define PATTERN_LIST     1
+#define PATTERN_BITMAPS  2
+#define PATTERN_SCAN     3
+
+typedef struct PatternShard  // bitmaps of one length shard:
+{
+  int                  NumChunks;   // 64-bit words per bitmap
+  unsigned long long **Bitmaps;     // Bitmaps[Start[i] + j]: the words
+  int                 *Start;       //   with Alphabet[i][j] at position i
+} PatternShard;
+
+typedef struct PatternIndex
+{
+  int           MaxLength;
+  PatternShard *Shards;
+  long long     Bytes;
+} PatternIndex;
+
+typedef struct PatternIter  // see BeginPattern:
+{
+  Graph               *G;
+  char                *Pattern;
+  int                  Fixed;       // # of chars before any '*'
+  int                  Kind;        // PATTERN_ kind
+  Vertex              *List;        // list: the matches,
+  int                  ListPos;
+  int                  ListEnd;
+  int                  OwnsList;    //   allocated by BeginPattern?
+  int                  Length;      // bitmaps/scan: current shard,
+  int                  LastLength;  //   up to this one
+  unsigned long long **Bits;        // bitmaps: of the fixed positions
+  int                  NumBits;
+  int                  Chunk;       // bitmaps/scan: current 64 words,
+  int                  NumChunks;
+  unsigned long long   Current;     //   and those left to return
+} PatternIter;
+
+void   BuildPatternIndex(Graph *G);
+void   DeletePatternIndex(PatternIndex *X);
+
+void   BeginPattern(Graph *G, char *pattern, int length, PatternIter *it);
+Vertex NextMatch(PatternIter *it);
+void   EndPattern(PatternIter *it);
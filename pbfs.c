@@ -0,0 +1,587 @@
+/*pbfs.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "pbfs.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Parallel BFS:
+//
+// The search is level-synchronous: the vertices of the current
+// level (the frontier) are split into chunks that the workers
+// claim with an atomic counter.  A neighbor is claimed by whichever
+// worker first flips its "discovered" byte from 0 to 1, and is then
+// marked in a bitmap of the next level.  Once a level is done, the
+// bitmap's words are split into one range per worker: each counts
+// the bits of its range, then, past a barrier, adds up the counts
+// of the ranges before its own and writes its vertices from there,
+// clearing the bits as it goes.  The next level thus comes out in
+// ascending order with no sort or merge, and every worker does an
+// equal share; the output is deterministic, level by level and
+// ascending within a level, no matter how many threads are used.
+//
+// The workers live in a pool (see CreateParallelBFS) that serves
+// any number of searches, so a search doesn't pay to start threads.
+//
+
+#define PBFS_CHUNK  64  // # of frontier vertices claimed at a time
+
+typedef struct PBFSWorkerArg
+{
+  PBFS *Search;
+  int   Id;
+} PBFSWorkerArg;
+
+
+//
+// DefaultNumThreads:
+//
+// Returns the # of processors online, which is the # of threads
+// used when a parallel search is asked for <= 0 threads.
+//
+int DefaultNumThreads()
+{
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+  if (n < 1)
+    return 1;
+
+  return (int)n;
+}
+
+//
+// _barrier:
+//
+// Blocks until all threads of the pool have arrived.
+//
+static void _barrier(PBFS *S)
+{
+  pthread_mutex_lock(&S->Lock);
+
+  int generation = S->Generation;
+
+  S->Waiting++;
+  if (S->Waiting == S->NumThreads)  // last one in, release everyone:
+  {
+    S->Waiting = 0;
+    S->Generation++;
+    pthread_cond_broadcast(&S->Cond);
+  }
+  else
+  {
+    while (generation == S->Generation)
+      pthread_cond_wait(&S->Cond, &S->Lock);
+  }
+
+  pthread_mutex_unlock(&S->Lock);
+}
+
+//
+// _expandLevel:
+//
+// Claims chunks of the frontier until none are left, marking the
+// undiscovered neighbors of each frontier vertex in the next level.
+//
+static void _expandLevel(PBFS *S)
+{
+  Graph *G = S->G;
+
+  while (1)
+  {
+    int start = __sync_fetch_and_add(&S->Cursor, PBFS_CHUNK);
+    if (start >= S->FrontierSize)
+      break;
+
+    int end = start + PBFS_CHUNK;
+    if (end > S->FrontierSize)
+      end = S->FrontierSize;
+
+    int k;
+    for (k = start; k < end; ++k)
+    {
+      NeighborIter it;
+      Vertex       adjV;
+
+      BeginNeighbors(G, S->Frontier[k], &it);
+
+      while ((adjV = NextNeighbor(&it, NULL)) != -1)  // for each edge out of frontier vertex:
+      {
+        if (S->Discovered[adjV] == 0 &&
+            __sync_bool_compare_and_swap(&S->Discovered[adjV], 0, 1))
+          __sync_fetch_and_or(&S->NextLevel[adjV >> 6], 1ULL << (adjV & 63));
+      }
+    }
+  }
+}
+
+//
+// _wordRange:
+//
+// Sets [*first, *last) to the words of the next-level bitmap that
+// worker t collects.
+//
+static void _wordRange(PBFS *S, int t, int *first, int *last)
+{
+  *first = (int)((long long)S->NumWords * t / S->NumThreads);
+  *last = (int)((long long)S->NumWords * (t + 1) / S->NumThreads);
+}
+
+//
+// _countLevel:
+//
+// Counts the vertices of the next level in worker t's words.
+//
+static void _countLevel(PBFS *S, int t)
+{
+  int first, last, w;
+  int n = 0;
+
+  _wordRange(S, t, &first, &last);
+
+  for (w = first; w < last; ++w)
+    n += __builtin_popcountll(S->NextLevel[w]);
+
+  S->Counts[t] = n;
+}
+
+//
+// _collectLevel:
+//
+// Writes the vertices of the next level in worker t's words to
+// S->Out, in ascending order after those of the workers before it,
+// and clears the words for the level after.
+//
+static void _collectLevel(PBFS *S, int t)
+{
+  int first, last, w, u;
+  int n = 0;
+
+  for (u = 0; u < t; ++u)
+    n += S->Counts[u];
+
+  _wordRange(S, t, &first, &last);
+
+  for (w = first; w < last; ++w)
+  {
+    unsigned long long bits = S->NextLevel[w];
+
+    while (bits != 0)
+    {
+      S->Out[n++] = (w << 6) + __builtin_ctzll(bits);
+      bits &= bits - 1;
+    }
+
+    S->NextLevel[w] = 0;
+  }
+}
+
+//
+// _level:
+//
+// Worker t's share of one level: expand the frontier into S->Out,
+// past the barriers that separate the phases.
+//
+static void _level(PBFS *S, int t)
+{
+  _expandLevel(S);
+  _barrier(S);  // level discovered:
+
+  _countLevel(S, t);
+  _barrier(S);  // counts known:
+
+  _collectLevel(S, t);
+}
+
+static void *_workerMain(void *arg)
+{
+  PBFS *S = ((PBFSWorkerArg *)arg)->Search;
+  int   t = ((PBFSWorkerArg *)arg)->Id;
+
+  myfree(arg);
+
+  while (1)
+  {
+    _barrier(S);  // wait for next level:
+
+    if (S->Done)
+      break;
+
+    _level(S, t);
+
+    _barrier(S);  // level done:
+  }
+
+  return NULL;
+}
+
+//
+// CreateParallelBFS:
+//
+// Returns a pool of numThreads workers (<= 0 => one per processor)
+// for parallel searches on G (or on any graph with no more
+// vertices); the calling thread is one of them, so numThreads-1
+// threads are started.  See PoolBFS, PoolBFSd and PoolReachable.
+//
+// NOTE: it is the responsibility of the CALLER to free the pool
+// (DeleteParallelBFS) when they are done.
+//
+PBFS *CreateParallelBFS(Graph *G, int numThreads)
+{
+  int t;
+
+  if (numThreads <= 0)
+    numThreads = DefaultNumThreads();
+  if (numThreads > 256)
+    numThreads = 256;
+
+  PBFS *S = (PBFS *)mymalloc(sizeof(PBFS));
+  if (S == NULL)
+  {
+    printf("\n**Error in CreateParallelBFS: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  S->G = G;
+  S->NumVertices = G->NumVertices;
+  S->NumWords = G->NumVertices / 64 + 1;
+  S->Discovered = (unsigned char *)mymalloc((S->NumVertices + 1) * sizeof(unsigned char));
+  S->NextLevel = (unsigned long long *)mymalloc(S->NumWords * sizeof(unsigned long long));
+  S->Counts = (int *)mymalloc(numThreads * sizeof(int));
+  S->Threads = (pthread_t *)mymalloc(numThreads * sizeof(pthread_t));
+  if (S->Discovered == NULL || S->NextLevel == NULL || S->Counts == NULL || S->Threads == NULL)
+  {
+    printf("\n**Error in CreateParallelBFS: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  memset(S->NextLevel, 0, S->NumWords * sizeof(unsigned long long));
+
+  S->Frontier = NULL;
+  S->FrontierSize = 0;
+  S->Cursor = 0;
+  S->Out = NULL;
+  S->Done = 0;
+  S->NumThreads = numThreads;
+  S->Waiting = 0;
+  S->Generation = 0;
+
+  pthread_mutex_init(&S->Lock, NULL);
+  pthread_cond_init(&S->Cond, NULL);
+
+  //
+  // the calling thread is worker 0, start the others:
+  //
+  for (t = 1; t < numThreads; ++t)
+  {
+    PBFSWorkerArg *arg = (PBFSWorkerArg *)mymalloc(sizeof(PBFSWorkerArg));
+    if (arg == NULL)
+    {
+      printf("\n**Error in CreateParallelBFS: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    arg->Search = S;
+    arg->Id = t;
+
+    if (pthread_create(&S->Threads[t], NULL, _workerMain, arg) != 0)
+    {
+      printf("\n**Error in CreateParallelBFS: pthread_create failed\n\n");
+      exit(-1);
+    }
+  }
+
+  return S;
+}
+
+//
+// DeleteParallelBFS:
+//
+// Stops the pool's workers and frees it.
+//
+void DeleteParallelBFS(PBFS *S)
+{
+  int t;
+
+  S->Done = 1;
+  _barrier(S);  // release the workers so they exit:
+
+  for (t = 1; t < S->NumThreads; ++t)
+    pthread_join(S->Threads[t], NULL);
+
+  pthread_mutex_destroy(&S->Lock);
+  pthread_cond_destroy(&S->Cond);
+
+  myfree(S->Discovered);
+  myfree(S->NextLevel);
+  myfree(S->Counts);
+  myfree(S->Threads);
+  myfree(S);
+}
+
+//
+// _parallelSearch:
+//
+// Shared engine for the functions below.  Searches at most
+// maxDepth levels from v (all levels if maxDepth < 0), stopping
+// early once dest (if >= 0) is discovered.  If markers is true,
+// a -1 follows every level, exactly maxDepth+1 of them, as BFSd
+// does.  Returns the -1 terminated array of visited vertices.
+//
+static Vertex *_parallelSearch(PBFS *S, Vertex v, int maxDepth, Vertex dest, int markers)
+{
+  Graph  *G = S->G;
+  Vertex *visited;
+  int     N;
+  int     i, t;
+
+  if (G->NumVertices > S->NumVertices)
+  {
+    printf("\n**Error in ParallelBFS: pool is too small for the graph\n\n");
+    exit(-1);
+  }
+
+  //
+  // allocate array of worst-case size: # of vertices + markers + 1
+  //
+  N = G->NumVertices + (markers ? maxDepth + 1 : 0) + 1;
+
+  visited = (Vertex *)mymalloc(N * sizeof(Vertex));
+  if (visited == NULL)
+  {
+    printf("\n**Error in ParallelBFS: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  memset(S->Discovered, 0, G->NumVertices * sizeof(unsigned char));
+
+  //
+  // level 0 is just v:
+  //
+  S->Discovered[v] = 1;
+  visited[0] = v;
+  i = 1;
+
+  int levelStart = 0;
+  int levelSize = 1;
+  int depth = 0;
+
+  if (markers)
+  {
+    visited[i] = -1;
+    ++i;
+  }
+
+  while (levelSize > 0 && (maxDepth < 0 || depth < maxDepth))
+  {
+    if (dest >= 0 && S->Discovered[dest])  // found, no need to go on:
+      break;
+
+    //
+    // the next level goes right after the current one, and
+    // becomes the next frontier:
+    //
+    S->Frontier = &visited[levelStart];
+    S->FrontierSize = levelSize;
+    S->Cursor = 0;
+    S->Out = &visited[i];
+
+    _barrier(S);  // release workers on this level:
+    _level(S, 0);
+    _barrier(S);  // wait for them to finish it:
+
+    levelStart = i;
+    levelSize = 0;
+    for (t = 0; t < S->NumThreads; ++t)
+      levelSize += S->Counts[t];
+
+    i += levelSize;
+    depth++;
+
+    if (markers)
+    {
+      visited[i] = -1;
+      ++i;
+    }
+  }
+
+  //
+  // BFSd always returns distance+1 markers, even if the search
+  // ran out of vertices before then:
+  //
+  if (markers)
+  {
+    while (depth < maxDepth)
+    {
+      visited[i] = -1;
+      ++i;
+      depth++;
+    }
+  }
+
+  visited[i] = -1;  // mark end of vertices with -1:
+
+  return visited;
+}
+
+//
+// PoolBFS:
+//
+// Same as ParallelBFS, with the workers of the pool S.
+//
+// NOTE: returns NULL if v is not a valid vertex id.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *PoolBFS(PBFS *S, Vertex v)
+{
+  if (v < 0 || v >= S->G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  return _parallelSearch(S, v, -1, -1, 0 /*false*/);
+}
+
+//
+// PoolBFSd:
+//
+// Same as ParallelBFSd, with the workers of the pool S.
+//
+// NOTE: returns NULL if v is not a valid vertex id, or
+// if distance < 1.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *PoolBFSd(PBFS *S, Vertex v, int distance)
+{
+  if (v < 0 || v >= S->G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  if (distance < 1)
+    return NULL;
+
+  return _parallelSearch(S, v, distance, -1, 1 /*true*/);
+}
+
+//
+// PoolReachable:
+//
+// Same as ParallelReachable, with the workers of the pool S.
+//
+int PoolReachable(PBFS *S, Vertex src, Vertex dest)
+{
+  if (src < 0 || src >= S->G->NumVertices)  // invalid vertex #:
+    return 0;
+  if (dest < 0 || dest >= S->G->NumVertices)  // invalid vertex #:
+    return 0;
+
+  Vertex *visited = _parallelSearch(S, src, -1, dest, 0 /*false*/);
+
+  int found = 0;  /*false*/
+  int i;
+
+  for (i = 0; visited[i] != -1; ++i)
+  {
+    if (visited[i] == dest)
+    {
+      found = 1;  /*true*/
+      break;
+    }
+  }
+
+  myfree(visited);
+
+  return found;
+}
+
+//
+// ParallelBFS:
+//
+// Performs a breadth-first search starting from vertex v using
+// numThreads threads (<= 0 => one per processor), returning a
+// dynamically-allocated array of the vertices visited, followed
+// by -1.  v appears first; then come the vertices 1 step away,
+// then 2 steps away, etc.  Unlike BFS(), the vertices within a
+// step are returned in ascending order.
+//
+// NOTE: returns NULL if v is not a valid vertex id.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *ParallelBFS(Graph *G, Vertex v, int numThreads)
+{
+  if (v < 0 || v >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  PBFS   *S = CreateParallelBFS(G, numThreads);
+  Vertex *visited = PoolBFS(S, v);
+
+  DeleteParallelBFS(S);
+
+  return visited;
+}
+
+//
+// ParallelBFSd:
+//
+// Same as ParallelBFS, but stops after walking "distance" steps
+// away from v.  The returned array contains -1 markers after each
+// step, exactly as returned by BFSd().
+//
+// NOTE: returns NULL if v is not a valid vertex id, or
+// if distance < 1.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *ParallelBFSd(Graph *G, Vertex v, int distance, int numThreads)
+{
+  if (v < 0 || v >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  if (distance < 1)
+    return NULL;
+
+  PBFS   *S = CreateParallelBFS(G, numThreads);
+  Vertex *visited = PoolBFSd(S, v, distance);
+
+  DeleteParallelBFS(S);
+
+  return visited;
+}
+
+//
+// ParallelReachable:
+//
+// Returns true (non-zero) if there is a path from src to dest,
+// false (0) if not or if either vertex is invalid.  The search
+// stops at the first level that reaches dest.
+//
+int ParallelReachable(Graph *G, Vertex src, Vertex dest, int numThreads)
+{
+  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
+    return 0;
+  if (dest < 0 || dest >= G->NumVertices)  // invalid vertex #:
+    return 0;
+
+  PBFS *S = CreateParallelBFS(G, numThreads);
+  int   found = PoolReachable(S, src, dest);
+
+  DeleteParallelBFS(S);
+
+  return found;
+}
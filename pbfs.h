@@ -0,0 +1,43 @@
+/*pbfs.h*/
+
+//
+// Parallel (level-synchronous) BFS:
+//
+// NOTE: include "graph.h" before this file.
+//
+#include <pthread.h>
+
+typedef struct PBFS  // a pool of workers, see CreateParallelBFS:
+{
+  Graph              *G;
+  int                 NumVertices;  // sized for graphs of up to this many
+  unsigned char      *Discovered;   // 1 => claimed by some worker
+  unsigned long long *NextLevel;    // bit v set => v discovered this level
+  int                 NumWords;     //   (in this many words)
+  Vertex             *Frontier;     // current level:
+  int                 FrontierSize;
+  int                 Cursor;       // start of next unclaimed chunk
+  Vertex             *Out;          // where the next level is written,
+  int                *Counts;       //   Counts[t] of it from worker t's words
+  int                 Done;         // true => workers should exit
+
+  int                 NumThreads;
+  pthread_t          *Threads;      // (Threads[0] unused: the caller is worker 0)
+
+  pthread_mutex_t     Lock;         // barrier:
+  pthread_cond_t      Cond;
+  int                 Waiting;
+  int                 Generation;
+} PBFS;
+
+int     DefaultNumThreads();
+
+PBFS   *CreateParallelBFS(Graph *G, int numThreads);
+void    DeleteParallelBFS(PBFS *S);
+Vertex *PoolBFS(PBFS *S, Vertex v);
+Vertex *PoolBFSd(PBFS *S, Vertex v, int distance);
+int     PoolReachable(PBFS *S, Vertex src, Vertex dest);
+
+Vertex *ParallelBFS(Graph *G, Vertex v, int numThreads);
+Vertex *ParallelBFSd(Graph *G, Vertex v, int distance, int numThreads);
+int     ParallelReachable(Graph *G, Vertex src, Vertex dest, int numThreads);
@@ -0,0 +1,436 @@
+/*relabel.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "relabel.h"
+#include "hyper.h"
+#include "pattern.h"
+#include "suggest.h"
+#include "search.h"
+#include "closest.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Relabeling:
+//
+// Vertex #s are assigned in dictionary order, so ladder neighbors
+// such as "cat", "bat" and "hat" end up far apart in every per-
+// vertex array.  RelabelOrder computes an order that places
+// neighbors close together, and RelabelGraph renumbers the graph
+// in that order: names, keys, adjacency lists (re-allocated in the
+// new order so the edge nodes are laid out contiguously too), the
+// name indexes and the shards.  G->Original maps each new vertex #
+// back to its original #.
+//
+
+static int *g_degree;  // for the qsort comparators below:
+
+static int _byDegreeAscending(const void *a, const void *b)
+{
+  Vertex v1 = *(const Vertex *)a;
+  Vertex v2 = *(const Vertex *)b;
+
+  if (g_degree[v1] != g_degree[v2])
+    return g_degree[v1] - g_degree[v2];
+
+  return (v1 > v2) - (v1 < v2);
+}
+
+static int _byDegreeDescending(const void *a, const void *b)
+{
+  Vertex v1 = *(const Vertex *)a;
+  Vertex v2 = *(const Vertex *)b;
+
+  if (g_degree[v1] != g_degree[v2])
+    return g_degree[v2] - g_degree[v1];
+
+  return (v1 > v2) - (v1 < v2);
+}
+
+//
+// _degrees:
+//
+// Returns a dynamically-allocated array of the # of edges out
+// of each vertex.
+//
+static int *_degrees(Graph *G)
+{
+  int *degree = (int *)mymalloc((G->NumVertices + 1) * sizeof(int));
+  int  v;
+
+  if (degree == NULL)
+  {
+    printf("\n**Error in RelabelOrder: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    NeighborIter it;
+
+    degree[v] = 0;
+
+    BeginNeighbors(G, v, &it);
+    while (NextNeighbor(&it, NULL) != -1)
+      degree[v]++;
+  }
+
+  return degree;
+}
+
+//
+// _breadthFirstOrder:
+//
+// Fills order[] with the vertices in BFS order, starting a new BFS
+// from each vertex of starts[] not yet reached.  If byDegree is
+// true, the neighbors of a vertex are taken in ascending order of
+// degree (Cuthill-McKee), otherwise in ascending order.
+//
+static void _breadthFirstOrder(Graph *G, Vertex *starts, int byDegree,
+                               Vertex *order)
+{
+  int            N = G->NumVertices;
+  unsigned char *reached = (unsigned char *)mymalloc(N + 1);
+  Vertex        *neighbors = (Vertex *)mymalloc((N + 1) * sizeof(Vertex));
+  int            head = 0, tail = 0;
+  int            s;
+
+  if (reached == NULL || neighbors == NULL)
+  {
+    printf("\n**Error in RelabelOrder: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  memset(reached, 0, N);
+
+  //
+  // order[] doubles as the BFS queue: vertices are dequeued from
+  // head and enqueued at tail:
+  //
+  for (s = 0; s < N; ++s)
+  {
+    if (reached[starts[s]])
+      continue;
+
+    reached[starts[s]] = 1;
+    order[tail++] = starts[s];
+
+    while (head < tail)
+    {
+      Vertex v = order[head++];
+      Vertex w;
+      int    n = 0;
+
+      NeighborIter it;
+
+      BeginNeighbors(G, v, &it);
+      while ((w = NextNeighbor(&it, NULL)) != -1)
+      {
+        if (!reached[w])
+        {
+          reached[w] = 1;
+          neighbors[n++] = w;
+        }
+      }
+
+      if (byDegree)
+        qsort(neighbors, n, sizeof(Vertex), _byDegreeAscending);
+
+      memcpy(&order[tail], neighbors, n * sizeof(Vertex));
+      tail += n;
+    }
+  }
+
+  myfree(reached);
+  myfree(neighbors);
+}
+
+//
+// RelabelOrder:
+//
+// Returns a dynamically-allocated array giving a new order of the
+// vertices, for RelabelGraph: order[i] is the vertex that becomes
+// vertex #i.  The method is one of:
+//
+//   RELABEL_BFS:    BFS order, one connected component after
+//                   another, so ladder neighbors get nearby #s.
+//   RELABEL_RCM:    reverse Cuthill-McKee, BFS from low-degree
+//                   vertices taking neighbors by ascending degree,
+//                   then reversed; minimizes the bandwidth.
+//   RELABEL_DEGREE: descending degree, so the most-visited (hub)
+//                   vertices share cache lines.
+//
+// NOTE: returns NULL if the method is unknown.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *RelabelOrder(Graph *G, int method)
+{
+  int     N = G->NumVertices;
+  Vertex *order;
+  Vertex *byDegree;
+  int     v;
+
+  if (method != RELABEL_BFS && method != RELABEL_RCM && method != RELABEL_DEGREE)
+    return NULL;
+
+  order = (Vertex *)mymalloc((N + 1) * sizeof(Vertex));
+  byDegree = (Vertex *)mymalloc((N + 1) * sizeof(Vertex));
+  if (order == NULL || byDegree == NULL)
+  {
+    printf("\n**Error in RelabelOrder: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  g_degree = _degrees(G);
+
+  for (v = 0; v < N; ++v)
+    byDegree[v] = v;
+
+  if (method == RELABEL_BFS)
+  {
+    _breadthFirstOrder(G, byDegree, 0 /*false*/, order);
+  }
+  else if (method == RELABEL_RCM)
+  {
+    qsort(byDegree, N, sizeof(Vertex), _byDegreeAscending);
+
+    _breadthFirstOrder(G, byDegree, 1 /*true*/, order);
+
+    for (v = 0; v < N / 2; ++v)  // reverse:
+    {
+      Vertex temp = order[v];
+      order[v] = order[N - 1 - v];
+      order[N - 1 - v] = temp;
+    }
+  }
+  else
+  {
+    qsort(byDegree, N, sizeof(Vertex), _byDegreeDescending);
+
+    memcpy(order, byDegree, N * sizeof(Vertex));
+  }
+
+  myfree(g_degree);
+  myfree(byDegree);
+
+  return order;
+}
+
+typedef struct EdgeRef  // an edge, and its place in its old list:
+{
+  Edge *E;
+  int   Index;
+} EdgeRef;
+
+static int _byDest(const void *a, const void *b)
+{
+  const EdgeRef *r1 = (const EdgeRef *)a;
+  const EdgeRef *r2 = (const EdgeRef *)b;
+
+  if (r1->E->dest != r2->E->dest)
+    return (r1->E->dest > r2->E->dest) - (r1->E->dest < r2->E->dest);
+
+  // same dest, keep the original order of the multi-edges:
+  return (r1->Index > r2->Index) - (r1->Index < r2->Index);
+}
+
+//
+// RelabelGraph:
+//
+// Renumbers the vertices of G so that vertex order[i] becomes
+// vertex #i, where order is a permutation of 0..NumVertices-1
+// (see RelabelOrder).  Names keep referring to the same words ---
+// Name2Vertex returns the new vertex #s --- and OriginalVertex
+// maps a new vertex # back to the # it had before any relabeling.
+//
+// NOTE: relabel once all vertices and edges have been added, and
+// before compressing the graph (CompressGraph).
+//
+void RelabelGraph(Graph *G, Vertex *order)
+{
+  if (G->Compressed != NULL)
+  {
+    printf("\n**Error in RelabelGraph: graph is compressed\n\n");
+    return;
+  }
+
+  int      N = G->NumVertices;
+  Vertex  *newOf = (Vertex *)mymalloc((N + 1) * sizeof(Vertex));
+  char   **names = (char **)mymalloc((N + 1) * sizeof(char *));
+  WordKey *keys = (WordKey *)mymalloc((N + 1) * sizeof(WordKey));
+  unsigned int *masks = (unsigned int *)mymalloc((N + 1) * sizeof(unsigned int));
+  Edge   **lists = (Edge **)mymalloc((N + 1) * sizeof(Edge *));
+  Vertex  *original = (Vertex *)mymalloc((N + 1) * sizeof(Vertex));
+  EdgeRef *edges = NULL;
+  int      maxDegree = 0;
+  int      i;
+
+  if (newOf == NULL || names == NULL || keys == NULL || masks == NULL || lists == NULL || original == NULL)
+  {
+    printf("\n**Error in RelabelGraph: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (i = 0; i < N; ++i)
+    newOf[order[i]] = i;
+
+  //
+  // names, keys, letter masks and original #s simply move:
+  //
+  for (i = 0; i < N; ++i)
+  {
+    names[i] = G->Names[order[i]];
+    keys[i] = G->Keys[order[i]];
+    masks[i] = G->LetterMask[order[i]];
+    original[i] = (G->Original == NULL) ? order[i] : G->Original[order[i]];
+    lists[i] = G->Vertices[order[i]];
+  }
+
+  memcpy(G->Names, names, N * sizeof(char *));
+  memcpy(G->Keys, keys, N * sizeof(WordKey));
+  memcpy(G->LetterMask, masks, N * sizeof(unsigned int));
+
+  if (G->Original != NULL)
+    myfree(G->Original);
+  G->Original = original;
+
+  //
+  // rebuild each adjacency list with new edge nodes, allocated in
+  // the new vertex order, and re-sorted by the new dest #s:
+  //
+  for (i = 0; i < N; ++i)
+  {
+    int   degree = 0;
+    Edge *cur = lists[i];
+
+    while (cur != NULL)
+    {
+      degree++;
+      cur = cur->next;
+    }
+
+    if (degree > maxDegree)
+      maxDegree = degree;
+  }
+
+  edges = (EdgeRef *)mymalloc((maxDegree + 1) * sizeof(EdgeRef));
+  if (edges == NULL)
+  {
+    printf("\n**Error in RelabelGraph: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (i = 0; i < N; ++i)
+  {
+    Edge *cur = lists[i];
+    int   n = 0;
+    int   j;
+
+    while (cur != NULL)
+    {
+      cur->src = i;
+      cur->dest = newOf[cur->dest];
+      edges[n].E = cur;
+      edges[n].Index = n;
+      n++;
+      cur = cur->next;
+    }
+
+    qsort(edges, n, sizeof(EdgeRef), _byDest);
+
+    Edge **link = &G->Vertices[i];
+
+    for (j = 0; j < n; ++j)
+    {
+      Edge *edge = (Edge *)mymalloc(sizeof(Edge));
+      if (edge == NULL)
+      {
+        printf("\n**Error in RelabelGraph: malloc failed to allocate\n\n");
+        exit(-1);
+      }
+
+      *edge = *edges[j].E;
+      *link = edge;
+      link = &edge->next;
+
+      myfree(edges[j].E);
+    }
+
+    *link = NULL;
+  }
+
+  //
+  // the name and suggestion indexes now point to the new #s:
+  //
+  for (i = 0; i < (1 << G->KeyTableBits); ++i)
+  {
+    if (G->KeyTable[i].V != -1)
+      G->KeyTable[i].V = newOf[G->KeyTable[i].V];
+  }
+
+  if (G->Suggest != NULL)
+  {
+    for (i = 0; i < G->Suggest->NumEntries; ++i)
+      G->Suggest->Entries[i].V = newOf[G->Suggest->Entries[i].V];
+  }
+
+  if (G->Shards != NULL)
+    BuildShards(G);
+
+  if (G->Hyper != NULL)  // cheaper to rebuild than to renumber:
+    BuildHypergraph(G);
+  if (G->Patterns != NULL)  // (the shards' words moved)
+    BuildPatternIndex(G);
+  if (G->Components != NULL)
+    BuildComponentIndex(G);
+
+  myfree(edges);
+  myfree(newOf);
+  myfree(names);
+  myfree(keys);
+  myfree(masks);
+  myfree(lists);
+}
+
+//
+// ParseRelabelMethod:
+//
+// Returns the RELABEL_ method named "bfs", "rcm" or "degree", or
+// 0 if the name is unknown.
+//
+int ParseRelabelMethod(char *name)
+{
+  if (strcmp(name, "bfs") == 0)
+    return RELABEL_BFS;
+  if (strcmp(name, "rcm") == 0)
+    return RELABEL_RCM;
+  if (strcmp(name, "degree") == 0)
+    return RELABEL_DEGREE;
+
+  return 0;
+}
+
+//
+// OriginalVertex:
+//
+// Returns the vertex # that v had before the graph was relabeled,
+// i.e. its position in the dictionary file.
+//
+Vertex OriginalVertex(Graph *G, Vertex v)
+{
+  if (G->Original == NULL || v < 0 || v >= G->NumVertices)
+    return v;
+
+  return G->Original[v];
+}
@@ -0,0 +1,15 @@
+/*relabel.h*/
+
+//
+// Vertex relabeling (reordering) for cache locality:
+//
+// NOTE: include "graph.h" before this file.
+//
+#define RELABEL_BFS     1  // breadth-first order, component by component
+#define RELABEL_RCM     2  // reverse Cuthill-McKee
+#define RELABEL_DEGREE  3  // descending degree
+
+Vertex *RelabelOrder(Graph *G, int method);
+void    RelabelGraph(Graph *G, Vertex *order);
+int     ParseRelabelMethod(char *name);
+Vertex  OriginalVertex(Graph *G, Vertex v);
@@ -0,0 +1,964 @@
+/*search.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <limits.h>
+#include <time.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "search.h"
+#include "suggest.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Weighted search:
+//
+// Edge weights are small integers (at most G->MaxWeight, see
+// cost.c), so Dijkstra's algorithm can take the next vertex from a
+// bucket queue (Dial's algorithm) rather than by comparisons: the
+// vertices queued at distance d are kept in bucket d mod C+1, where
+// C is the largest weight.  Every queued distance lies between the
+// current one and C more, so the buckets never mix two distances,
+// and the next vertex is found by stepping the current distance
+// until its bucket is not empty.  Each operation is O(1), and the
+// search costs O(V + E + longest distance), close to a BFS.  If
+// the weights are larger than DIAL_MAXWEIGHT, a binary heap is used
+// instead.
+//
+// The per-vertex arrays live in a SearchWorkspace, which can serve
+// any number of searches: rather than clearing them, each search
+// has a new Epoch, and an entry is only valid if its vertex's
+// Stamp is the current Epoch.  A workspace can also ban vertices
+// and edges from its searches, and bound their distance, as the
+// spur searches of KShortestPaths do (see kpaths.c); the bans are
+// stamped the same way, so clearing them is O(1) too.
+//
+// A workspace may also have SearchOptions, which filter the words a
+// search enters by the request: words excluded one by one (a
+// bitmask), words with banned letters, or with banned letters at
+// given positions (checked against each word's LetterMask and
+// name), or by any predicate.  They are checked as each edge is
+// relaxed, so the graph never changes; with no options, all it
+// costs is a NULL check.
+//
+// The options may also give a search a budget: a time limit, or a
+// # of vertices to settle.  Rather than read the clock for every
+// vertex, the search keeps the settled count at which it next
+// looks (every SEARCH_CHECKEVERY vertices, or at the step limit),
+// so the inner loop pays one compare.  The clock is the monotonic
+// wall clock, not CPU time, so the limit holds however many threads
+// run and however long the search waits.  A search out of budget
+// stops where it is and says so (SEARCH_TIMEDOUT), and what it
+// reached is still in the workspace, so BudgetedShortestPath can
+// return the ladder to the word it reached closest to dest.
+//
+// A query that runs many searches (KShortestPaths' spur searches,
+// WaypointLadder's legs) or a search of its own (the BFSs of
+// BuildShortestPathDAG) shares one budget between them instead: see
+// ShareBudget.  The time limit then runs from the start of the
+// query, and the step limit counts every vertex any of them settles.
+//
+
+//
+// CreateWorkspace:
+//
+// Returns a new workspace for searches on G (or on any graph with
+// no more vertices).
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// workspace (DeleteWorkspace) when they are done.
+//
+SearchWorkspace *CreateWorkspace(Graph *G)
+{
+  int N = G->NumVertices;
+
+  SearchWorkspace *W = (SearchWorkspace *)mymalloc(sizeof(SearchWorkspace));
+  if (W == NULL)
+  {
+    printf("\n**Error in CreateWorkspace: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  W->NumVertices = N;
+  W->Epoch = 0;
+  W->Stamp = (unsigned int *)mymalloc((N + 1) * sizeof(unsigned int));
+  W->Distance = (int *)mymalloc((N + 1) * sizeof(int));
+  W->Predecessor = (Vertex *)mymalloc((N + 1) * sizeof(Vertex));
+  W->Next = (Vertex *)mymalloc((N + 1) * sizeof(Vertex));
+  W->Prev = (Vertex *)mymalloc((N + 1) * sizeof(Vertex));
+  W->Buckets = (Vertex *)mymalloc((DIAL_MAXWEIGHT + 1) * sizeof(Vertex));
+  W->HeapCapacity = 1024;
+  W->HeapSize = 0;
+  W->Heap = (HeapEntry *)mymalloc(W->HeapCapacity * sizeof(HeapEntry));
+  W->ForceHeap = 0;  /*false*/
+  W->Settled = 0;
+  W->Order = (Vertex *)mymalloc((N + 1) * sizeof(Vertex));
+  W->Bans = 0;  /*false*/
+  W->Banned = (unsigned int *)mymalloc((N + 1) * sizeof(unsigned int));
+  W->BanEpoch = 1;
+  W->BanFrom = -1;
+  W->BanCapacity = 64;
+  W->BanTo = (Vertex *)mymalloc(W->BanCapacity * sizeof(Vertex));
+  W->NumBanTo = 0;
+  W->MaxDistance = -1;
+  W->Options = NULL;
+  W->Scanned = 0;
+  W->TimedOut = 0;  /*false*/
+  W->Shared = 0;  /*false*/
+  W->Started = W->Deadline = 0;
+  W->SharedSettled = W->SharedScanned = 0;
+  W->CheckAt = INT_MAX;
+
+  if (W->Stamp == NULL || W->Distance == NULL || W->Predecessor == NULL ||
+      W->Next == NULL || W->Prev == NULL || W->Buckets == NULL || W->Heap == NULL ||
+      W->Banned == NULL || W->BanTo == NULL || W->Order == NULL)
+  {
+    printf("\n**Error in CreateWorkspace: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  memset(W->Stamp, 0, (N + 1) * sizeof(unsigned int));
+  memset(W->Banned, 0, (N + 1) * sizeof(unsigned int));
+
+  return W;
+}
+
+//
+// DeleteWorkspace:
+//
+void DeleteWorkspace(SearchWorkspace *W)
+{
+  myfree(W->Stamp);
+  myfree(W->Distance);
+  myfree(W->Predecessor);
+  myfree(W->Next);
+  myfree(W->Prev);
+  myfree(W->Buckets);
+  myfree(W->Heap);
+  myfree(W->Banned);
+  myfree(W->BanTo);
+  myfree(W->Order);
+  myfree(W);
+}
+
+//
+// ClearBans:
+//
+// Lifts all the bans of W (see BanVertex and BanEdge).
+//
+void ClearBans(SearchWorkspace *W)
+{
+  W->BanEpoch++;
+
+  if (W->BanEpoch == 0)  // wrapped around, so stamps may be stale:
+  {
+    memset(W->Banned, 0, (W->NumVertices + 1) * sizeof(unsigned int));
+    W->BanEpoch = 1;
+  }
+
+  W->Bans = 0;  /*false*/
+  W->BanFrom = -1;
+  W->NumBanTo = 0;
+}
+
+//
+// BanVertex:
+//
+// Keeps the searches in W from entering v, until ClearBans.
+//
+void BanVertex(SearchWorkspace *W, Vertex v)
+{
+  W->Banned[v] = W->BanEpoch;
+  W->Bans = 1;  /*true*/
+}
+
+//
+// BanEdge:
+//
+// Keeps the searches in W from taking the edge from -> to, until
+// ClearBans.
+//
+// NOTE: the banned edges must all leave the same vertex.
+//
+void BanEdge(SearchWorkspace *W, Vertex from, Vertex to)
+{
+  assert(W->BanFrom == -1 || W->BanFrom == from);
+
+  if (W->NumBanTo == W->BanCapacity)  // full, double in size:
+  {
+    Vertex *banTo = (Vertex *)mymalloc(2 * W->BanCapacity * sizeof(Vertex));
+    if (banTo == NULL)
+    {
+      printf("\n**Error in BanEdge: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    memcpy(banTo, W->BanTo, W->NumBanTo * sizeof(Vertex));
+    myfree(W->BanTo);
+
+    W->BanTo = banTo;
+    W->BanCapacity *= 2;
+  }
+
+  W->BanFrom = from;
+  W->BanTo[W->NumBanTo++] = to;
+  W->Bans = 1;  /*true*/
+}
+
+//
+// InitSearchOptions:
+//
+// Initializes O to filter nothing; then see ExcludeVertex and
+// ExcludeLetters, or set O->Allow.  To filter the searches in a
+// workspace W, set W->Options = O.
+//
+// NOTE: it is the responsibility of the CALLER to free what the
+// options hold (ClearSearchOptions) when they are done.
+//
+void InitSearchOptions(SearchOptions *O)
+{
+  memset(O, 0, sizeof(SearchOptions));
+
+  O->Excluded = NULL;
+  O->Allow = NULL;
+  O->AllowCtx = NULL;
+}
+
+//
+// ClearSearchOptions:
+//
+// Frees what O holds, and resets it to filter nothing.
+//
+void ClearSearchOptions(SearchOptions *O)
+{
+  if (O->Excluded != NULL)
+    myfree(O->Excluded);
+
+  InitSearchOptions(O);
+}
+
+//
+// ExcludeVertex:
+//
+// Keeps the searches with options O from entering v.
+//
+void ExcludeVertex(Graph *G, SearchOptions *O, Vertex v)
+{
+  if (v < 0 || v >= G->NumVertices)  // invalid vertex #:
+    return;
+
+  if (O->Excluded == NULL)
+  {
+    O->NumExcluded = G->NumVertices;
+    O->Excluded = (unsigned char *)mymalloc(O->NumExcluded / 8 + 1);
+    if (O->Excluded == NULL)
+    {
+      printf("\n**Error in ExcludeVertex: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    memset(O->Excluded, 0, O->NumExcluded / 8 + 1);
+  }
+
+  assert(v < O->NumExcluded);
+
+  O->Excluded[v >> 3] |= (unsigned char)(1 << (v & 7));
+}
+
+//
+// ExcludeLetters:
+//
+// Keeps the searches with options O from entering words with any
+// of the given letters (a..z) at the given position (0-based), or
+// if position is -1, anywhere.
+//
+void ExcludeLetters(SearchOptions *O, int position, char *letters)
+{
+  unsigned int mask = 0;
+  char        *c;
+
+  for (c = letters; *c != '\0'; ++c)
+  {
+    if (*c >= 'a' && *c <= 'z')
+      mask |= 1u << (*c - 'a');
+  }
+
+  if (position < 0)
+    O->BannedLetters |= mask;
+  else if (position < SEARCH_MAXPOSITIONS)
+  {
+    O->BannedAt[position] |= mask;
+
+    if (position >= O->NumPositions)
+      O->NumPositions = position + 1;
+  }
+}
+
+//
+// IsExcluded:
+//
+// Returns true (non-zero) if the options O keep searches from
+// entering v.
+//
+int IsExcluded(Graph *G, SearchOptions *O, Vertex v)
+{
+  if (O->Excluded != NULL && v < O->NumExcluded && (O->Excluded[v >> 3] & (1 << (v & 7))))
+    return 1;
+
+  if (G->LetterMask[v] & O->BannedLetters)
+    return 1;
+
+  if (O->NumPositions > 0)
+  {
+    char *name = G->Names[v];
+    int   i;
+
+    for (i = 0; i < O->NumPositions && name[i] != '\0'; ++i)
+    {
+      if (name[i] >= 'a' && name[i] <= 'z' && (O->BannedAt[i] & (1u << (name[i] - 'a'))))
+        return 1;
+    }
+  }
+
+  if (O->Allow != NULL && !O->Allow(G, v, O->AllowCtx))
+    return 1;
+
+  return 0;
+}
+
+//
+// _banned:
+//
+// Returns true (non-zero) if the search may not take the edge from
+// v to w.
+//
+static int _banned(SearchWorkspace *W, Vertex v, Vertex w)
+{
+  int i;
+
+  if (W->Banned[w] == W->BanEpoch)
+    return 1;
+
+  if (v == W->BanFrom)
+  {
+    for (i = 0; i < W->NumBanTo; ++i)
+    {
+      if (W->BanTo[i] == w)
+        return 1;
+    }
+  }
+
+  return 0;
+}
+
+//
+// NewSearch:
+//
+// Starts a new search in W, invalidating every entry of the last.
+// (For searches other than SearchFrom's, such as the BFSs of
+// BuildShortestPathDAG, which mark the vertices they reach in W.)
+//
+void NewSearch(SearchWorkspace *W)
+{
+  W->Epoch++;
+
+  if (W->Epoch == 0)  // wrapped around, so stamps may be stale:
+  {
+    memset(W->Stamp, 0, (W->NumVertices + 1) * sizeof(unsigned int));
+    W->Epoch = 1;
+  }
+
+  W->Settled = 0;
+  W->HeapSize = 0;
+  W->Scanned = 0;
+  W->TimedOut = 0;  /*false*/
+}
+
+//
+// bucket queue:
+//
+static void _bucketInsert(SearchWorkspace *W, int numBuckets, Vertex v)
+{
+  int b = W->Distance[v] % numBuckets;
+
+  W->Next[v] = W->Buckets[b];
+  W->Prev[v] = -1;
+
+  if (W->Buckets[b] != -1)
+    W->Prev[W->Buckets[b]] = v;
+
+  W->Buckets[b] = v;
+}
+
+static void _bucketRemove(SearchWorkspace *W, int numBuckets, Vertex v)
+{
+  int b = W->Distance[v] % numBuckets;
+
+  if (W->Prev[v] != -1)
+    W->Next[W->Prev[v]] = W->Next[v];
+  else
+    W->Buckets[b] = W->Next[v];
+
+  if (W->Next[v] != -1)
+    W->Prev[W->Next[v]] = W->Prev[v];
+}
+
+//
+// binary heap, with stale entries skipped when popped:
+//
+static void _heapPush(SearchWorkspace *W, int distance, Vertex v)
+{
+  int i;
+
+  if (W->HeapSize == W->HeapCapacity)  // full, double in size:
+  {
+    HeapEntry *heap = (HeapEntry *)mymalloc(2 * W->HeapCapacity * sizeof(HeapEntry));
+    if (heap == NULL)
+    {
+      printf("\n**Error in SearchFrom: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    memcpy(heap, W->Heap, W->HeapSize * sizeof(HeapEntry));
+    myfree(W->Heap);
+
+    W->Heap = heap;
+    W->HeapCapacity *= 2;
+  }
+
+  for (i = W->HeapSize++; i > 0 && W->Heap[(i - 1) / 2].Distance > distance; i = (i - 1) / 2)
+    W->Heap[i] = W->Heap[(i - 1) / 2];
+
+  W->Heap[i].Distance = distance;
+  W->Heap[i].V = v;
+}
+
+static HeapEntry _heapPop(SearchWorkspace *W)
+{
+  HeapEntry top = W->Heap[0];
+  HeapEntry last = W->Heap[--W->HeapSize];
+  int       i = 0;
+
+  for (;;)
+  {
+    int child = 2 * i + 1;
+
+    if (child >= W->HeapSize)
+      break;
+    if (child + 1 < W->HeapSize && W->Heap[child + 1].Distance < W->Heap[child].Distance)
+      child++;
+    if (W->Heap[child].Distance >= last.Distance)
+      break;
+
+    W->Heap[i] = W->Heap[child];
+    i = child;
+  }
+
+  if (W->HeapSize > 0)
+    W->Heap[i] = last;
+
+  return top;
+}
+
+//
+// _now:
+//
+// Returns the monotonic wall-clock time, in ms.
+//
+static double _now(void)
+{
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+
+  return 1000.0 * t.tv_sec + t.tv_nsec / 1000000.0;
+}
+
+//
+// _nextCheck:
+//
+// Returns the # of settled vertices at which a search with options
+// O, having settled the given #, next checks its budget, given that
+// it may settle maxSteps (-1 => no limit); INT_MAX if it has none.
+//
+static int _nextCheck(SearchOptions *O, int maxSteps, int settled)
+{
+  int next = INT_MAX;
+
+  if (O == NULL)
+    return next;
+
+  if (O->TimeLimit > 0)
+    next = settled + SEARCH_CHECKEVERY;
+
+  if (maxSteps >= 0 && maxSteps < next)
+    next = (maxSteps > settled) ? maxSteps : settled;
+
+  return next;
+}
+
+//
+// _maxSteps:
+//
+// Returns the # of vertices the next search in W may settle, -1 if
+// there is no limit: the options' step limit, less what the searches
+// sharing it have settled (see ShareBudget).
+//
+static int _maxSteps(SearchWorkspace *W)
+{
+  int steps;
+
+  if (W->Options == NULL || W->Options->MaxSteps <= 0)
+    return -1;
+
+  steps = W->Options->MaxSteps;
+  if (W->Shared)
+    steps -= W->SharedSettled;
+
+  return (steps > 0) ? steps : 0;
+}
+
+//
+// SearchFrom:
+//
+// Runs Dijkstra's algorithm from src in workspace W, stopping once
+// dest is settled, or once every vertex reachable from src is if
+// dest is -1 --- avoiding W's banned vertices and edges, and not
+// going beyond W->MaxDistance if that is >= 0.  Returns the
+// distance from src to dest, or -1 if dest is unreachable (or -1
+// or too far); the distances and predecessors of
+// the vertices reached are then available from W (see
+// WorkspaceDistance and WorkspacePath) until its next search.  If
+// W has options, the words they exclude are never entered (nor is
+// anything, if they exclude src); if they give a budget and it runs
+// out first, returns SEARCH_TIMEDOUT, and W->TimedOut is true (the
+// budget is W's shared one, if any: see ShareBudget).
+//
+int SearchFrom(Graph *G, SearchWorkspace *W, Vertex src, Vertex dest)
+{
+  int useHeap = W->ForceHeap || G->MaxWeight > DIAL_MAXWEIGHT;
+  int numBuckets = G->MaxWeight + 1;
+  int queued = 1;
+  int current = 0;
+  int found = SEARCH_NOPATH;
+  int maxSteps = _maxSteps(W);
+  int checkAt = _nextCheck(W->Options, maxSteps, 0);
+  double deadline = 0;
+  int b;
+
+  if (G->NumVertices > W->NumVertices)
+  {
+    printf("\n**Error in SearchFrom: workspace is too small for the graph\n\n");
+    exit(-1);
+  }
+
+  NewSearch(W);
+
+  if (W->Options != NULL && IsExcluded(G, W->Options, src))
+    return SEARCH_NOPATH;
+
+  if (W->Options != NULL && W->Options->TimeLimit > 0)
+    deadline = W->Shared ? W->Deadline : _now() + W->Options->TimeLimit;
+
+  W->Stamp[src] = W->Epoch;
+  W->Distance[src] = 0;
+  W->Predecessor[src] = -1;
+
+  if (useHeap)
+    _heapPush(W, 0, src);
+  else
+  {
+    for (b = 0; b < numBuckets; ++b)
+      W->Buckets[b] = -1;
+
+    _bucketInsert(W, numBuckets, src);
+  }
+
+  while (queued > 0)
+  {
+    Vertex v;
+
+    if (useHeap)
+    {
+      HeapEntry top = _heapPop(W);
+
+      queued--;
+
+      if (top.Distance > W->Distance[top.V])  // stale, since improved:
+        continue;
+
+      v = top.V;
+    }
+    else
+    {
+      while (W->Buckets[current % numBuckets] == -1)
+        current++;
+
+      v = W->Buckets[current % numBuckets];
+      _bucketRemove(W, numBuckets, v);
+      queued--;
+    }
+
+    if (W->MaxDistance >= 0 && W->Distance[v] > W->MaxDistance)  // too far:
+      break;
+
+    if (W->Settled == checkAt)  // out of budget?
+    {
+      SearchOptions *O = W->Options;
+
+      if ((maxSteps >= 0 && W->Settled >= maxSteps) ||
+          (O->TimeLimit > 0 && _now() >= deadline))
+      {
+        W->TimedOut = 1;  /*true*/
+        found = SEARCH_TIMEDOUT;
+        break;
+      }
+
+      checkAt = _nextCheck(O, maxSteps, W->Settled);
+    }
+
+    W->Order[W->Settled++] = v;
+
+    if (v == dest)
+    {
+      found = W->Distance[v];
+      break;
+    }
+
+    //
+    // relax v's edges:
+    //
+    NeighborIter it;
+    Vertex       w;
+    int          weight;
+
+    BeginNeighbors(G, v, &it);
+    while ((w = NextNeighbor(&it, &weight)) != -1)
+    {
+      int distance = W->Distance[v] + weight;
+
+      W->Scanned++;
+
+      if (W->Bans && _banned(W, v, w))
+        continue;
+
+      if (W->Options != NULL && W->Stamp[w] != W->Epoch && IsExcluded(G, W->Options, w))
+        continue;
+
+      if (W->Stamp[w] == W->Epoch)
+      {
+        if (distance >= W->Distance[w])  // (settled vertices end here)
+          continue;
+
+        if (!useHeap)  // move to its new bucket:
+          _bucketRemove(W, numBuckets, w);
+        else
+          queued++;  // (the old entry stays, and is skipped)
+      }
+      else
+      {
+        W->Stamp[w] = W->Epoch;
+        queued++;
+      }
+
+      W->Distance[w] = distance;
+      W->Predecessor[w] = v;
+
+      if (useHeap)
+        _heapPush(W, distance, w);
+      else
+        _bucketInsert(W, numBuckets, w);
+    }
+  }
+
+  if (W->Shared)
+  {
+    W->SharedSettled += W->Settled;
+    W->SharedScanned += W->Scanned;
+  }
+
+  return found;
+}
+
+//
+// ShareBudget:
+//
+// Makes the searches in W from now on share one budget, that of W's
+// options (if any), rather than each having its own: the time limit
+// runs from now, and the step limit counts the vertices all of them
+// settle (see SearchFrom), or that a search of the caller's own
+// reports as it goes (see SpendBudget).
+//
+void ShareBudget(SearchWorkspace *W)
+{
+  W->Shared = 1;  /*true*/
+  W->Started = _now();
+  W->Deadline = 0;
+  W->SharedSettled = 0;
+  W->SharedScanned = 0;
+  W->CheckAt = _nextCheck(W->Options, _maxSteps(W), 0);
+
+  if (W->Options != NULL && W->Options->TimeLimit > 0)
+    W->Deadline = W->Started + W->Options->TimeLimit;
+}
+
+//
+// SpendBudget:
+//
+// For a search with a loop of its own: charges W's shared budget
+// (see ShareBudget) with the given # of vertices settled, and
+// returns true (non-zero) if it has run out, in which case
+// W->TimedOut is true.  Only reads the clock every SEARCH_CHECKEVERY
+// vertices, so may be called for every one.
+//
+int SpendBudget(SearchWorkspace *W, int settled)
+{
+  SearchOptions *O = W->Options;
+
+  W->SharedSettled += settled;
+
+  if (O == NULL || W->TimedOut || W->SharedSettled < W->CheckAt)
+    return W->TimedOut;
+
+  if ((O->MaxSteps > 0 && W->SharedSettled >= O->MaxSteps) ||
+      (O->TimeLimit > 0 && _now() >= W->Deadline))
+    W->TimedOut = 1;  /*true*/
+  else
+    W->CheckAt = _nextCheck(O, O->MaxSteps > 0 ? O->MaxSteps : -1, W->SharedSettled);
+
+  return W->TimedOut;
+}
+
+//
+// BudgetResult:
+//
+// Fills in R for a query that ran its searches in W under a shared
+// budget (see ShareBudget), with the given status: how much work
+// they did, and how long it took.
+//
+void BudgetResult(SearchWorkspace *W, int status, SearchResult *R)
+{
+  R->Status = status;
+  R->Distance = -1;
+  R->Settled = W->SharedSettled;
+  R->Scanned = W->SharedScanned;
+  R->Elapsed = _now() - W->Started;
+  R->Nearest = -1;
+  R->Edits = -1;
+}
+
+//
+// WorkspaceDistance:
+//
+// Returns the distance to v found by the last search in W, or -1
+// if it did not reach v.
+//
+// NOTE: if the search stopped at its dest, the distances of the
+// vertices not yet settled are only upper bounds.
+//
+int WorkspaceDistance(SearchWorkspace *W, Vertex v)
+{
+  if (v < 0 || v >= W->NumVertices || W->Stamp[v] != W->Epoch)
+    return -1;
+
+  return W->Distance[v];
+}
+
+//
+// WorkspacePath:
+//
+// Returns the path to dest found by the last search in W, from src,
+// in the same format as Dijkstra(): src, ..., dest, -1, or just -1
+// if there is no path (or src == dest).
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *WorkspacePath(SearchWorkspace *W, Vertex src, Vertex dest)
+{
+  Vertex *path;
+  Vertex  v;
+  int     n = 0;
+
+  if (src != dest && WorkspaceDistance(W, dest) >= 0)
+  {
+    for (v = dest; v != -1; v = W->Predecessor[v])
+      n++;
+  }
+
+  path = (Vertex *)mymalloc((n + 1) * sizeof(Vertex));
+  if (path == NULL)
+  {
+    printf("\n**Error in WorkspacePath: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  path[n] = -1;
+
+  if (n > 0)
+  {
+    for (v = dest; v != -1; v = W->Predecessor[v])
+      path[--n] = v;
+  }
+
+  return path;
+}
+
+//
+// WeightedShortestPath:
+//
+// Returns a least-cost path from src to dest, as Dijkstra() does,
+// searching in the given workspace.
+//
+// NOTE: returns NULL if src or dest are not valid vertex ids.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *WeightedShortestPath(Graph *G, SearchWorkspace *W, Vertex src, Vertex dest)
+{
+  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+  if (dest < 0 || dest >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  if (SearchFrom(G, W, src, dest) < 0)  // no path:
+    return WorkspacePath(W, src, src);
+
+  return WorkspacePath(W, src, dest);
+}
+
+//
+// ConstrainedShortestPath:
+//
+// Returns a least-cost path from src to dest that only enters the
+// words the options O allow (see SearchOptions), in the format
+// Dijkstra() returns; just -1 if there is none.
+//
+// NOTE: returns NULL if src or dest are not valid vertex ids.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *ConstrainedShortestPath(Graph *G, Vertex src, Vertex dest, SearchOptions *O)
+{
+  SearchWorkspace *W = CreateWorkspace(G);
+
+  W->Options = O;
+
+  Vertex *path = WeightedShortestPath(G, W, src, dest);
+
+  DeleteWorkspace(W);
+
+  return path;
+}
+
+//
+// _nearest:
+//
+// After a search in W toward dest that ran out of budget, returns
+// the word it settled with the fewest edits from dest's (the one
+// reached first, of those tied), and sets *edits to their #.
+//
+static Vertex _nearest(Graph *G, SearchWorkspace *W, Vertex dest, int *edits)
+{
+  char  *target = G->Names[dest];
+  Vertex best = -1;
+  int    bestEdits = INT_MAX - 1;
+  int    i;
+
+  for (i = 0; i < W->Settled && bestEdits > 0; ++i)
+  {
+    Vertex v = W->Order[i];
+    int    d = EditDistance(G->Names[v], target, bestEdits - 1);  // only if closer
+
+    if (d < bestEdits)
+    {
+      best = v;
+      bestEdits = d;
+    }
+  }
+
+  *edits = (best == -1) ? -1 : bestEdits;
+
+  return best;
+}
+
+//
+// BudgetedShortestPath:
+//
+// Returns a least-cost path from src to dest within the options O
+// (see SearchOptions), as ConstrainedShortestPath does, and fills
+// in R: the search's status, and how much work it did.  If the
+// search runs out of budget, the path is just -1, unless O->Partial
+// is true: then R->Nearest is the word it reached with the fewest
+// edits from dest, and the path goes from src to it.
+//
+// NOTE: returns NULL if src or dest are not valid vertex ids.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *BudgetedShortestPath(Graph *G, Vertex src, Vertex dest, SearchOptions *O, SearchResult *R)
+{
+  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+  if (dest < 0 || dest >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  SearchWorkspace *W = CreateWorkspace(G);
+  double           start = _now();
+  Vertex          *path;
+  int              distance;
+
+  W->Options = O;
+
+  distance = SearchFrom(G, W, src, dest);
+
+  R->Elapsed = _now() - start;
+  R->Settled = W->Settled;
+  R->Scanned = W->Scanned;
+  R->Distance = (distance >= 0) ? distance : -1;
+  R->Status = (distance >= 0) ? SEARCH_FOUND : distance;
+  R->Nearest = -1;
+  R->Edits = -1;
+
+  if (distance >= 0)
+    path = WorkspacePath(W, src, dest);
+  else if (distance == SEARCH_TIMEDOUT && O->Partial)
+  {
+    R->Nearest = _nearest(G, W, dest, &R->Edits);
+    path = WorkspacePath(W, src, (R->Nearest == -1) ? src : R->Nearest);
+  }
+  else
+    path = WorkspacePath(W, src, src);  // no path:
+
+  DeleteWorkspace(W);
+
+  return path;
+}
+
+//
+// PathCost:
+//
+// Returns the total weight of the edges along the given path (in
+// the format Dijkstra() returns), 0 if it has no edges.
+//
+int PathCost(Graph *G, Vertex *path)
+{
+  int cost = 0;
+  int i;
+
+  for (i = 0; path[i] != -1 && path[i + 1] != -1; ++i)
+    cost += getEdgeWeight(G, path[i], path[i + 1]);
+
+  return cost;
+}
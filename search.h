@@ -0,0 +1,107 @@
+/*search.h*/
+
+//
+// Weighted shortest paths, with a reusable workspace:
+//
+// NOTE: include "graph.h" before this file.
+//
+#define DIAL_MAXWEIGHT  1024  // heavier edges => a binary heap instead of buckets
+#define SEARCH_MAXPOSITIONS  32  // letter positions a filter can constrain
+#define SEARCH_CHECKEVERY   256  // settled vertices between checks of the clock
+
+#define SEARCH_FOUND      0  // statuses (SearchFrom returns the distance,
+#define SEARCH_NOPATH    -1  //   or one of these two)
+#define SEARCH_TIMEDOUT  -2  // the budget ran out first (see SearchOptions)
+
+typedef int (*VertexPredicate)(Graph *G, Vertex v, void *context);
+
+typedef struct SearchOptions  // see InitSearchOptions:
+{
+  unsigned char  *Excluded;       // bit v set => v is not entered (NULL => none)
+  int             NumExcluded;    //   (bits for this many vertices)
+  unsigned int    BannedLetters;  // bit c-'a' set => no words with c,
+  unsigned int    BannedAt[SEARCH_MAXPOSITIONS];  // nor with c at position i
+  int             NumPositions;   //   for i < NumPositions
+  VertexPredicate Allow;          // if not NULL, false => v is not entered
+  void           *AllowCtx;
+  double          TimeLimit;      // > 0 => a search gives up after this many ms,
+  int             MaxSteps;       //   or after settling this many vertices
+  int             Partial;        // true => one that gives up returns the ladder
+} SearchOptions;                  //   to the word reached closest to dest
+
+typedef struct SearchResult  // see BudgetedShortestPath:
+{
+  int     Status;     // SEARCH_FOUND, SEARCH_NOPATH or SEARCH_TIMEDOUT
+  int     Distance;   // the least cost, if found
+  int     Settled;    // # of vertices the search settled,
+  int     Scanned;    //   and of edges it examined,
+  double  Elapsed;    //   in this many ms
+  Vertex  Nearest;    // if timed out: the word reached closest to dest
+  int     Edits;      //   (this many edits from it), -1 if not sought
+} SearchResult;
+
+typedef struct HeapEntry
+{
+  int     Distance;
+  Vertex  V;
+} HeapEntry;
+
+typedef struct SearchWorkspace  // see CreateWorkspace:
+{
+  int           NumVertices;   // sized for graphs of up to this many
+  unsigned int  Epoch;         // # of the current search
+  unsigned int *Stamp;         // Stamp[v] == Epoch => v reached by it,
+  int          *Distance;      //   at this distance,
+  Vertex       *Predecessor;   //   from this vertex (-1 for the source)
+  Vertex       *Next;          // bucket queue: a doubly-linked list of
+  Vertex       *Prev;          //   the queued vertices at each distance,
+  Vertex       *Buckets;       //   modulo the # of buckets
+  HeapEntry    *Heap;          // binary heap, if the weights are large
+  int           HeapSize;
+  int           HeapCapacity;
+  int           ForceHeap;     // true => the heap even for small weights
+  int           Settled;       // # of vertices the last search settled,
+  Vertex       *Order;         //   in this order
+  int           Bans;          // true => some vertices or edges are banned:
+  unsigned int *Banned;        //   Banned[v] == BanEpoch => v is not entered,
+  unsigned int  BanEpoch;
+  Vertex        BanFrom;       //   and the edges BanFrom -> BanTo[i] are
+  Vertex       *BanTo;         //   not taken (see BanEdge)
+  int           NumBanTo;
+  int           BanCapacity;
+  int           MaxDistance;   // >= 0 => vertices beyond it are not settled
+  SearchOptions *Options;      // if not NULL, filters the vertices entered
+  int           Scanned;       // # of edges the last search examined
+  int           TimedOut;      // true => it ran out of budget (see SearchOptions)
+  int           Shared;        // true => its searches share one budget (see ShareBudget):
+  double        Started;       //   started at this time (in ms),
+  double        Deadline;      //   out of time at this one,
+  int           SharedSettled; //   and having settled this many vertices,
+  int           SharedScanned; //   and examined this many edges
+  int           CheckAt;       //   (SpendBudget next checks at this many settled)
+} SearchWorkspace;
+
+SearchWorkspace *CreateWorkspace(Graph *G);
+void             DeleteWorkspace(SearchWorkspace *W);
+void             NewSearch(SearchWorkspace *W);
+void             ClearBans(SearchWorkspace *W);
+void             BanVertex(SearchWorkspace *W, Vertex v);
+void             BanEdge(SearchWorkspace *W, Vertex from, Vertex to);
+
+void             InitSearchOptions(SearchOptions *O);
+void             ClearSearchOptions(SearchOptions *O);
+void             ExcludeVertex(Graph *G, SearchOptions *O, Vertex v);
+void             ExcludeLetters(SearchOptions *O, int position, char *letters);
+int              IsExcluded(Graph *G, SearchOptions *O, Vertex v);
+
+void             ShareBudget(SearchWorkspace *W);
+int              SpendBudget(SearchWorkspace *W, int settled);
+void             BudgetResult(SearchWorkspace *W, int status, SearchResult *R);
+
+int     SearchFrom(Graph *G, SearchWorkspace *W, Vertex src, Vertex dest);
+int     WorkspaceDistance(SearchWorkspace *W, Vertex v);
+Vertex *WorkspacePath(SearchWorkspace *W, Vertex src, Vertex dest);
+Vertex *WeightedShortestPath(Graph *G, SearchWorkspace *W, Vertex src, Vertex dest);
+Vertex *ConstrainedShortestPath(Graph *G, Vertex src, Vertex dest, SearchOptions *O);
+Vertex *BudgetedShortestPath(Graph *G, Vertex src, Vertex dest, SearchOptions *O, SearchResult *R);
+int     PathCost(Graph *G, Vertex *path);
@@ -0,0 +1,618 @@
+/*spdag.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "search.h"
+#include "spdag.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Shortest-path DAG:
+//
+// Dijkstra keeps one predecessor per vertex, so it finds one
+// shortest ladder of the many there often are.  The vertices on
+// some shortest ladder from src to dest, with the edges between
+// consecutive layers, form a DAG in which every path from src to
+// dest is a shortest ladder and vice versa.  It is found with a
+// bidirectional BFS: one from src, one from dest, each expanding a
+// whole layer at a time, the smaller frontier first, until a layer
+// reaches a vertex the other BFS has reached.  With layers 0..a
+// from src and 0..b from dest complete and disjoint, and layer
+// a+1 meeting layer b, the ladders have a+1+b steps, and the
+// meeting layer {ds = a+1, dt = b} is where every one of them
+// crosses.  From there the DAG grows towards src over the vertices
+// one step closer to src, and towards dest over those one step
+// closer to dest, so it never holds a vertex that is on no
+// shortest ladder.
+//
+// Path counts are a DP over the DAG, from dest back to src, in time
+// linear in its size however many ladders there are; they saturate
+// at SPDAG_SATURATED rather than overflow.  The ladders themselves
+// stream out of NextShortestPath, one at a time, depth-first.
+// Ladders count steps; edge weights are ignored.
+//
+// NOTE: the BFS from dest follows the edges out of each vertex as
+// if they were the edges in, so the edges must be symmetric --- as
+// ladder edges are.
+//
+
+typedef struct Side  // one direction of the bidirectional BFS:
+{
+  SearchWorkspace *W;           // Stamp: reached, Distance: layer #,
+  Vertex          *Visited;     //   Predecessor: index in the DAG
+  int              NumVisited;
+  int              Capacity;
+  int             *LayerStart;  // layer d: Visited[LayerStart[d]..LayerStart[d+1]-1]
+  int              LayerCapacity;
+  int              Depth;       // layers 0..Depth are complete
+} Side;
+
+static void _append(Vertex **list, int *count, int *capacity, Vertex v)
+{
+  if (*count == *capacity)  // full, double in size:
+  {
+    Vertex *newList = (Vertex *)mymalloc(2 * (*capacity) * sizeof(Vertex));
+    if (newList == NULL)
+    {
+      printf("\n**Error in BuildShortestPathDAG: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    memcpy(newList, *list, (*count) * sizeof(Vertex));
+    myfree(*list);
+
+    *list = newList;
+    *capacity *= 2;
+  }
+
+  (*list)[(*count)++] = v;
+}
+
+static void _initSide(Side *S, Graph *G, Vertex root, SearchOptions *O)
+{
+  S->W = CreateWorkspace(G);
+  S->W->Options = O;
+  S->Capacity = 64;
+  S->Visited = (Vertex *)mymalloc(S->Capacity * sizeof(Vertex));
+  S->LayerCapacity = 64;
+  S->LayerStart = (int *)mymalloc(S->LayerCapacity * sizeof(int));
+  if (S->Visited == NULL || S->LayerStart == NULL)
+  {
+    printf("\n**Error in BuildShortestPathDAG: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  NewSearch(S->W);
+
+  S->W->Stamp[root] = S->W->Epoch;
+  S->W->Distance[root] = 0;
+  S->W->Predecessor[root] = -1;
+
+  S->NumVisited = 0;
+  _append(&S->Visited, &S->NumVisited, &S->Capacity, root);
+
+  S->Depth = 0;
+  S->LayerStart[0] = 0;
+  S->LayerStart[1] = 1;
+}
+
+static void _freeSide(Side *S)
+{
+  DeleteWorkspace(S->W);
+  myfree(S->Visited);
+  myfree(S->LayerStart);
+}
+
+static int _reached(Side *S, Vertex v)
+{
+  return S->W->Stamp[v] == S->W->Epoch;
+}
+
+static int _layerSize(Side *S)
+{
+  return S->LayerStart[S->Depth + 1] - S->LayerStart[S->Depth];
+}
+
+//
+// _expand:
+//
+// Adds the next layer to side S, returning true (non-zero) if it
+// reaches a vertex the other side has.  The words S's options
+// exclude are never entered, and each vertex expanded is charged to
+// the budget shared in B (see SpendBudget); if that runs out, stops
+// there, with the layer incomplete.
+//
+static int _expand(Graph *G, Side *S, Side *other, SearchWorkspace *B)
+{
+  int met = 0;  /*false*/
+  int end = S->LayerStart[S->Depth + 1];
+  int i;
+
+  for (i = S->LayerStart[S->Depth]; i < end; ++i)
+  {
+    NeighborIter it;
+    Vertex       w;
+
+    if (SpendBudget(B, 1))  // out of budget:
+      return met;
+
+    BeginNeighbors(G, S->Visited[i], &it);
+    while ((w = NextNeighbor(&it, NULL)) != -1)
+    {
+      if (_reached(S, w))
+        continue;
+      if (S->W->Options != NULL && IsExcluded(G, S->W->Options, w))
+        continue;
+
+      S->W->Stamp[w] = S->W->Epoch;
+      S->W->Distance[w] = S->Depth + 1;
+      S->W->Predecessor[w] = -1;  // (not in the DAG)
+      _append(&S->Visited, &S->NumVisited, &S->Capacity, w);
+
+      if (_reached(other, w))
+        met = 1;  /*true*/
+    }
+  }
+
+  if (S->Depth + 2 >= S->LayerCapacity)  // full, double in size:
+  {
+    int *layerStart = (int *)mymalloc(2 * S->LayerCapacity * sizeof(int));
+    if (layerStart == NULL)
+    {
+      printf("\n**Error in BuildShortestPathDAG: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    memcpy(layerStart, S->LayerStart, S->LayerCapacity * sizeof(int));
+    myfree(S->LayerStart);
+
+    S->LayerStart = layerStart;
+    S->LayerCapacity *= 2;
+  }
+
+  S->Depth++;
+  S->LayerStart[S->Depth + 1] = S->NumVisited;
+
+  return met;
+}
+
+//
+// _dagIndex:
+//
+// Returns the DAG index of w if it is in layer i of the DAG, or -1.
+// Layers 0..m are marked on the src side, the rest on the dest
+// side.
+//
+static int _dagIndex(Side *S, Side *T, int m, int length, int i, Vertex w)
+{
+  Side *X = (i <= m) ? S : T;
+  int   d = (i <= m) ? i : length - i;
+
+  if (!_reached(X, w) || X->W->Distance[w] != d)
+    return -1;
+
+  return X->W->Predecessor[w];
+}
+
+//
+// _addLayer:
+//
+// Adds to the DAG (order[], in the order found) the vertices of
+// layer i adjacent to those of layer j (i +/- 1), which lie between
+// order[from] and order[to-1].
+//
+static void _addLayer(Graph *G, Side *S, Side *T, int m, int length, int i,
+                      int from, int to, Vertex **order, int *count, int *capacity)
+{
+  Side *X = (i <= m) ? S : T;
+  int   d = (i <= m) ? i : length - i;
+  int   k;
+
+  for (k = from; k < to; ++k)
+  {
+    NeighborIter it;
+    Vertex       w;
+
+    BeginNeighbors(G, (*order)[k], &it);
+    while ((w = NextNeighbor(&it, NULL)) != -1)
+    {
+      if (_reached(X, w) && X->W->Distance[w] == d && X->W->Predecessor[w] < 0)
+      {
+        X->W->Predecessor[w] = 0;  // in the DAG, index set below
+        _append(order, count, capacity, w);
+      }
+    }
+  }
+}
+
+//
+// BuildShortestPathDAG:
+//
+// Returns the DAG of the shortest ladders from src to dest (see
+// above), with the # of ladders through each vertex counted.  If O
+// is not NULL, the ladders only enter the words it allows (see
+// SearchOptions), and the BFSs stop if they run out of its budget
+// (see ShareBudget), in which case TimedOut is true.  If there is
+// no ladder (or the budget ran out), its Length is -1 and it is
+// empty; if src == dest, there is one ladder, of length 0.
+//
+// NOTE: returns NULL if src or dest are not valid vertex ids.
+//
+// NOTE: it is the responsibility of the CALLER to free the DAG
+// (DeleteShortestPathDAG) when they are done.
+//
+ShortestPathDAG *BuildShortestPathDAG(Graph *G, Vertex src, Vertex dest, SearchOptions *O)
+{
+  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+  if (dest < 0 || dest >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  ShortestPathDAG *D = (ShortestPathDAG *)mymalloc(sizeof(ShortestPathDAG));
+  if (D == NULL)
+  {
+    printf("\n**Error in BuildShortestPathDAG: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  Side  S, T;
+  int   length = -1;
+  int   m = 0;
+  int   open = (O == NULL || (!IsExcluded(G, O, src) && !IsExcluded(G, O, dest)));
+  int   i, k;
+
+  D->Src = src;
+  D->Dest = dest;
+
+  _initSide(&S, G, src, O);
+  _initSide(&T, G, dest, O);
+
+  ShareBudget(S.W);  // (for both sides)
+
+  //
+  // (1) bidirectional BFS, until the sides meet:
+  //
+  if (src == dest && open)
+    length = 0;
+
+  while (open && length < 0 && _layerSize(&S) > 0 && _layerSize(&T) > 0)
+  {
+    int met;
+
+    if (_layerSize(&S) <= _layerSize(&T))
+      met = _expand(G, &S, &T, S.W);
+    else
+      met = _expand(G, &T, &S, S.W);
+
+    if (S.W->TimedOut)  // out of budget:
+      break;
+
+    if (met)
+    {
+      m = S.Depth;  // the meeting layer: ds = m, dt = length - m
+      length = S.Depth + T.Depth;
+    }
+  }
+
+  D->Length = length;
+  D->TimedOut = S.W->TimedOut;
+
+  //
+  // (2) the DAG's vertices, found in the order: meeting layer, the
+  // layers towards src, the layers towards dest:
+  //
+  int     count = 0, capacity = 64;
+  Vertex *order = (Vertex *)mymalloc(capacity * sizeof(Vertex));
+  int    *begin = (int *)mymalloc((length + 2) * sizeof(int));
+  int    *end = (int *)mymalloc((length + 2) * sizeof(int));
+  if (order == NULL || begin == NULL || end == NULL)
+  {
+    printf("\n**Error in BuildShortestPathDAG: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  if (length >= 0)
+  {
+    begin[m] = 0;
+
+    for (k = S.LayerStart[m]; k < S.LayerStart[m + 1]; ++k)
+    {
+      Vertex v = S.Visited[k];
+
+      if (_reached(&T, v) && T.W->Distance[v] == length - m)
+      {
+        S.W->Predecessor[v] = 0;
+        _append(&order, &count, &capacity, v);
+      }
+    }
+
+    end[m] = count;
+
+    for (i = m - 1; i >= 0; --i)
+    {
+      begin[i] = count;
+      _addLayer(G, &S, &T, m, length, i, begin[i + 1], end[i + 1], &order, &count, &capacity);
+      end[i] = count;
+    }
+
+    for (i = m + 1; i <= length; ++i)
+    {
+      begin[i] = count;
+      _addLayer(G, &S, &T, m, length, i, begin[i - 1], end[i - 1], &order, &count, &capacity);
+      end[i] = count;
+    }
+  }
+
+  //
+  // lay the layers out in order, and index them:
+  //
+  D->NumVertices = count;
+  D->Vertices = (Vertex *)mymalloc((count + 1) * sizeof(Vertex));
+  D->LayerStart = (int *)mymalloc((length + 3) * sizeof(int));
+  D->EdgeStart = (int *)mymalloc((count + 1) * sizeof(int));
+  D->Count = (unsigned long long *)mymalloc((count + 1) * sizeof(unsigned long long));
+  if (D->Vertices == NULL || D->LayerStart == NULL || D->EdgeStart == NULL || D->Count == NULL)
+  {
+    printf("\n**Error in BuildShortestPathDAG: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  D->LayerStart[0] = 0;
+
+  for (i = 0; i <= length; ++i)
+  {
+    Side *X = (i <= m) ? &S : &T;
+    int   n = end[i] - begin[i];
+
+    memcpy(&D->Vertices[D->LayerStart[i]], &order[begin[i]], n * sizeof(Vertex));
+
+    for (k = D->LayerStart[i]; k < D->LayerStart[i] + n; ++k)
+      X->W->Predecessor[D->Vertices[k]] = k;
+
+    D->LayerStart[i + 1] = D->LayerStart[i] + n;
+  }
+
+  //
+  // (3) the edges between consecutive layers, counted then stored
+  // (multi-edges are consecutive, and kept once):
+  //
+  int pass;
+
+  D->Succ = NULL;
+
+  for (pass = 0; pass < 2; ++pass)
+  {
+    int numEdges = 0;
+
+    for (i = 0; i < length; ++i)
+    {
+      for (k = D->LayerStart[i]; k < D->LayerStart[i + 1]; ++k)
+      {
+        NeighborIter it;
+        Vertex       w, last = -1;
+
+        D->EdgeStart[k] = numEdges;
+
+        BeginNeighbors(G, D->Vertices[k], &it);
+        while ((w = NextNeighbor(&it, NULL)) != -1)
+        {
+          int j = _dagIndex(&S, &T, m, length, i + 1, w);
+
+          if (j < 0 || w == last)
+            continue;
+
+          if (pass == 1)
+            D->Succ[numEdges] = j;
+          numEdges++;
+          last = w;
+        }
+      }
+    }
+
+    for (k = (length >= 0) ? D->LayerStart[length] : 0; k <= count; ++k)
+      D->EdgeStart[k] = numEdges;  // (dest, and the end)
+
+    D->NumEdges = numEdges;
+
+    if (pass == 0)
+    {
+      D->Succ = (int *)mymalloc((numEdges + 1) * sizeof(int));
+      if (D->Succ == NULL)
+      {
+        printf("\n**Error in BuildShortestPathDAG: malloc failed to allocate\n\n");
+        exit(-1);
+      }
+    }
+  }
+
+  //
+  // (4) count the paths to dest, layer by layer from dest back:
+  //
+  for (k = count - 1; k >= 0; --k)
+  {
+    unsigned long long paths = (k >= D->LayerStart[length]) ? 1 : 0;
+    int                e;
+
+    for (e = D->EdgeStart[k]; e < D->EdgeStart[k + 1]; ++e)
+    {
+      unsigned long long sum = paths + D->Count[D->Succ[e]];
+
+      paths = (sum < paths) ? SPDAG_SATURATED : sum;  // (overflowed)
+    }
+
+    D->Count[k] = paths;
+  }
+
+  D->NumPaths = (count > 0) ? D->Count[0] : 0;
+
+  myfree(order);
+  myfree(begin);
+  myfree(end);
+  _freeSide(&S);
+  _freeSide(&T);
+
+  return D;
+}
+
+//
+// DeleteShortestPathDAG:
+//
+void DeleteShortestPathDAG(ShortestPathDAG *D)
+{
+  myfree(D->Vertices);
+  myfree(D->LayerStart);
+  myfree(D->EdgeStart);
+  myfree(D->Succ);
+  myfree(D->Count);
+  myfree(D);
+}
+
+//
+// CountShortestPaths:
+//
+// Returns the # of shortest ladders from src to dest (at most
+// SPDAG_SATURATED), 0 if there are none, and stores their length
+// via length (if not NULL; -1 if none).  If O is not NULL, only the
+// ladders through the words it allows are counted, and if its
+// budget runs out, 0 is returned and the length is SEARCH_TIMEDOUT.
+//
+unsigned long long CountShortestPaths(Graph *G, Vertex src, Vertex dest, SearchOptions *O,
+                                      int *length)
+{
+  ShortestPathDAG *D = BuildShortestPathDAG(G, src, dest, O);
+
+  if (D == NULL)
+  {
+    if (length != NULL)
+      *length = -1;
+    return 0;
+  }
+
+  unsigned long long paths = D->NumPaths;
+
+  if (length != NULL)
+    *length = D->TimedOut ? SEARCH_TIMEDOUT : D->Length;
+
+  DeleteShortestPathDAG(D);
+
+  return paths;
+}
+
+//
+// BeginShortestPaths:
+//
+// Starts iterating over the ladders of D; each call to
+// NextShortestPath then returns the next one, or NULL once there
+// are no more.  Example:
+//
+//   DAGPathIter it;
+//   Vertex     *path;
+//
+//   BeginShortestPaths(D, &it);
+//   while ((path = NextShortestPath(&it)) != NULL)
+//     ...
+//   EndShortestPaths(&it);
+//
+void BeginShortestPaths(ShortestPathDAG *D, DAGPathIter *it)
+{
+  int n = (D->Length >= 0) ? D->Length + 1 : 1;
+
+  it->D = D;
+  it->Started = 0;  /*false*/
+  it->Choice = (int *)mymalloc(n * sizeof(int));
+  it->Index = (int *)mymalloc(n * sizeof(int));
+  it->Path = (Vertex *)mymalloc((n + 1) * sizeof(Vertex));
+  if (it->Choice == NULL || it->Index == NULL || it->Path == NULL)
+  {
+    printf("\n**Error in BeginShortestPaths: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+}
+
+//
+// _followFirst:
+//
+// Extends the path from its vertex i to dest by first successors.
+//
+static void _followFirst(DAGPathIter *it, int i)
+{
+  ShortestPathDAG *D = it->D;
+
+  for (; i < D->Length; ++i)
+  {
+    it->Choice[i] = 0;
+    it->Index[i + 1] = D->Succ[D->EdgeStart[it->Index[i]]];
+    it->Path[i + 1] = D->Vertices[it->Index[i + 1]];
+  }
+}
+
+//
+// NextShortestPath:
+//
+// Returns the next ladder, in the format Dijkstra() returns (src,
+// ..., dest, -1), or NULL if there are no more.  Every vertex of
+// the DAG leads to dest, so each call takes time proportional to
+// the ladder's length.
+//
+// NOTE: the path is overwritten by the next call; copy it to keep
+// it.
+//
+Vertex *NextShortestPath(DAGPathIter *it)
+{
+  ShortestPathDAG *D = it->D;
+  int              i;
+
+  if (D->Length < 0)
+    return NULL;
+
+  if (!it->Started)  // the first path:
+  {
+    it->Started = 1;  /*true*/
+    it->Index[0] = 0;
+    it->Path[0] = D->Src;
+    it->Path[D->Length + 1] = -1;
+
+    _followFirst(it, 0);
+    return it->Path;
+  }
+
+  //
+  // change the deepest choice that has another successor:
+  //
+  for (i = D->Length - 1; i >= 0; --i)
+  {
+    int k = it->Index[i];
+
+    if (D->EdgeStart[k] + it->Choice[i] + 1 < D->EdgeStart[k + 1])
+      break;
+  }
+
+  if (i < 0)  // no more:
+    return NULL;
+
+  it->Choice[i]++;
+  it->Index[i + 1] = D->Succ[D->EdgeStart[it->Index[i]] + it->Choice[i]];
+  it->Path[i + 1] = D->Vertices[it->Index[i + 1]];
+
+  _followFirst(it, i + 1);
+  return it->Path;
+}
+
+//
+// EndShortestPaths:
+//
+void EndShortestPaths(DAGPathIter *it)
+{
+  myfree(it->Choice);
+  myfree(it->Index);
+  myfree(it->Path);
+}
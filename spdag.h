@@ -0,0 +1,42 @@
+/*spdag.h*/
+
+//
+// All shortest ladders between two words, as a DAG:
+//
+// NOTE: include "graph.h" and "search.h" before this file.
+//
+#define SPDAG_SATURATED  0xFFFFFFFFFFFFFFFFULL  // path counts stop here
+
+typedef struct ShortestPathDAG
+{
+  Vertex              Src;
+  Vertex              Dest;
+  int                 Length;       // # of steps of each path, -1 => none
+  int                 NumVertices;
+  Vertex             *Vertices;     // layer i: Vertices[LayerStart[i]..LayerStart[i+1]-1]
+  int                *LayerStart;   //   (Length+2 entries)
+  int                *EdgeStart;    // Vertices[k]'s successors in the next layer:
+  int                *Succ;         //   Succ[EdgeStart[k]..EdgeStart[k+1]-1]
+  int                 NumEdges;
+  unsigned long long *Count;        // # of paths from Vertices[k] to Dest
+  unsigned long long  NumPaths;     // from Src (SPDAG_SATURATED => at least)
+  int                 TimedOut;     // true => ran out of budget (see BuildShortestPathDAG)
+} ShortestPathDAG;
+
+typedef struct DAGPathIter  // see BeginShortestPaths:
+{
+  ShortestPathDAG *D;
+  int             *Choice;    // Choice[i]: which successor path vertex i took
+  int             *Index;     // DAG index of path vertex i
+  Vertex          *Path;      // the current path, ending with -1
+  int              Started;
+} DAGPathIter;
+
+ShortestPathDAG    *BuildShortestPathDAG(Graph *G, Vertex src, Vertex dest, SearchOptions *O);
+void                DeleteShortestPathDAG(ShortestPathDAG *D);
+unsigned long long  CountShortestPaths(Graph *G, Vertex src, Vertex dest, SearchOptions *O,
+                                        int *length);
+
+void    BeginShortestPaths(ShortestPathDAG *D, DAGPathIter *it);
+Vertex *NextShortestPath(DAGPathIter *it);
+void    EndShortestPaths(DAGPathIter *it);
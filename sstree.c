@@ -0,0 +1,272 @@
+/*sstree.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "search.h"
+#include "sstree.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Single-source trees:
+//
+// Dijkstra() answers one (src, dest) query and throws away what it
+// found on the way.  A SingleSourceTree keeps the whole shortest-path
+// tree from src, so that any number of queries from src are then
+// answered without searching again: a distance is one lookup, and a
+// path is the walk up the tree from dest, O(length of the ladder).
+//
+// The tree holds only the vertices reached, in the order the search
+// settled them (W->Order), each with its distance and the index of
+// its parent, plus a hash table (open addressing, at most half full)
+// from vertex # to index.  So a tree costs about 20 bytes per word
+// of src's component rather than per word of the graph, it is built
+// without touching the rest, and parents come before children ---
+// which is what LadderHistogram needs.  Trees own their arrays, so
+// they outlive the workspace they were searched in, and any number
+// can be kept (see WaypointLadder).
+//
+// NOTE: a tree describes the graph's edges and vertex #s when it was
+// built; relabeling or adding edges leaves it stale.
+//
+
+//
+// _hashVertex:
+//
+static unsigned int _hashVertex(Vertex v, int bits)
+{
+  return ((unsigned int)v * 2654435761u) >> (32 - bits);
+}
+
+//
+// _find:
+//
+// Returns the index of v in T, or -1 if T did not reach v.
+//
+static int _find(SingleSourceTree *T, Vertex v)
+{
+  unsigned int mask = (1u << T->TableBits) - 1;
+  unsigned int h = _hashVertex(v, T->TableBits);
+
+  while (T->Table[h] != -1)
+  {
+    if (T->Vertices[T->Table[h]] == v)
+      return T->Table[h];
+
+    h = (h + 1) & mask;
+  }
+
+  return -1;
+}
+
+//
+// BuildSingleSourceTree:
+//
+// Returns the shortest-path tree from src, searched in workspace W
+// (or if W is NULL, in a workspace of its own), with W's options, if
+// any (see SearchFrom).
+//
+// NOTE: returns NULL if src is not a valid vertex id, or if W's
+// options gave the search a budget and it ran out (so a partial
+// tree never passes for a whole one).
+//
+// NOTE: it is the responsibility of the CALLER to free the tree
+// (DeleteSingleSourceTree) when they are done.
+//
+SingleSourceTree *BuildSingleSourceTree(Graph *G, SearchWorkspace *W, Vertex src)
+{
+  int own = (W == NULL);
+  int n, k;
+
+  if (src < 0 || src >= G->NumVertices)  // invalid vertex #:
+    return NULL;
+
+  if (own)
+    W = CreateWorkspace(G);
+
+  if (SearchFrom(G, W, src, -1) == SEARCH_TIMEDOUT)
+  {
+    if (own)
+      DeleteWorkspace(W);
+    return NULL;
+  }
+
+  n = W->Settled;
+
+  SingleSourceTree *T = (SingleSourceTree *)mymalloc(sizeof(SingleSourceTree));
+  if (T == NULL)
+  {
+    printf("\n**Error in BuildSingleSourceTree: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  T->Src = src;
+  T->NumReached = n;
+  T->TableBits = 1;
+  while ((1 << T->TableBits) < 2 * n)
+    T->TableBits++;
+
+  T->Vertices = (Vertex *)mymalloc((n + 1) * sizeof(Vertex));
+  T->Distance = (int *)mymalloc((n + 1) * sizeof(int));
+  T->Parent = (int *)mymalloc((n + 1) * sizeof(int));
+  T->Table = (int *)mymalloc((1 << T->TableBits) * sizeof(int));
+  if (T->Vertices == NULL || T->Distance == NULL || T->Parent == NULL || T->Table == NULL)
+  {
+    printf("\n**Error in BuildSingleSourceTree: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  memset(T->Table, -1, (1 << T->TableBits) * sizeof(int));
+
+  //
+  // copy the tree out of the workspace, where it's only valid until
+  // the next search; every parent was settled before its children,
+  // so it is already in the table:
+  //
+  T->MaxDistance = 0;
+
+  for (k = 0; k < n; ++k)
+  {
+    Vertex       v = W->Order[k];
+    unsigned int mask = (1u << T->TableBits) - 1;
+    unsigned int h = _hashVertex(v, T->TableBits);
+
+    T->Vertices[k] = v;
+    T->Distance[k] = W->Distance[v];
+    T->Parent[k] = (W->Predecessor[v] == -1) ? -1 : _find(T, W->Predecessor[v]);
+
+    while (T->Table[h] != -1)
+      h = (h + 1) & mask;
+    T->Table[h] = k;
+
+    if (T->Distance[k] > T->MaxDistance)
+      T->MaxDistance = T->Distance[k];
+  }
+
+  if (own)
+    DeleteWorkspace(W);
+
+  T->Bytes = sizeof(SingleSourceTree) + 3LL * (n + 1) * sizeof(int) +
+             (1LL << T->TableBits) * sizeof(int);
+
+  return T;
+}
+
+//
+// DeleteSingleSourceTree:
+//
+void DeleteSingleSourceTree(SingleSourceTree *T)
+{
+  myfree(T->Vertices);
+  myfree(T->Distance);
+  myfree(T->Parent);
+  myfree(T->Table);
+  myfree(T);
+}
+
+//
+// TreeDistance:
+//
+// Returns the least cost from the tree's source to v, or -1 if v
+// is unreachable.
+//
+int TreeDistance(SingleSourceTree *T, Vertex v)
+{
+  int k = _find(T, v);
+
+  return (k < 0) ? -1 : T->Distance[k];
+}
+
+//
+// TreePath:
+//
+// Returns a least-cost path from the tree's source to dest, in the
+// format Dijkstra() returns (src, ..., dest, -1), or just -1 if
+// dest is unreachable (or is the source).
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *TreePath(SingleSourceTree *T, Vertex dest)
+{
+  int length = 0;
+  int k = (dest == T->Src) ? -1 : _find(T, dest);
+  int i;
+
+  for (i = k; i != -1; i = T->Parent[i])
+    length++;
+
+  Vertex *path = (Vertex *)mymalloc((length + 1) * sizeof(Vertex));
+  if (path == NULL)
+  {
+    printf("\n**Error in TreePath: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  path[length] = -1;
+
+  for (i = k; i != -1; i = T->Parent[i])
+    path[--length] = T->Vertices[i];
+
+  return path;
+}
+
+//
+// LadderHistogram:
+//
+// Returns a dynamically-allocated array whose i-th entry is the #
+// of words whose ladder from the tree's source (as TreePath returns
+// it) takes i steps, ending with the last non-zero count, then -1.
+// Entry 0 is 1, for the source.  (With a cost model, the least-cost
+// ladders need not be the shortest, so the steps are counted along
+// the tree, parents first.)
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+int *LadderHistogram(SingleSourceTree *T)
+{
+  int *steps = (int *)mymalloc((T->NumReached + 1) * sizeof(int));
+  int  maxSteps = 0;
+  int  i, k;
+
+  if (steps == NULL)
+  {
+    printf("\n**Error in LadderHistogram: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (k = 0; k < T->NumReached; ++k)
+  {
+    steps[k] = (T->Parent[k] == -1) ? 0 : steps[T->Parent[k]] + 1;
+
+    if (steps[k] > maxSteps)
+      maxSteps = steps[k];
+  }
+
+  int *counts = (int *)mymalloc((maxSteps + 2) * sizeof(int));
+  if (counts == NULL)
+  {
+    printf("\n**Error in LadderHistogram: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (i = 0; i <= maxSteps; ++i)
+    counts[i] = 0;
+  counts[maxSteps + 1] = -1;
+
+  for (k = 0; k < T->NumReached; ++k)
+    counts[steps[k]]++;
+
+  myfree(steps);
+
+  return counts;
+}
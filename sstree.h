@@ -0,0 +1,26 @@
+/*sstree.h*/
+
+//
+// Single-source shortest-path trees:
+//
+// NOTE: include "graph.h" and "search.h" before this file.
+//
+typedef struct SingleSourceTree
+{
+  Vertex    Src;
+  int       NumReached;    // (Src included)
+  Vertex   *Vertices;      // the vertices reached, by distance (Src first),
+  int      *Distance;      //   their least cost from Src,
+  int      *Parent;        //   and the index of their parent (-1 for Src)
+  int      *Table;         // hash table: Vertices[Table[h]] hashes to h,
+  int       TableBits;     //   -1 => empty slot (2^TableBits slots)
+  int       MaxDistance;   // of the vertices reached
+  long long Bytes;
+} SingleSourceTree;
+
+SingleSourceTree *BuildSingleSourceTree(Graph *G, SearchWorkspace *W, Vertex src);
+void              DeleteSingleSourceTree(SingleSourceTree *T);
+
+int     TreeDistance(SingleSourceTree *T, Vertex v);
+Vertex *TreePath(SingleSourceTree *T, Vertex dest);
+int    *LadderHistogram(SingleSourceTree *T);
@@ -0,0 +1,535 @@
+/*suggest.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "suggest.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Suggestions:
+//
+// Given a word that is not in the dictionary, Suggest returns the
+// words closest to it by edit (Levenshtein) distance.  If two words
+// are within d edits of each other, deleting at most d letters from
+// each yields the same string --- a substitution is a deletion from
+// both, an insertion a deletion from the other.  So the index
+// (BuildSuggester) holds, for every word, the hashes of all the
+// strings obtained by deleting up to MaxEdits of its letters, and a
+// query looks up the hashes of its own deletions: the words found
+// are the only candidates, and only they are checked with
+// EditDistance.  Hash collisions only add candidates, which the
+// check then drops.
+//
+
+//
+// _hashDeletion:
+//
+// Returns a 32-bit hash of name[0..len-1] with the chars at
+// positions i and j deleted (-1 => none): FNV-1a, then mixed.
+//
+static unsigned int _hashDeletion(char *name, int len, int i, int j)
+{
+  unsigned long long h = 14695981039346656037ULL;
+  int                p;
+
+  for (p = 0; p < len; ++p)
+  {
+    if (p == i || p == j)
+      continue;
+
+    h ^= (unsigned char)name[p];
+    h *= 1099511628211ULL;
+  }
+
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDULL;
+  h ^= h >> 33;
+
+  return (unsigned int)(h >> 32);
+}
+
+//
+// _deletions:
+//
+// Stores in hashes[] the hashes of name and of the strings obtained
+// by deleting up to maxEdits (at most 2) of its len chars, returning
+// how many.  Deleting any char of a run gives the same string, so
+// only the first of a run is deleted.  If hashes is NULL, only
+// counts them.
+//
+static int _deletions(char *name, int len, int maxEdits, unsigned int *hashes)
+{
+  int n = 0;
+  int i, j;
+
+  if (hashes != NULL)
+    hashes[n] = _hashDeletion(name, len, -1, -1);
+  n++;
+
+  if (maxEdits < 1)
+    return n;
+
+  for (i = 0; i < len; ++i)
+  {
+    if (i > 0 && name[i] == name[i - 1])
+      continue;
+
+    if (hashes != NULL)
+      hashes[n] = _hashDeletion(name, len, i, -1);
+    n++;
+
+    if (maxEdits < 2)
+      continue;
+
+    for (j = i + 1; j < len; ++j)
+    {
+      if (j > i + 1 && name[j] == name[j - 1])
+        continue;
+
+      if (hashes != NULL)
+        hashes[n] = _hashDeletion(name, len, i, j);
+      n++;
+    }
+  }
+
+  return n;
+}
+
+//
+// _maxDeletions:
+//
+// Returns the most deletions _deletions can return for a name of
+// length len.
+//
+static int _maxDeletions(int len, int maxEdits)
+{
+  int n = 1;
+
+  if (maxEdits >= 1)
+    n += len;
+  if (maxEdits >= 2)
+    n += len * (len - 1) / 2;
+
+  return n;
+}
+
+//
+// BuildSuggester:
+//
+// Builds G->Suggest, the deletion index of all the names in G for
+// queries with up to maxEdits edits (1..SUGGEST_MAXEDITS).  The
+// entries are bucketed by the high bits of their hash, counted in
+// a first pass and stored in a second, so a lookup reads one
+// bucket.
+//
+// NOTE: build once all vertices have been added.
+//
+void BuildSuggester(Graph *G, int maxEdits)
+{
+  clock_t       start = clock();
+  unsigned int *hashes;
+  long long     total = 0;
+  int           maxLen = 0;
+  int           numBuckets;
+  int           b, i;
+  Vertex        v;
+
+  if (G->Suggest != NULL)
+  {
+    DeleteSuggester(G->Suggest);
+    G->Suggest = NULL;
+  }
+
+  if (maxEdits < 1)
+    maxEdits = 1;
+  if (maxEdits > SUGGEST_MAXEDITS)
+    maxEdits = SUGGEST_MAXEDITS;
+
+  Suggester *S = (Suggester *)mymalloc(sizeof(Suggester));
+  if (S == NULL)
+  {
+    printf("\n**Error in BuildSuggester: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  S->MaxEdits = maxEdits;
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    int len = (int)strlen(G->Names[v]);
+
+    if (len > maxLen)
+      maxLen = len;
+
+    total += _deletions(G->Names[v], len, maxEdits, NULL);
+  }
+
+  S->NumEntries = (int)total;
+  S->TableBits = 1;
+  while ((1LL << S->TableBits) < total / 2)  // ~2 entries per bucket
+    S->TableBits++;
+
+  numBuckets = 1 << S->TableBits;
+
+  hashes = (unsigned int *)mymalloc(_maxDeletions(maxLen, maxEdits) * sizeof(unsigned int));
+  S->Start = (int *)mymalloc((numBuckets + 1) * sizeof(int));
+  S->Entries = (SuggestEntry *)mymalloc((S->NumEntries + 1) * sizeof(SuggestEntry));
+  if (hashes == NULL || S->Start == NULL || S->Entries == NULL)
+  {
+    printf("\n**Error in BuildSuggester: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  memset(S->Start, 0, (numBuckets + 1) * sizeof(int));
+
+  //
+  // count each bucket's entries, turn the counts into starts, then
+  // store the entries --- which leaves Start[b] at the end of bucket
+  // b, so shift the starts back:
+  //
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    int len = (int)strlen(G->Names[v]);
+    int n = _deletions(G->Names[v], len, maxEdits, hashes);
+
+    for (i = 0; i < n; ++i)
+      S->Start[hashes[i] >> (32 - S->TableBits)]++;
+  }
+
+  for (b = 0, total = 0; b < numBuckets; ++b)
+  {
+    int count = S->Start[b];
+
+    S->Start[b] = (int)total;
+    total += count;
+  }
+
+  for (v = 0; v < G->NumVertices; ++v)
+  {
+    int len = (int)strlen(G->Names[v]);
+    int n = _deletions(G->Names[v], len, maxEdits, hashes);
+
+    for (i = 0; i < n; ++i)
+    {
+      SuggestEntry *e = &S->Entries[S->Start[hashes[i] >> (32 - S->TableBits)]++];
+
+      e->Hash = hashes[i];
+      e->V = v;
+    }
+  }
+
+  for (b = numBuckets; b > 0; --b)
+    S->Start[b] = S->Start[b - 1];
+  S->Start[0] = 0;
+
+  myfree(hashes);
+
+  S->Bytes = (long long)(numBuckets + 1) * sizeof(int) +
+             (long long)S->NumEntries * sizeof(SuggestEntry);
+  S->BuildTime = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+  G->Suggest = S;
+}
+
+//
+// DeleteSuggester:
+//
+void DeleteSuggester(Suggester *S)
+{
+  myfree(S->Start);
+  myfree(S->Entries);
+  myfree(S);
+}
+
+//
+// EditDistance:
+//
+// Returns the Levenshtein distance between a and b (the fewest
+// one-char insertions, deletions and substitutions turning one into
+// the other), or max+1 if it exceeds max.  Stops as soon as a row
+// of the table exceeds max.
+//
+int EditDistance(char *a, char *b, int max)
+{
+  int  la = (int)strlen(a);
+  int  lb = (int)strlen(b);
+  int  buffer[2][64];
+  int *prev = buffer[0];
+  int *cur = buffer[1];
+  int *memory = NULL;
+  int  i, j;
+
+  if (la - lb > max || lb - la > max)
+    return max + 1;
+
+  if (lb + 1 > 64)
+  {
+    memory = (int *)mymalloc(2 * (lb + 1) * sizeof(int));
+    if (memory == NULL)
+    {
+      printf("\n**Error in EditDistance: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    prev = memory;
+    cur = memory + lb + 1;
+  }
+
+  for (j = 0; j <= lb; ++j)
+    prev[j] = j;
+
+  for (i = 1; i <= la; ++i)
+  {
+    int  rowMin;
+    int *temp;
+
+    cur[0] = rowMin = i;
+
+    for (j = 1; j <= lb; ++j)
+    {
+      int d = prev[j - 1] + (a[i - 1] != b[j - 1]);
+
+      if (prev[j] + 1 < d)
+        d = prev[j] + 1;
+      if (cur[j - 1] + 1 < d)
+        d = cur[j - 1] + 1;
+
+      cur[j] = d;
+      if (d < rowMin)
+        rowMin = d;
+    }
+
+    temp = prev;  // the row just computed is now the previous one:
+    prev = cur;
+    cur = temp;
+
+    if (rowMin > max)  // every later row is at least as far:
+      break;
+  }
+
+  int distance = (i <= la) ? max + 1 : prev[lb];
+
+  if (memory != NULL)
+    myfree(memory);
+
+  return (distance > max) ? max + 1 : distance;
+}
+
+//
+// a list of candidate vertices, doubled in size when full:
+//
+typedef struct Candidates
+{
+  Vertex *List;
+  int     Count;
+  int     Capacity;
+} Candidates;
+
+static void _addCandidate(Candidates *C, Vertex v)
+{
+  if (C->Count == C->Capacity)
+  {
+    Vertex *list = (Vertex *)mymalloc(2 * C->Capacity * sizeof(Vertex));
+    if (list == NULL)
+    {
+      printf("\n**Error in Suggest: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    memcpy(list, C->List, C->Count * sizeof(Vertex));
+    myfree(C->List);
+
+    C->List = list;
+    C->Capacity *= 2;
+  }
+
+  C->List[C->Count++] = v;
+}
+
+static int _byVertex(const void *a, const void *b)
+{
+  Vertex v1 = *(const Vertex *)a;
+  Vertex v2 = *(const Vertex *)b;
+
+  return (v1 > v2) - (v1 < v2);
+}
+
+//
+// _indexCandidates:
+//
+// Adds to C the words of the index sharing a deletion with word,
+// each once.
+//
+static void _indexCandidates(Suggester *S, char *word, int len, int maxEdits, Candidates *C)
+{
+  unsigned int  local[1024];
+  unsigned int *hashes = local;
+  int           n, i, j, k;
+
+  if (_maxDeletions(len, maxEdits) > 1024)
+  {
+    hashes = (unsigned int *)mymalloc(_maxDeletions(len, maxEdits) * sizeof(unsigned int));
+    if (hashes == NULL)
+    {
+      printf("\n**Error in Suggest: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+  }
+
+  n = _deletions(word, len, maxEdits, hashes);
+
+  for (i = 0; i < n; ++i)  // the buckets are scattered, so fetch them first:
+    __builtin_prefetch(&S->Start[hashes[i] >> (32 - S->TableBits)]);
+
+  for (i = 0; i < n; ++i)
+  {
+    int b = hashes[i] >> (32 - S->TableBits);
+
+    for (j = S->Start[b]; j < S->Start[b + 1]; ++j)
+    {
+      if (S->Entries[j].Hash == hashes[i])
+        _addCandidate(C, S->Entries[j].V);
+    }
+  }
+
+  if (hashes != local)
+    myfree(hashes);
+
+  //
+  // a word shares several deletions with a close query, so remove
+  // the duplicates:
+  //
+  qsort(C->List, C->Count, sizeof(Vertex), _byVertex);
+
+  for (i = 0, k = 0; i < C->Count; ++i)
+  {
+    if (k == 0 || C->List[i] != C->List[k - 1])
+      C->List[k++] = C->List[i];
+  }
+
+  C->Count = k;
+}
+
+typedef struct Suggestion
+{
+  int     Distance;
+  Vertex  V;
+  char   *Name;
+} Suggestion;
+
+static int _bySuggestion(const void *a, const void *b)
+{
+  const Suggestion *s1 = (const Suggestion *)a;
+  const Suggestion *s2 = (const Suggestion *)b;
+
+  if (s1->Distance != s2->Distance)
+    return s1->Distance - s2->Distance;
+
+  return strcmp(s1->Name, s2->Name);
+}
+
+//
+// Suggest:
+//
+// Returns a dynamically-allocated array of the (at most) k words of
+// G nearest to word by edit distance, within maxEdits edits, nearest
+// first and alphabetically among equals (k <= 0 => all of them);
+// the array ends with -1.  If distances is not NULL, distances[i] is
+// set to the edit distance of the i-th word.  Uses the deletion
+// index if there is one (with maxEdits limited to the index's), and
+// otherwise checks every word.
+//
+// NOTE: it is the responsibility of the CALLER to free the returned
+// array when they are done.
+//
+Vertex *Suggest(Graph *G, char *word, int maxEdits, int k, int *distances)
+{
+  Suggester  *S = G->Suggest;
+  int         len = (int)strlen(word);
+  Candidates  C;
+  Suggestion *found;
+  Vertex     *result;
+  int         n = 0;
+  int         i;
+
+  if (maxEdits < 0)
+    maxEdits = 0;
+  if (S != NULL && maxEdits > S->MaxEdits)
+    maxEdits = S->MaxEdits;
+
+  C.Count = 0;
+  C.Capacity = 64;
+  C.List = (Vertex *)mymalloc(C.Capacity * sizeof(Vertex));
+  if (C.List == NULL)
+  {
+    printf("\n**Error in Suggest: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  if (S != NULL)
+    _indexCandidates(S, word, len, maxEdits, &C);
+  else
+  {
+    Vertex v;
+
+    for (v = 0; v < G->NumVertices; ++v)
+      _addCandidate(&C, v);
+  }
+
+  found = (Suggestion *)mymalloc((C.Count + 1) * sizeof(Suggestion));
+  if (found == NULL)
+  {
+    printf("\n**Error in Suggest: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (i = 0; i < C.Count; ++i)
+  {
+    char *name = G->Names[C.List[i]];
+    int   d = EditDistance(word, name, maxEdits);
+
+    if (d <= maxEdits)
+    {
+      found[n].Distance = d;
+      found[n].V = C.List[i];
+      found[n].Name = name;
+      n++;
+    }
+  }
+
+  qsort(found, n, sizeof(Suggestion), _bySuggestion);
+
+  if (k > 0 && n > k)
+    n = k;
+
+  result = (Vertex *)mymalloc((n + 1) * sizeof(Vertex));
+  if (result == NULL)
+  {
+    printf("\n**Error in Suggest: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (i = 0; i < n; ++i)
+  {
+    result[i] = found[i].V;
+    if (distances != NULL)
+      distances[i] = found[i].Distance;
+  }
+
+  result[n] = -1;
+
+  myfree(found);
+  myfree(C.List);
+
+  return result;
+}
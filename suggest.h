@@ -0,0 +1,31 @@
+/*suggest.h*/
+
+//
+// "Did you mean" suggestions, by symmetric deletion:
+//
+// NOTE: include "graph.h" before this file.
+//
+#define SUGGEST_MAXEDITS  2  // largest edit budget an index is built for
+
+typedef struct SuggestEntry
+{
+  unsigned int  Hash;        // hash of a deletion of V's name
+  Vertex        V;
+} SuggestEntry;
+
+typedef struct Suggester
+{
+  int           MaxEdits;    // deletions of up to this many letters
+  int           TableBits;   // 2^TableBits buckets, by the hash's high bits:
+  int          *Start;       //   bucket b is Entries[Start[b]..Start[b+1]-1]
+  SuggestEntry *Entries;
+  int           NumEntries;
+  long long     Bytes;
+  double        BuildTime;   // in ms
+} Suggester;
+
+void    BuildSuggester(Graph *G, int maxEdits);
+void    DeleteSuggester(Suggester *S);
+
+Vertex *Suggest(Graph *G, char *word, int maxEdits, int k, int *distances);
+int     EditDistance(char *a, char *b, int max);
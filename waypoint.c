@@ -0,0 +1,427 @@
+/*waypoint.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "wordkey.h"
+#include "graph.h"
+#include "search.h"
+#include "sstree.h"
+#include "waypoint.h"
+#include "mymem.h"
+
+
+// #####################################################
+//
+// Waypoint ladders:
+//
+// A ladder from src to dest through waypoints w1, ..., wk is the
+// shortest ladders of its legs, src -> w1, w1 -> w2, ..., wk -> dest,
+// joined.  Every leg is searched in one SearchWorkspace, so no leg
+// pays to initialize per-vertex state.  A search from a waypoint
+// that is the start of more than one leg (or of any leg, when the
+// order is free) runs to completion, and its tree then answers
+// every leg from that waypoint (see BuildSingleSourceTree) --- the
+// tree is searched once per request, not once per leg.  Other legs
+// stop as soon as they reach their end.
+//
+// With anyOrder, the intermediate waypoints may be visited in any
+// order, and the cheapest is found by Held-Karp's DP over subsets
+// of them, from the costs between every pair: O(2^k k^2) for k
+// waypoints, so only up to WAYPOINT_MAXFREE of them; beyond that
+// they are visited in the order given.
+//
+
+#define LEG_UNKNOWN  -3  // (not -1, no ladder, nor SEARCH_TIMEDOUT)
+
+typedef struct Legs  // the legs between the waypoints, as found:
+{
+  int      N;
+  Vertex  *Waypoints;
+  int     *Cost;      // Cost[i*N+j]: waypoint i to j, -1 => no ladder,
+  Vertex **Path;      //   along Path[i*N+j] (NULL until found)
+  int      TimedOut;  // true => some search ran out of budget
+} Legs;
+
+//
+// _searchTree:
+//
+// Searches the whole tree from waypoint i, and fills in the legs
+// from i, and from any other waypoint that is the same word (as no
+// ladder, if the search runs out of W's budget, which L notes).
+//
+static void _searchTree(Graph *G, SearchWorkspace *W, Legs *L, int i)
+{
+  SingleSourceTree *T = BuildSingleSourceTree(G, W, L->Waypoints[i]);
+  int               a, j;
+
+  if (T == NULL)  // out of budget:
+    L->TimedOut = 1;  /*true*/
+
+  for (a = 0; a < L->N; ++a)
+  {
+    if (L->Waypoints[a] != L->Waypoints[i])
+      continue;
+
+    for (j = 0; j < L->N; ++j)
+    {
+      if (L->Cost[a * L->N + j] != LEG_UNKNOWN)
+        continue;
+
+      if (T == NULL)  // out of budget:
+      {
+        L->Cost[a * L->N + j] = -1;
+        continue;
+      }
+
+      L->Cost[a * L->N + j] = TreeDistance(T, L->Waypoints[j]);
+      L->Path[a * L->N + j] = TreePath(T, L->Waypoints[j]);
+    }
+  }
+
+  if (T != NULL)
+    DeleteSingleSourceTree(T);
+}
+
+//
+// _searchLeg:
+//
+// Fills in the leg from waypoint i to j, by a search that stops
+// once j is reached.
+//
+static void _searchLeg(Graph *G, SearchWorkspace *W, Legs *L, int i, int j)
+{
+  if (L->Cost[i * L->N + j] != LEG_UNKNOWN)
+    return;
+
+  L->Cost[i * L->N + j] = SearchFrom(G, W, L->Waypoints[i], L->Waypoints[j]);
+  if (L->Cost[i * L->N + j] == SEARCH_TIMEDOUT)
+  {
+    L->Cost[i * L->N + j] = -1;
+    L->TimedOut = 1;  /*true*/
+  }
+  L->Path[i * L->N + j] = WorkspacePath(W, L->Waypoints[i], L->Waypoints[j]);
+}
+
+//
+// _cheapestOrder:
+//
+// Reorders the intermediate waypoints 1..N-2 into the order that
+// makes the cheapest ladder, given the costs of all the legs between
+// them (Held-Karp).  Leaves them be if no order has a ladder.
+//
+static void _cheapestOrder(Legs *L)
+{
+  int   N = L->N;
+  int   k = N - 2;          // # of intermediate waypoints
+  int   full = (1 << k) - 1;
+  int  *best = (int *)mymalloc((1 << k) * k * sizeof(int));  // best[S*k+j]: src, S, ending at j
+  int  *from = (int *)mymalloc((1 << k) * k * sizeof(int));  //   coming from this one
+  int  *order = (int *)mymalloc(k * sizeof(int));
+  int   S, i, j;
+
+  if (best == NULL || from == NULL || order == NULL)
+  {
+    printf("\n**Error in WaypointLadder: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (S = 1; S <= full; ++S)
+  {
+    for (j = 0; j < k; ++j)
+    {
+      best[S * k + j] = -1;  // => none
+      from[S * k + j] = -1;
+
+      if (!(S & (1 << j)))
+        continue;
+
+      if (S == (1 << j))  // straight from src:
+      {
+        best[S * k + j] = L->Cost[0 * N + (j + 1)];
+        continue;
+      }
+
+      for (i = 0; i < k; ++i)
+      {
+        int prev = S & ~(1 << j);
+        int leg = L->Cost[(i + 1) * N + (j + 1)];
+
+        if (!(prev & (1 << i)) || best[prev * k + i] < 0 || leg < 0)
+          continue;
+
+        if (best[S * k + j] < 0 || best[prev * k + i] + leg < best[S * k + j])
+        {
+          best[S * k + j] = best[prev * k + i] + leg;
+          from[S * k + j] = i;
+        }
+      }
+    }
+  }
+
+  //
+  // the best last waypoint, then back:
+  //
+  int last = -1, total = -1;
+
+  for (j = 0; j < k; ++j)
+  {
+    int leg = L->Cost[(j + 1) * N + (N - 1)];
+
+    if (best[full * k + j] < 0 || leg < 0)
+      continue;
+
+    if (total < 0 || best[full * k + j] + leg < total)
+    {
+      total = best[full * k + j] + leg;
+      last = j;
+    }
+  }
+
+  if (last >= 0)
+  {
+    Vertex *waypoints = (Vertex *)mymalloc(N * sizeof(Vertex));
+    int    *costs = (int *)mymalloc(N * N * sizeof(int));
+    Vertex **paths = (Vertex **)mymalloc(N * N * sizeof(Vertex *));
+    int     a, b;
+
+    if (waypoints == NULL || costs == NULL || paths == NULL)
+    {
+      printf("\n**Error in WaypointLadder: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    S = full;
+    for (i = k - 1; i >= 0; --i)
+    {
+      order[i] = last;
+
+      int prev = from[S * k + last];
+
+      S &= ~(1 << last);
+      last = prev;
+    }
+
+    //
+    // renumber the waypoints, and their legs, in that order:
+    //
+    int *old = (int *)mymalloc(N * sizeof(int));  // old[new #] = old #
+    if (old == NULL)
+    {
+      printf("\n**Error in WaypointLadder: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    old[0] = 0;
+    old[N - 1] = N - 1;
+    for (i = 0; i < k; ++i)
+      old[i + 1] = order[i] + 1;
+
+    for (a = 0; a < N; ++a)
+    {
+      waypoints[a] = L->Waypoints[old[a]];
+
+      for (b = 0; b < N; ++b)
+      {
+        costs[a * N + b] = L->Cost[old[a] * N + old[b]];
+        paths[a * N + b] = L->Path[old[a] * N + old[b]];
+      }
+    }
+
+    memcpy(L->Waypoints, waypoints, N * sizeof(Vertex));
+    memcpy(L->Cost, costs, N * N * sizeof(int));
+    memcpy(L->Path, paths, N * N * sizeof(Vertex *));
+
+    myfree(old);
+    myfree(waypoints);
+    myfree(costs);
+    myfree(paths);
+  }
+
+  myfree(best);
+  myfree(from);
+  myfree(order);
+}
+
+//
+// WaypointLadder:
+//
+// Returns the shortest ladder from waypoints[0] to waypoints[n-1]
+// through waypoints[1..n-2], in that order, or if anyOrder, in the
+// cheapest order (see above), in which case waypoints[] is reordered
+// to match.  The ladder is in the format Dijkstra() returns (src,
+// ..., dest, -1); it may visit a word more than once.  If O is not
+// NULL, it only enters the words O allows (see SearchOptions), and
+// all the legs' searches share O's budget (see ShareBudget).  If
+// cost is not NULL, it is set to the ladder's cost, -1 if there is
+// none, or SEARCH_TIMEDOUT if the budget ran out first.
+//
+// NOTE: returns just -1 if some leg has no ladder, if the budget
+// ran out, or if waypoints[] holds invalid vertex ids or fewer than
+// 2 of them.
+//
+// NOTE: it is the responsibility of the CALLER to free the
+// returned array when they are done.
+//
+Vertex *WaypointLadder(Graph *G, Vertex *waypoints, int n, int anyOrder, SearchOptions *O,
+                       int *cost)
+{
+  int i, j;
+
+  if (cost != NULL)
+    *cost = -1;
+
+  for (i = 0; i < n; ++i)
+  {
+    if (waypoints[i] < 0 || waypoints[i] >= G->NumVertices)  // invalid vertex #:
+      n = 0;
+  }
+
+  if (n < 2)  // no ladder:
+  {
+    Vertex *none = (Vertex *)mymalloc(sizeof(Vertex));
+    if (none == NULL)
+    {
+      printf("\n**Error in WaypointLadder: malloc failed to allocate\n\n");
+      exit(-1);
+    }
+
+    none[0] = -1;
+    return none;
+  }
+
+  SearchWorkspace *W = CreateWorkspace(G);
+  Legs             L;
+
+  W->Options = O;
+  ShareBudget(W);
+
+  L.N = n;
+  L.Waypoints = waypoints;
+  L.Cost = (int *)mymalloc(n * n * sizeof(int));
+  L.Path = (Vertex **)mymalloc(n * n * sizeof(Vertex *));
+  L.TimedOut = 0;  /*false*/
+  if (L.Cost == NULL || L.Path == NULL)
+  {
+    printf("\n**Error in WaypointLadder: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  for (i = 0; i < n * n; ++i)
+  {
+    L.Cost[i] = LEG_UNKNOWN;
+    L.Path[i] = NULL;
+  }
+
+  //
+  // (1) the legs: with the order free, from every waypoint to every
+  // other, else each to the next:
+  //
+  if (anyOrder && n > 3 && n - 2 <= WAYPOINT_MAXFREE)
+  {
+    for (i = 0; i < n - 1; ++i)
+    {
+      if (L.Cost[i * n + (n - 1)] == LEG_UNKNOWN)
+        _searchTree(G, W, &L, i);
+    }
+
+    _cheapestOrder(&L);
+  }
+  else
+  {
+    for (i = 0; i < n - 1; ++i)
+    {
+      int starts = 0;  // # of legs starting from this word
+
+      if (L.Cost[i * n + (i + 1)] != LEG_UNKNOWN)  // (from an earlier tree)
+        continue;
+
+      for (j = 0; j < n - 1; ++j)
+      {
+        if (waypoints[j] == waypoints[i])
+          starts++;
+      }
+
+      if (starts > 1)
+        _searchTree(G, W, &L, i);
+      else
+        _searchLeg(G, W, &L, i, i + 1);
+    }
+  }
+
+  //
+  // (2) join the legs:
+  //
+  int total = 0, length = 1;
+
+  for (i = 0; i < n - 1 && total >= 0; ++i)
+  {
+    int leg = L.Cost[i * n + (i + 1)];
+    int k;
+
+    if (leg < 0)
+      total = -1;
+    else
+    {
+      total += leg;
+      for (k = 1; L.Path[i * n + (i + 1)][0] != -1 && L.Path[i * n + (i + 1)][k] != -1; ++k)
+        length++;
+    }
+  }
+
+  Vertex *ladder = (Vertex *)mymalloc((length + 1) * sizeof(Vertex));
+  if (ladder == NULL)
+  {
+    printf("\n**Error in WaypointLadder: malloc failed to allocate\n\n");
+    exit(-1);
+  }
+
+  if (L.TimedOut)  // out of budget, so no answer:
+  {
+    ladder[0] = -1;
+
+    if (cost != NULL)
+      *cost = SEARCH_TIMEDOUT;
+  }
+  else if (total < 0)
+    ladder[0] = -1;
+  else
+  {
+    int m = 0;
+
+    ladder[m++] = waypoints[0];
+
+    for (i = 0; i < n - 1; ++i)
+    {
+      Vertex *path = L.Path[i * n + (i + 1)];
+      int     k;
+
+      for (k = 1; path[0] != -1 && path[k] != -1; ++k)
+        ladder[m++] = path[k];
+    }
+
+    ladder[m] = -1;
+
+    if (m == 1)  // src == dest, and no steps between:
+      ladder[0] = -1;
+
+    if (cost != NULL)
+      *cost = total;
+  }
+
+  for (i = 0; i < n * n; ++i)
+  {
+    if (L.Path[i] != NULL)
+      myfree(L.Path[i]);
+  }
+
+  myfree(L.Cost);
+  myfree(L.Path);
+  DeleteWorkspace(W);
+
+  return ladder;
+}
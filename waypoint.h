@@ -0,0 +1,11 @@
+/*waypoint.h*/
+
+//
+// Ladders through waypoints (src -> w1 -> ... -> dest):
+//
+// NOTE: include "graph.h" and "search.h" before this file.
+//
+#define WAYPOINT_MAXFREE  12  // more intermediate waypoints => kept in order
+
+Vertex *WaypointLadder(Graph *G, Vertex *waypoints, int n, int anyOrder, SearchOptions *O,
+                       int *cost);
@@ -0,0 +1,171 @@
+/*wordkey.c*/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "wordkey.h"
+
+
+// #####################################################
+//
+// Packed word keys:
+//
+
+//
+// PackWord:
+//
+// Returns the packed key for the given word, or WORDKEY_NONE if
+// the word is empty, longer than WORDKEY_MAXLEN, or contains a
+// character other than a-z.
+//
+WordKey PackWord(char *word)
+{
+  WordKey key = 0;
+  int     i;
+
+  for (i = 0; word[i] != '\0'; ++i)
+  {
+    if (i == WORDKEY_MAXLEN)  // too long:
+      return WORDKEY_NONE;
+    if (word[i] < 'a' || word[i] > 'z')  // not a letter:
+      return WORDKEY_NONE;
+
+    key |= ((WordKey)(word[i] - 'a' + 1)) << (WORDKEY_LETTERBITS * i);
+  }
+
+  if (i == 0)  // empty:
+    return WORDKEY_NONE;
+
+  return key | (((WordKey)i) << WORDKEY_LENSHIFT);
+}
+
+//
+// UnpackWord:
+//
+// Copies the word denoted by key into the given buffer, which
+// must hold at least WORDKEY_MAXLEN+1 chars.
+//
+void UnpackWord(WordKey key, char *word)
+{
+  int len = KeyLength(key);
+  int i;
+
+  for (i = 0; i < len; ++i)
+    word[i] = (char)('a' + KeyLetter(key, i) - 1);
+
+  word[len] = '\0';
+}
+
+//
+// KeyLength:
+//
+// Returns the # of letters in the word.
+//
+int KeyLength(WordKey key)
+{
+  return (int)(key >> WORDKEY_LENSHIFT);
+}
+
+//
+// KeyLetter:
+//
+// Returns the code (1..26) of the ith letter.
+//
+int KeyLetter(WordKey key, int i)
+{
+  return (int)((key >> (WORDKEY_LETTERBITS * i)) & 31);
+}
+
+//
+// KeySetLetter:
+//
+// Returns the key with the ith letter replaced by the given
+// letter 'a'..'z'.
+//
+WordKey KeySetLetter(WordKey key, int i, int letter)
+{
+  int shift = WORDKEY_LETTERBITS * i;
+
+  key &= ~(31ULL << shift);
+
+  return key | (((WordKey)(letter - 'a' + 1)) << shift);
+}
+
+//
+// KeyDeleteLetter:
+//
+// Returns the key of the word with the ith letter deleted, or
+// WORDKEY_NONE if that leaves no letters.
+//
+WordKey KeyDeleteLetter(WordKey key, int i)
+{
+  int     len = KeyLength(key);
+  int     shift = WORDKEY_LETTERBITS * i;
+  WordKey letters = key & ((1ULL << WORDKEY_LENSHIFT) - 1);
+
+  if (len <= 1)
+    return WORDKEY_NONE;
+
+  WordKey low = letters & ((1ULL << shift) - 1);
+  WordKey high = (letters >> (shift + WORDKEY_LETTERBITS)) << shift;
+
+  return low | high | (((WordKey)(len - 1)) << WORDKEY_LENSHIFT);
+}
+
+//
+// _diffBits:
+//
+// Folds the xor of two keys so that the low bit of each letter
+// is set iff that letter differs.
+//
+static WordKey _diffBits(WordKey a, WordKey b)
+{
+  WordKey x = a ^ b;
+
+  return (x | (x >> 1) | (x >> 2) | (x >> 3) | (x >> 4)) & WORDKEY_LOWBITS;
+}
+
+//
+// KeyDistance:
+//
+// Returns the Hamming distance (# of differing letters) between
+// two words, or -1 if they are not the same length.
+//
+int KeyDistance(WordKey a, WordKey b)
+{
+  if ((a ^ b) >> WORDKEY_LENSHIFT)  // different lengths:
+    return -1;
+
+  return __builtin_popcountll(_diffBits(a, b));
+}
+
+//
+// KeysDifferByOne:
+//
+// Returns true (non-zero) if the words are the same length and
+// differ in exactly one letter, false (0) if not.
+//
+int KeysDifferByOne(WordKey a, WordKey b)
+{
+  if ((a ^ b) >> WORDKEY_LENSHIFT)  // different lengths:
+    return 0;
+
+  WordKey d = _diffBits(a, b);
+
+  return d != 0 && (d & (d - 1)) == 0;
+}
+
+//
+// HashKey:
+//
+// Returns a hash of the key in the range 0..2^bits-1, for bits
+// in 1..32 (Fibonacci hashing).
+//
+unsigned int HashKey(WordKey key, int bits)
+{
+  return (unsigned int)((key * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+}
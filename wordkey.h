@@ -0,0 +1,28 @@
+/*wordkey.h*/
+
+//
+// Packed word keys:
+//
+// A word of 1..12 lowercase letters a-z is packed into a 64-bit key,
+// 5 bits per letter ('a' => 1, ..., 'z' => 26), letter i in bits
+// 5i..5i+4, and the length in the top 4 bits.  Two words are equal
+// iff their keys are equal.  Words that don't fit have no key
+// (WORDKEY_NONE) and must be handled by string comparisons.
+//
+typedef unsigned long long WordKey;
+
+#define WORDKEY_NONE       0ULL
+#define WORDKEY_MAXLEN     12
+#define WORDKEY_LETTERBITS 5
+#define WORDKEY_LENSHIFT   60
+#define WORDKEY_LOWBITS    0x0084210842108421ULL  // low bit of each letter
+
+WordKey  PackWord(char *word);
+void     UnpackWord(WordKey key, char *word);
+int      KeyLength(WordKey key);
+int      KeyLetter(WordKey key, int i);
+WordKey  KeySetLetter(WordKey key, int i, int letter);
+WordKey  KeyDeleteLetter(WordKey key, int i);
+int      KeyDistance(WordKey a, WordKey b);
+int      KeysDifferByOne(WordKey a, WordKey b);
+unsigned int HashKey(WordKey key, int bits);